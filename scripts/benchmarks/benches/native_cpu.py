@@ -0,0 +1,118 @@
+# Copyright (C) 2025 Intel Corporation
+# Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM Exceptions.
+# See LICENSE.TXT
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import csv
+import io
+import os
+from pathlib import Path
+from .base import Benchmark, Suite
+from .result import Result
+from utils.utils import run, create_build_path
+from options import options
+
+# The unified-runtime source tree, which the benchmark suite is built from.
+ur_source = Path(__file__).resolve().parents[3]
+
+
+def isNativeCPUAvailable():
+    return options.ur is not None and options.ur_adapter == "native_cpu"
+
+
+# Runs bench-native-cpu-suite from test/benchmarks/native_cpu against the
+# native_cpu adapter of the UR install given with --ur.
+class NativeCPUSuite(Suite):
+    def __init__(self, directory):
+        self.directory = directory
+
+    def name(self) -> str:
+        return "Native CPU"
+
+    def setup(self):
+        if not isNativeCPUAvailable():
+            return
+
+        build_path = create_build_path(self.directory, "native-cpu-bench-build")
+        self.benchmark_bin = os.path.join(build_path, "bench-native-cpu-suite")
+
+        lib_path = os.path.dirname(Benchmark.get_adapter_full_path())
+        bench_source = ur_source / "test" / "benchmarks" / "native_cpu"
+        compile_command = [
+            os.environ.get("CXX", "c++"),
+            "-std=c++17",
+            "-O2",
+            f"-I{options.ur}/include",
+            f"-I{bench_source}",
+            f"-I{ur_source / 'source' / 'adapters' / 'native_cpu'}",
+            str(bench_source / "suite.cpp"),
+            "-o",
+            self.benchmark_bin,
+            f"-L{lib_path}",
+            f"-Wl,-rpath,{lib_path}",
+            "-lur_loader",
+            "-lpthread",
+        ]
+
+        print(f"{self.__class__.__name__}: Run {compile_command}")
+        run(compile_command)
+
+        self.built = True
+
+    def benchmarks(self) -> list[Benchmark]:
+        if not isNativeCPUAvailable():
+            return []
+
+        return [
+            NativeCPUBench(self, "launch_latency"),
+            NativeCPUBench(self, "launch_throughput", lower_is_better=False),
+            NativeCPUBench(self, "nd_range"),
+            NativeCPUBench(self, "memcpy", lower_is_better=False),
+            NativeCPUBench(self, "fill", lower_is_better=False),
+            NativeCPUBench(self, "copy_rect", lower_is_better=False),
+            NativeCPUBench(self, "event"),
+            NativeCPUBench(self, "usm_alloc_free"),
+        ]
+
+
+# One group of cases of the suite, e.g. all the memcpy sizes.
+class NativeCPUBench(Benchmark):
+    def __init__(self, suite, group, lower_is_better=True):
+        super().__init__(suite.directory, suite)
+        self.group = group
+        self.lower = lower_is_better
+
+    def name(self):
+        return f"native_cpu {self.group}"
+
+    def lower_is_better(self):
+        return self.lower
+
+    def setup(self):
+        return
+
+    def run(self, env_vars) -> list[Result]:
+        command = [
+            self.suite.benchmark_bin,
+            "--filter",
+            f"{self.group}/",
+            "--repetitions",
+            "3",
+        ]
+
+        result = self.run_bench(command, env_vars, add_sycl=False)
+        return [
+            Result(
+                label=f"native_cpu {row['name']}",
+                value=float(row["value"]),
+                command=command,
+                env=env_vars,
+                stdout=result,
+                unit=row["unit"],
+                explicit_group=f"native_cpu {self.group}",
+            )
+            for row in csv.DictReader(io.StringIO(result))
+        ]
+
+    def teardown(self):
+        return
@@ -10,6 +10,7 @@ from benches.velocity import VelocityBench
 from benches.syclbench import *
 from benches.llamacpp import *
 from benches.umf import *
+from benches.native_cpu import *
 from benches.test import TestSuite
 from options import Compare, options
 from output_markdown import generate_markdown
@@ -149,6 +150,7 @@ def main(directory, additional_env_vars, save_name, compare_names, filter):
             SyclBench(directory),
             LlamaCppBench(directory),
             UMFSuite(directory),
+            NativeCPUSuite(directory),
             # TestSuite()
         ]
         if not options.dry_run
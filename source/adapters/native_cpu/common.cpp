@@ -10,6 +10,23 @@
 
 #include "common.hpp"
 
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
 // Global variables for UR_RESULT_ADAPTER_SPECIFIC_ERROR
 // See urGetLastResult
 thread_local ur_result_t ErrorMessageCode = UR_RESULT_SUCCESS;
@@ -34,3 +51,79 @@ void detail::ur::die(const char *pMessage) {
   logger::always("ur_die: {}", pMessage);
   std::terminate();
 }
+
+// Checks CPUID.80000007H:EDX[8], which reports whether the TSC ticks at a
+// constant rate regardless of P-, C- and T-state transitions.
+static bool has_invariant_tsc() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  int Regs[4];
+  __cpuid(Regs, 0x80000000);
+  if (static_cast<unsigned>(Regs[0]) < 0x80000007u)
+    return false;
+  __cpuid(Regs, 0x80000007);
+  return (Regs[3] >> 8) & 1;
+#elif defined(__x86_64__) || defined(__i386__)
+  unsigned Eax, Ebx, Ecx, Edx;
+  if (!__get_cpuid(0x80000007, &Eax, &Ebx, &Ecx, &Edx))
+    return false;
+  return (Edx >> 8) & 1;
+#else
+  return false;
+#endif
+}
+
+static native_cpu::detail::tsc_calibration_t calibrate_tsc() {
+  using namespace native_cpu::detail;
+  tsc_calibration_t Cal;
+  if (std::getenv("UR_NATIVE_CPU_DISABLE_TSC") || !has_invariant_tsc())
+    return Cal;
+
+  // Measure the TSC against the steady clock over a short window. Each end
+  // point takes the tightest of a few samples to reduce the error caused by
+  // being preempted between the two clock reads.
+  auto Sample = [](uint64_t &Ticks, uint64_t &Ns) {
+    uint64_t Best = UINT64_MAX;
+    for (int I = 0; I < 5; I++) {
+      uint64_t T0 = read_tsc();
+      uint64_t N = steady_clock_ns();
+      uint64_t T1 = read_tsc();
+      if (T1 - T0 < Best) {
+        Best = T1 - T0;
+        Ticks = T0 + (T1 - T0) / 2;
+        Ns = N;
+      }
+    }
+  };
+  uint64_t Ticks0 = 0, Ns0 = 0, Ticks1 = 0, Ns1 = 0;
+  Sample(Ticks0, Ns0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  Sample(Ticks1, Ns1);
+  if (Ticks1 <= Ticks0 || Ns1 <= Ns0)
+    return Cal;
+
+  Cal.UseTSC = true;
+  Cal.BaseTicks = Ticks1;
+  Cal.BaseNs = Ns1;
+  Cal.NsPerTick = static_cast<double>(Ns1 - Ns0) / (Ticks1 - Ticks0);
+  logger::debug("native_cpu: using invariant TSC, {} ns/tick", Cal.NsPerTick);
+  return Cal;
+}
+
+const native_cpu::detail::tsc_calibration_t &
+native_cpu::detail::get_tsc_calibration() {
+  static const tsc_calibration_t Cal = calibrate_tsc();
+  return Cal;
+}
+
+size_t native_cpu::get_page_size() {
+  static const size_t PageSize = [] {
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+    SYSTEM_INFO Info;
+    GetSystemInfo(&Info);
+    return static_cast<size_t>(Info.dwPageSize);
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+  }();
+  return PageSize;
+}
@@ -14,6 +14,12 @@
 #include "ur/ur.hpp"
 #include <chrono>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 constexpr size_t MaxMessageSize = 256;
 
 extern thread_local ur_result_t ErrorMessageCode;
@@ -63,6 +69,13 @@ struct RefCounted {
   std::atomic_uint32_t _refCount;
   uint32_t incrementReferenceCount() { return ++_refCount; }
   uint32_t decrementReferenceCount() { return --_refCount; }
+  // Takes a reference unless the object is already being destroyed.
+  bool tryIncrementReferenceCount() {
+    uint32_t count = _refCount.load();
+    while (count && !_refCount.compare_exchange_weak(count, count + 1))
+      ;
+    return count != 0;
+  }
   RefCounted() : _refCount{1} {}
   uint32_t getReferenceCount() const { return _refCount; }
 };
@@ -72,12 +85,52 @@ template <typename T> inline void decrementOrDelete(T *refC) {
     delete refC;
 }
 
-inline uint64_t get_timestamp() {
+namespace native_cpu {
+namespace detail {
+
+// Calibration data for converting raw time stamp counter ticks to
+// nanoseconds. It is computed once, the first time a timestamp is taken, and
+// is immutable afterwards so that readers never need to synchronize.
+struct tsc_calibration_t {
+  // False if the CPU has no invariant TSC, in which case timestamps fall back
+  // to std::chrono::steady_clock.
+  bool UseTSC = false;
+  uint64_t BaseTicks = 0;
+  uint64_t BaseNs = 0;
+  double NsPerTick = 0.0;
+};
+
+const tsc_calibration_t &get_tsc_calibration();
+
+inline uint64_t read_tsc() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) ||             \
+    defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+inline uint64_t steady_clock_ns() {
   return std::chrono::duration_cast<std::chrono::nanoseconds>(
-             std::chrono::high_resolution_clock::now().time_since_epoch())
+             std::chrono::steady_clock::now().time_since_epoch())
       .count();
 }
 
+} // namespace detail
+} // namespace native_cpu
+
+// Returns a monotonic timestamp in nanoseconds. Uses the invariant time stamp
+// counter where available, calibrated against std::chrono::steady_clock so
+// both sources share the same epoch, and never takes a lock.
+inline uint64_t get_timestamp() {
+  const auto &Cal = native_cpu::detail::get_tsc_calibration();
+  if (!Cal.UseTSC)
+    return native_cpu::detail::steady_clock_ns();
+  const uint64_t Delta = native_cpu::detail::read_tsc() - Cal.BaseTicks;
+  return Cal.BaseNs + static_cast<uint64_t>(Delta * Cal.NsPerTick);
+}
+
 namespace native_cpu {
 
 inline void *aligned_malloc(size_t alignment, size_t size) {
@@ -98,4 +151,7 @@ inline void aligned_free(void *ptr) {
 #endif
 }
 
+// Returns the size of a host memory page.
+size_t get_page_size();
+
 } // namespace native_cpu
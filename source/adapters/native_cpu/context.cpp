@@ -8,7 +8,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <cstdint>
+#include <cstdlib>
 #include <memory>
+#include <string>
 #include <tuple>
 
 #include "ur/ur.hpp"
@@ -17,10 +20,92 @@
 #include "common.hpp"
 #include "context.hpp"
 
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+// Locking imported memory keeps it from being paged out while kernels use
+// it, at the cost of counting towards the locked memory limit.
+static bool lockImportedMemory() {
+  static const bool Lock = [] {
+    const char *Lock = std::getenv("UR_NATIVE_CPU_USM_IMPORT_LOCK");
+    return Lock != nullptr && Lock != std::string("") &&
+           Lock != std::string("0");
+  }();
+  return Lock;
+}
+
+static bool lockMemory(void *ptr, size_t size) {
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+  return VirtualLock(ptr, size);
+#else
+  return mlock(ptr, size) == 0;
+#endif
+}
+
+native_cpu::imported_alloc::~imported_alloc() {
+  if (!locked)
+    return;
+  // Locks don't nest, so this also unlocks any pages shared with another
+  // locked range.
+  void *ptr = const_cast<void *>(info.base_ptr);
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+  VirtualUnlock(ptr, info.size);
+#else
+  munlock(ptr, info.size);
+#endif
+}
+
+ur_result_t ur_context_handle_t_::import_alloc(void *ptr, size_t size) {
+  // Allocations can't overlap, see alloc_tracker. The lock keeps concurrent
+  // imports of overlapping ranges from both passing the check, allocations
+  // made by the adapter never overlap imported memory.
+  UR_ASSERT(size <= UINTPTR_MAX - reinterpret_cast<uintptr_t>(ptr),
+            UR_RESULT_ERROR_INVALID_SIZE);
+  std::lock_guard<std::mutex> lock(importsMutex);
+  UR_ASSERT(!allocations.overlaps(ptr, size), UR_RESULT_ERROR_INVALID_VALUE);
+
+  bool locked = false;
+  if (lockImportedMemory()) {
+    locked = lockMemory(ptr, size);
+    if (!locked)
+      logger::warning("native_cpu: failed to lock {} imported bytes at {}",
+                      size, ptr);
+  }
+  auto imported = std::make_unique<native_cpu::imported_alloc>(
+      native_cpu::usm_alloc_info(UR_USM_TYPE_HOST, ptr, size, _device,
+                                 nullptr, nullptr, nullptr),
+      locked);
+
+  auto [it, inserted] = imports.emplace(ptr, std::move(imported));
+  UR_ASSERT(inserted, UR_RESULT_ERROR_INVALID_VALUE);
+  allocations.insert(ptr, size, &it->second->info);
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ur_context_handle_t_::release_import(void *ptr) {
+  // Keeps the memory locked until the mutex has been released.
+  std::unique_ptr<native_cpu::imported_alloc> imported;
+  {
+    std::lock_guard<std::mutex> lock(importsMutex);
+    auto it = imports.find(ptr);
+    UR_ASSERT(it != imports.end(), UR_RESULT_ERROR_INVALID_VALUE);
+    allocations.erase(ptr);
+    imported = std::move(it->second);
+    imports.erase(it);
+  }
+  return UR_RESULT_SUCCESS;
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urContextCreate(
     [[maybe_unused]] uint32_t DeviceCount, const ur_device_handle_t *phDevices,
     const ur_context_properties_t *pProperties,
-    ur_context_handle_t *phContext) {
+    ur_context_handle_t *phContext) try {
   std::ignore = pProperties;
   assert(DeviceCount == 1);
 
@@ -28,6 +113,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urContextCreate(
   auto ctx = new ur_context_handle_t_(*phDevices);
   *phContext = ctx;
   return UR_RESULT_SUCCESS;
+} catch (umf_result_t e) {
+  return umf::umf2urResult(e);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
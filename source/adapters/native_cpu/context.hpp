@@ -10,13 +10,22 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <memory>
 #include <mutex>
-#include <set>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
 #include <ur_api.h>
 
 #include "common.hpp"
 #include "device.hpp"
 #include "ur/ur.hpp"
+#include "usm.hpp"
 
 namespace native_cpu {
 struct usm_alloc_info {
@@ -26,19 +35,21 @@ struct usm_alloc_info {
   ur_device_handle_t device;
   ur_usm_pool_handle_t pool;
 
-  // We store a pointer to the actual allocation because it is needed when
-  // freeing memory.
+  // We store a pointer to the actual allocation and the UMF pool it came from
+  // because they are needed when freeing memory.
   void *base_alloc_ptr;
+  umf_memory_pool_handle_t umf_pool;
   constexpr usm_alloc_info(ur_usm_type_t type, const void *base_ptr,
                            size_t size, ur_device_handle_t device,
-                           ur_usm_pool_handle_t pool, void *base_alloc_ptr)
+                           ur_usm_pool_handle_t pool, void *base_alloc_ptr,
+                           umf_memory_pool_handle_t umf_pool)
       : type(type), base_ptr(base_ptr), size(size), device(device), pool(pool),
-        base_alloc_ptr(base_alloc_ptr) {}
+        base_alloc_ptr(base_alloc_ptr), umf_pool(umf_pool) {}
 };
 
 constexpr usm_alloc_info usm_alloc_info_null_entry(UR_USM_TYPE_UNKNOWN, nullptr,
                                                    0, nullptr, nullptr,
-                                                   nullptr);
+                                                   nullptr, nullptr);
 
 constexpr size_t alloc_header_size = sizeof(usm_alloc_info);
 
@@ -63,11 +74,12 @@ static size_t get_padding(uint32_t alignment) {
 // To satisfy the alignment requirements we "pad" the memory
 // allocation so that the pointer returned to the user
 // always satisfies (ptr % align) == 0.
-static inline void *malloc_impl(uint32_t alignment, size_t size) {
+static inline void *malloc_impl(umf_memory_pool_handle_t pool,
+                                uint32_t alignment, size_t size) {
   assert(alignment >= alignof(usm_alloc_info) &&
          "memory not aligned to usm_alloc_info");
-  void *ptr = native_cpu::aligned_malloc(
-      alignment, alloc_header_size + get_padding(alignment) + size);
+  void *ptr = umfPoolAlignedMalloc(
+      pool, alloc_header_size + get_padding(alignment) + size, alignment);
   return ptr;
 }
 
@@ -81,43 +93,353 @@ static usm_alloc_info get_alloc_info(void *ptr) {
   return *(usm_alloc_info *)get_alloc_info_addr(ptr);
 }
 
+// Index of the live USM allocations of a context, mapping any pointer into
+// an allocation back to its info. The info of allocations made by the adapter
+// is their header, imported host memory has it stored out of line.
+//
+// Allocations are sorted into levels by size. Each level splits the address
+// space into chunks at least as large as its allocations, so an allocation
+// overlaps at most two chunks, and it is registered once, in the shard of the
+// chunk it starts in. The allocation containing a pointer, if any, therefore
+// starts in the pointer's chunk or the one before it, at the level of its
+// size: as allocations don't overlap, it is the one with the greatest start
+// address not above the pointer in either shard. Levels with no allocations
+// are skipped, so a lookup usually searches two shards and a miss no more
+// than two per level.
+//
+// Each shard has its own lock, so that threads allocating, freeing or
+// querying different allocations rarely contend, and queries only take the
+// locks in shared mode.
+class alloc_tracker {
+public:
+  void insert(const void *ptr, size_t size, const usm_alloc_info *info) {
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+    level_t &level = levels[level_of(size)];
+    level.count.fetch_add(1);
+    shard_t &shard = level.get_shard(begin);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.ranges.emplace(begin, range_t{begin + size, info});
+  }
+
+  // Returns false if ptr isn't the start of a tracked allocation.
+  bool erase(const void *ptr) {
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+    for (level_t &level : levels) {
+      if (level.count.load() == 0)
+        continue;
+      shard_t &shard = level.get_shard(begin);
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      if (shard.ranges.erase(begin) != 0) {
+        level.count.fetch_sub(1);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns the info of the allocation containing ptr, or nullptr if ptr
+  // doesn't point into a tracked allocation.
+  const usm_alloc_info *find(const void *ptr) {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    for (level_t &level : levels) {
+      if (level.count.load(std::memory_order_relaxed) == 0)
+        continue;
+      if (const usm_alloc_info *info = level.find(addr, addr))
+        return info;
+      const uintptr_t chunk_size = uintptr_t{1} << level.chunk_bits;
+      if (addr >= chunk_size) {
+        if (const usm_alloc_info *info = level.find(addr - chunk_size, addr))
+          return info;
+      }
+    }
+    return nullptr;
+  }
+
+  // Returns whether any tracked allocation overlaps [ptr, ptr + size), which
+  // is either one containing ptr or one starting after it within the range.
+  bool overlaps(const void *ptr, size_t size) {
+    if (find(ptr))
+      return true;
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+    const uintptr_t end = begin + size;
+    for (level_t &level : levels) {
+      if (level.count.load(std::memory_order_relaxed) == 0)
+        continue;
+      // Allocations starting in the range are in the shards of the chunks it
+      // spans, which are all of them for a large enough range.
+      const uintptr_t first = begin >> level.chunk_bits;
+      const uintptr_t last = (end - 1) >> level.chunk_bits;
+      if (last - first >= num_shards) {
+        for (shard_t &shard : level.shards) {
+          if (shard_t::starts_in(shard, begin, end))
+            return true;
+        }
+        continue;
+      }
+      for (uintptr_t chunk = first; chunk <= last; chunk++) {
+        if (shard_t::starts_in(level.get_shard(chunk << level.chunk_bits),
+                               begin, end))
+          return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  static constexpr unsigned shard_bits = 6;
+  static constexpr size_t num_shards = size_t{1} << shard_bits;
+
+  struct range_t {
+    uintptr_t end;
+    const usm_alloc_info *info;
+  };
+
+  // Maps the start of each allocation to its end and info.
+  using range_map_t = std::map<uintptr_t, range_t>;
+
+  // Each shard is on its own cache line to avoid false sharing between the
+  // locks.
+  struct alignas(64) shard_t {
+    // Returns whether an allocation of shard starts in [begin, end).
+    static bool starts_in(shard_t &shard, uintptr_t begin, uintptr_t end) {
+      std::shared_lock<std::shared_mutex> lock(shard.mutex);
+      auto it = shard.ranges.lower_bound(begin);
+      return it != shard.ranges.end() && it->first < end;
+    }
+
+    std::shared_mutex mutex;
+    range_map_t ranges;
+  };
+
+  struct level_t {
+    explicit level_t(unsigned chunk_bits) : chunk_bits(chunk_bits) {}
+
+    shard_t &get_shard(uintptr_t addr) {
+      // Spread consecutive chunks over the shards with a multiplicative hash.
+      const uint64_t chunk = static_cast<uint64_t>(addr >> chunk_bits);
+      const uint64_t h = chunk * 0x9e3779b97f4a7c15ull;
+      return shards[h >> (64 - shard_bits)];
+    }
+
+    // Searches the shard of the chunk containing chunk_addr for the
+    // allocation containing addr.
+    const usm_alloc_info *find(uintptr_t chunk_addr, uintptr_t addr) {
+      shard_t &shard = get_shard(chunk_addr);
+      std::shared_lock<std::shared_mutex> lock(shard.mutex);
+      auto it = shard.ranges.upper_bound(addr);
+      if (it == shard.ranges.begin())
+        return nullptr;
+      --it;
+      return addr < it->second.end ? it->second.info : nullptr;
+    }
+
+    const unsigned chunk_bits;
+    // The number of allocations, so that lookups can skip empty levels.
+    std::atomic<size_t> count{0};
+    std::array<shard_t, num_shards> shards;
+  };
+
+  // The chunk size of each level, in bits, from 64 KiB to half the address
+  // space, so that every allocation fits in a level.
+  static constexpr std::array<unsigned, 4> level_chunk_bits = {16, 28, 40, 63};
+
+  static size_t level_of(size_t size) {
+    size_t level = 0;
+    while (level + 1 < level_chunk_bits.size() &&
+           size > (size_t{1} << level_chunk_bits[level]))
+      level++;
+    return level;
+  }
+
+  std::array<level_t, level_chunk_bits.size()> levels = {
+      level_t(level_chunk_bits[0]), level_t(level_chunk_bits[1]),
+      level_t(level_chunk_bits[2]), level_t(level_chunk_bits[3])};
+};
+
+// The virtual memory reservations of a context and the access flags of the
+// ranges mapped in them, neither of which can be read back from the OS
+// cheaply. Setting the flags of a range splits the ranges it partially
+// overlaps.
+class virtual_mem_tracker {
+public:
+  void reserve(const void *begin, size_t size) {
+    const uintptr_t b = reinterpret_cast<uintptr_t>(begin);
+    std::lock_guard<std::mutex> lock(mutex);
+    reservations.emplace(b, b + size);
+  }
+
+  // Returns whether [begin, begin + size) lies within a single reservation.
+  bool is_reserved(const void *begin, size_t size) {
+    const uintptr_t b = reinterpret_cast<uintptr_t>(begin);
+    std::lock_guard<std::mutex> lock(mutex);
+    return find_reservation(b, size) != reservations.end();
+  }
+
+  // Returns whether all of [begin, begin + size) is mapped.
+  bool is_mapped(const void *begin, size_t size) {
+    uintptr_t b = reinterpret_cast<uintptr_t>(begin);
+    const uintptr_t e = b + size;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ranges.upper_bound(b);
+    if (it == ranges.begin())
+      return false;
+    --it;
+    // Mapped ranges next to each other may come from separate maps.
+    for (; it != ranges.end() && it->first <= b && b < e; ++it)
+      b = std::max(b, it->second.end);
+    return b >= e;
+  }
+
+  // Removes [begin, begin + size), which must be within a reservation, from
+  // it, and forgets the flags of the ranges mapped in it.
+  void release(const void *begin, size_t size) {
+    const uintptr_t b = reinterpret_cast<uintptr_t>(begin);
+    const uintptr_t e = b + size;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = find_reservation(b, size);
+    if (it == reservations.end())
+      return;
+    const uintptr_t first = it->first;
+    const uintptr_t last = it->second;
+    reservations.erase(it);
+    if (first < b)
+      reservations.emplace(first, b);
+    if (e < last)
+      reservations.emplace(e, last);
+    erase_ranges(b, e);
+  }
+
+  // Sets the flags of [begin, end), or forgets them if unmapped.
+  void assign(const void *begin, size_t size,
+              std::optional<ur_virtual_mem_access_flags_t> flags) {
+    const uintptr_t b = reinterpret_cast<uintptr_t>(begin);
+    const uintptr_t e = b + size;
+    std::lock_guard<std::mutex> lock(mutex);
+    erase_ranges(b, e);
+    if (flags)
+      ranges.emplace(b, range_t{e, *flags});
+  }
+
+  // Returns the flags of the mapped range containing ptr, if any.
+  std::optional<ur_virtual_mem_access_flags_t> find(const void *ptr) {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ranges.upper_bound(addr);
+    if (it == ranges.begin())
+      return std::nullopt;
+    --it;
+    if (addr >= it->second.end)
+      return std::nullopt;
+    return it->second.flags;
+  }
+
+private:
+  struct range_t {
+    uintptr_t end;
+    ur_virtual_mem_access_flags_t flags;
+  };
+
+  // Forgets the flags of [b, e).
+  void erase_ranges(uintptr_t b, uintptr_t e) {
+    split(b);
+    split(e);
+    ranges.erase(ranges.lower_bound(b), ranges.lower_bound(e));
+  }
+
+  // Returns the reservation [b, b + size) lies within, if any.
+  std::map<uintptr_t, uintptr_t>::iterator find_reservation(uintptr_t b,
+                                                            size_t size) {
+    auto it = reservations.upper_bound(b);
+    if (it == reservations.begin())
+      return reservations.end();
+    --it;
+    if (b >= it->second || size > it->second - b)
+      return reservations.end();
+    return it;
+  }
+
+  // Splits the range containing addr, if any, so that one starts at addr.
+  void split(uintptr_t addr) {
+    auto it = ranges.upper_bound(addr);
+    if (it == ranges.begin())
+      return;
+    --it;
+    if (it->first < addr && addr < it->second.end) {
+      ranges.emplace(addr, range_t{it->second.end, it->second.flags});
+      it->second.end = addr;
+    }
+  }
+
+  std::mutex mutex;
+  std::map<uintptr_t, range_t> ranges;
+  // Maps the start of each reservation to its end.
+  std::map<uintptr_t, uintptr_t> reservations;
+};
+
+// Host memory registered with urUSMImportExp. It has no header in front of
+// it, so its info is kept here instead.
+struct imported_alloc {
+  imported_alloc(const usm_alloc_info &info, bool locked)
+      : info(info), locked(locked) {}
+  ~imported_alloc();
+
+  usm_alloc_info info;
+  // Whether the memory has been locked into RAM on import.
+  bool locked;
+};
+
 } // namespace native_cpu
 
 struct ur_context_handle_t_ : RefCounted {
-  ur_context_handle_t_(ur_device_handle_t_ *phDevices) : _device{phDevices} {}
+  ur_context_handle_t_(ur_device_handle_t_ *phDevices)
+      : _device{phDevices},
+        _defaultPool{std::make_unique<ur_usm_pool_handle_t_>(this, nullptr)} {}
 
   ur_device_handle_t _device;
 
   ur_result_t remove_alloc(void *ptr) {
-    std::lock_guard<std::mutex> lock(alloc_mutex);
-    const native_cpu::usm_alloc_info &info = native_cpu::get_alloc_info(ptr);
-    UR_ASSERT(info.type != UR_USM_TYPE_UNKNOWN,
+    // The header can only be trusted once the pointer is known to be the
+    // start of a live allocation of this context, and imported memory must
+    // be released instead.
+    const native_cpu::usm_alloc_info *tracked = allocations.find(ptr);
+    UR_ASSERT(tracked && tracked->base_ptr == ptr && tracked->umf_pool,
               UR_RESULT_ERROR_INVALID_MEM_OBJECT);
+    UR_ASSERT(allocations.erase(ptr), UR_RESULT_ERROR_INVALID_MEM_OBJECT);
+    const native_cpu::usm_alloc_info info = native_cpu::get_alloc_info(ptr);
 
-    native_cpu::aligned_free(info.base_alloc_ptr);
-    allocations.erase(ptr);
-    return UR_RESULT_SUCCESS;
+    auto ret =
+        umf::umf2urResult(umfPoolFree(info.umf_pool, info.base_alloc_ptr));
+    // Allocations keep the user pool they were made from alive.
+    if (info.pool)
+      decrementOrDelete(info.pool);
+    return ret;
   }
 
-  // Note this is made non-const to access the mutex
+  // Returns the info of the allocation ptr points into, which doesn't need to
+  // be its start. Note this is made non-const to access the tracker's locks
   const native_cpu::usm_alloc_info &get_alloc_info_entry(const void *ptr) {
-    std::lock_guard<std::mutex> lock(alloc_mutex);
-    auto it = allocations.find(ptr);
-    if (it == allocations.end()) {
+    const native_cpu::usm_alloc_info *info = allocations.find(ptr);
+    if (!info) {
       return native_cpu::usm_alloc_info_null_entry;
     }
 
-    return *(native_cpu::usm_alloc_info *)native_cpu::get_alloc_info_addr(ptr);
+    return *info;
   }
 
+  // Allocates from the given user pool, or from the context's default pool if
+  // it is null.
   void *add_alloc(uint32_t alignment, ur_usm_type_t type, size_t size,
-                  ur_usm_pool_handle_t pool) {
-    std::lock_guard<std::mutex> lock(alloc_mutex);
+                  ur_usm_pool_handle_t pool, bool deviceReadOnly = false) {
     // We need to ensure that we align to at least alignof(usm_alloc_info),
     // otherwise its start address may be unaligned.
     alignment =
         std::max<size_t>(alignment, alignof(native_cpu::usm_alloc_info));
-    void *alloc = native_cpu::malloc_impl(alignment, size);
+    ur_usm_pool_handle_t_ &usmPool = pool ? *pool : *_defaultPool;
+    umf_memory_pool_handle_t umfPool =
+        usmPool.getUMFPool(type, deviceReadOnly);
+    if (!umfPool)
+      return nullptr;
+    void *alloc = native_cpu::malloc_impl(umfPool, alignment, size);
     if (!alloc)
       return nullptr;
     // Compute the address of the pointer that we'll return to the user.
@@ -127,15 +449,30 @@ struct ur_context_handle_t_ : RefCounted {
     if (!info_addr)
       return nullptr;
     // Do a placement new of the alloc_info to avoid allocation and copy
-    auto info = new (info_addr)
-        native_cpu::usm_alloc_info(type, ptr, size, this->_device, pool, alloc);
+    auto info = new (info_addr) native_cpu::usm_alloc_info(
+        type, ptr, size, this->_device, pool, alloc, umfPool);
     if (!info)
       return nullptr;
-    allocations.insert(ptr);
+    if (usmPool.zeroInitialize())
+      std::memset(ptr, 0, size);
+    if (pool)
+      pool->incrementReferenceCount();
+    allocations.insert(ptr, size, info);
     return ptr;
   }
 
+  // Registers host memory allocated outside of the adapter, so that it is
+  // treated as host USM without being copied.
+  ur_result_t import_alloc(void *ptr, size_t size);
+  ur_result_t release_import(void *ptr);
+
+  native_cpu::virtual_mem_tracker virtualMemRanges;
+
 private:
-  std::mutex alloc_mutex;
-  std::set<const void *> allocations;
+  // Serves the allocations that aren't made from a user created pool.
+  std::unique_ptr<ur_usm_pool_handle_t_> _defaultPool;
+  native_cpu::alloc_tracker allocations;
+  std::mutex importsMutex;
+  std::unordered_map<const void *, std::unique_ptr<native_cpu::imported_alloc>>
+      imports;
 };
@@ -28,6 +28,9 @@
 #include <cstdlib>
 #endif
 
+#include <algorithm>
+#include <vector>
+
 #ifdef __APPLE__
 #include <sys/sysctl.h>
 #include <unistd.h>
@@ -70,8 +73,7 @@ uint64_t os_memory_total_size() {
 #endif
 }
 
-static uint64_t os_memory_bounded_size() {
-  const uint64_t size = os_memory_total_size();
+static uint64_t bounded_memory_size(uint64_t size) {
   // Limit the memory size to what fits in a size_t, this is necessary when
   // compiling for 32 bits on a 64 bits host
   return std::numeric_limits<size_t>::max() >= size
@@ -124,18 +126,20 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
                                                     size_t *pPropSizeRet) {
   UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
   UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+  const native_cpu::topology &Topology = hDevice->Platform->Topology;
+  const native_cpu::simd_widths_t &Simd = Topology.getSimdWidths();
 
   switch (static_cast<uint32_t>(propName)) {
   case UR_DEVICE_INFO_TYPE:
     return ReturnValue(UR_DEVICE_TYPE_CPU);
   case UR_DEVICE_INFO_PARENT_DEVICE:
-    return ReturnValue(nullptr);
+    return ReturnValue(hDevice->Parent);
   case UR_DEVICE_INFO_PLATFORM:
     return ReturnValue(hDevice->Platform);
   case UR_DEVICE_INFO_NAME:
     return ReturnValue("SYCL Native CPU");
   case UR_DEVICE_INFO_IMAGE_SUPPORTED:
-    return ReturnValue(bool{false});
+    return ReturnValue(bool{true});
   case UR_DEVICE_INFO_DRIVER_VERSION:
     return ReturnValue("0.0.0");
   case UR_DEVICE_INFO_VENDOR:
@@ -157,7 +161,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     // TODO : Populate return string accordingly - e.g. cl_khr_fp16,
     // cl_khr_fp64, cl_khr_int64_base_atomics,
     // cl_khr_int64_extended_atomics
-    return ReturnValue("cl_khr_fp16, cl_khr_fp64 ");
+    return ReturnValue("cl_khr_fp16, cl_khr_fp64, ur_exp_cooperative_kernels");
   case UR_DEVICE_INFO_VERSION:
     return ReturnValue("0.1");
   case UR_DEVICE_INFO_COMPILER_AVAILABLE:
@@ -166,16 +170,16 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     return ReturnValue(bool{true});
   case UR_DEVICE_INFO_NUM_COMPUTE_UNITS:
   case UR_DEVICE_INFO_MAX_COMPUTE_UNITS:
-    return ReturnValue(static_cast<uint32_t>(hDevice->tp.num_threads()));
   case UR_DEVICE_INFO_PARTITION_MAX_SUB_DEVICES:
-    return ReturnValue(uint32_t{0});
-  case UR_DEVICE_INFO_SUPPORTED_PARTITIONS:
-    // TODO: Ensure this property is tested correctly
-    // Taken from CUDA ur adapter
-    if (pPropSizeRet) {
-      *pPropSizeRet = 0;
-    }
-    return UR_RESULT_SUCCESS;
+    // Partitioning splits the compute units, which are the CPUs the workers
+    // run on rather than the workers themselves.
+    return ReturnValue(static_cast<uint32_t>(hDevice->cpus.size()));
+  case UR_DEVICE_INFO_SUPPORTED_PARTITIONS: {
+    const ur_device_partition_t Partitions[] = {
+        UR_DEVICE_PARTITION_EQUALLY, UR_DEVICE_PARTITION_BY_COUNTS,
+        UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN};
+    return ReturnValue(Partitions, std::size(Partitions));
+  }
   case UR_DEVICE_INFO_VENDOR_ID:
     // '0x8086' : 'Intel HD graphics vendor ID'
     return ReturnValue(uint32_t{0x8086});
@@ -210,45 +214,52 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_MAX_WORK_ITEM_DIMENSIONS:
     return ReturnValue(uint32_t{3});
   case UR_DEVICE_INFO_PARTITION_TYPE:
-    if (pPropSizeRet) {
-      *pPropSizeRet = 0;
+    if (!hDevice->Parent) {
+      if (pPropSizeRet) {
+        *pPropSizeRet = 0;
+      }
+      return UR_RESULT_SUCCESS;
     }
-    return UR_RESULT_SUCCESS;
+    return ReturnValue(hDevice->PartitionType);
   case UR_EXT_DEVICE_INFO_OPENCL_C_VERSION:
     return ReturnValue("");
   case UR_DEVICE_INFO_QUEUE_PROPERTIES:
     return ReturnValue(
         ur_queue_flag_t(UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE |
-                        UR_QUEUE_FLAG_PROFILING_ENABLE));
+                        UR_QUEUE_FLAG_PROFILING_ENABLE |
+                        UR_QUEUE_FLAG_PRIORITY_HIGH |
+                        UR_QUEUE_FLAG_PRIORITY_LOW |
+                        UR_QUEUE_FLAG_SUBMISSION_BATCHED));
   case UR_DEVICE_INFO_MAX_WORK_ITEM_SIZES: {
     struct {
       size_t Arr[3];
     } MaxGroupSize = {{256, 256, 256}};
     return ReturnValue(MaxGroupSize);
   }
+  // The vector widths fill the widest SIMD registers available for the type.
   case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_CHAR:
-  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_SHORT:
-  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_INT:
-  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_LONG:
-  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_FLOAT:
-  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_DOUBLE:
-  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_HALF:
-  // TODO: How can we query vector width in a platform
-  // independent way?
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_CHAR:
-    return ReturnValue(uint32_t{32});
+    return ReturnValue(uint32_t{Simd.Byte});
+  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_SHORT:
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_SHORT:
-    return ReturnValue(uint32_t{16});
+    return ReturnValue(uint32_t{Simd.Byte / 2});
+  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_INT:
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_INT:
-    return ReturnValue(uint32_t{8});
+    return ReturnValue(uint32_t{Simd.Int / 4});
+  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_LONG:
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_LONG:
-    return ReturnValue(uint32_t{4});
+    return ReturnValue(uint32_t{Simd.Int / 8});
+  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_FLOAT:
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_FLOAT:
-    return ReturnValue(uint32_t{8});
+    return ReturnValue(uint32_t{Simd.Float / 4});
+  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_DOUBLE:
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_DOUBLE:
-    return ReturnValue(uint32_t{4});
+    return ReturnValue(uint32_t{Simd.Float / 8});
+  case UR_DEVICE_INFO_PREFERRED_VECTOR_WIDTH_HALF:
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_HALF:
-    return ReturnValue(uint32_t{16});
+    // Without native half arithmetic halves are computed as floats.
+    return ReturnValue(
+        uint32_t{Simd.NativeHalf ? Simd.Float / 2 : Simd.Float / 4});
   case UR_DEVICE_INFO_USM_HOST_SUPPORT:
   case UR_DEVICE_INFO_USM_DEVICE_SUPPORT:
   case UR_DEVICE_INFO_USM_SINGLE_SHARED_SUPPORT:
@@ -275,28 +286,29 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_AVAILABLE:
     return ReturnValue(bool{true});
   case UR_DEVICE_INFO_MAX_READ_IMAGE_ARGS:
+    return ReturnValue(native_cpu::MaxReadImageArgs);
   case UR_DEVICE_INFO_MAX_WRITE_IMAGE_ARGS:
-    /// TODO : Check
-    return ReturnValue(uint32_t{0});
+    return ReturnValue(native_cpu::MaxWriteImageArgs);
   case UR_DEVICE_INFO_IMAGE_MAX_ARRAY_SIZE:
-    /// TODO : Check
-    return ReturnValue(size_t{0});
+    // Matches the limit checked in urMemImageCreate.
+    return ReturnValue(size_t{2048});
   case UR_DEVICE_INFO_MAX_PARAMETER_SIZE:
     /// TODO : Check
     return ReturnValue(size_t{32});
   case UR_DEVICE_INFO_GLOBAL_MEM_CACHE_TYPE:
     return ReturnValue(UR_DEVICE_MEM_CACHE_TYPE_READ_WRITE_CACHE);
   case UR_DEVICE_INFO_GLOBAL_MEM_CACHELINE_SIZE:
-    // TODO : CHECK
-    return ReturnValue(uint32_t{64});
+    return ReturnValue(Topology.getCachelineSize());
   case UR_DEVICE_INFO_GLOBAL_MEM_CACHE_SIZE:
-    // TODO : CHECK
-    return ReturnValue(uint64_t{0});
+    return ReturnValue(Topology.getLastLevelCacheSize());
   case UR_DEVICE_INFO_GLOBAL_MEM_SIZE:
     return ReturnValue(hDevice->mem_size);
-  case UR_DEVICE_INFO_LOCAL_MEM_SIZE:
-    // TODO : CHECK
-    return ReturnValue(uint64_t{32768});
+  case UR_DEVICE_INFO_LOCAL_MEM_SIZE: {
+    // Local memory is private to the worker running the work-group, so it is
+    // as fast as it gets while it fits the L1 data cache.
+    const uint64_t L1 = Topology.getL1DataCacheSize();
+    return ReturnValue(L1 ? L1 : uint64_t{32768});
+  }
   case UR_DEVICE_INFO_MAX_CONSTANT_BUFFER_SIZE:
     // TODO : CHECK
     return ReturnValue(uint64_t{0});
@@ -309,8 +321,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_ERROR_CORRECTION_SUPPORT:
     return ReturnValue(bool{false});
   case UR_DEVICE_INFO_PROFILING_TIMER_RESOLUTION:
-    // TODO : CHECK
-    return ReturnValue(size_t{0});
+    // Timestamps are reported in nanoseconds, see get_timestamp.
+    return ReturnValue(size_t{1});
   case UR_DEVICE_INFO_BUILT_IN_KERNELS:
     // TODO : CHECK
     return ReturnValue("");
@@ -320,7 +332,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_PREFERRED_INTEROP_USER_SYNC:
     return ReturnValue(bool{false});
   case UR_DEVICE_INFO_PARTITION_AFFINITY_DOMAIN:
-    return ReturnValue(ur_device_affinity_domain_flags_t{0});
+    return ReturnValue(ur_device_affinity_domain_flags_t{
+        UR_DEVICE_AFFINITY_DOMAIN_FLAG_NUMA |
+        UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE});
   case UR_DEVICE_INFO_MAX_MEM_ALLOC_SIZE: {
     size_t Global = hDevice->mem_size;
 
@@ -338,8 +352,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_PROFILE:
     return ReturnValue("FULL_PROFILE");
   case UR_DEVICE_INFO_REFERENCE_COUNT:
-    // TODO : CHECK
-    return ReturnValue(uint32_t{0});
+    return ReturnValue(hDevice->getReferenceCount());
   case UR_DEVICE_INFO_BUILD_ON_SUBDEVICE:
     return ReturnValue(bool{0});
   case UR_DEVICE_INFO_ATOMIC_64:
@@ -366,7 +379,6 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_MAX_WORK_GROUPS_3D:
   case UR_DEVICE_INFO_MEMORY_CLOCK_RATE:
   case UR_DEVICE_INFO_MEMORY_BUS_WIDTH:
-  case UR_DEVICE_INFO_GLOBAL_MEM_FREE:
   case UR_DEVICE_INFO_MAX_MEMORY_BANDWIDTH:
   case UR_DEVICE_INFO_MAX_REGISTERS_PER_WORK_GROUP:
   case UR_DEVICE_INFO_IP_VERSION:
@@ -398,6 +410,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
                             UR_MEMORY_SCOPE_CAPABILITY_FLAG_DEVICE;
     return ReturnValue(Capabilities);
   }
+  case UR_DEVICE_INFO_GLOBAL_MEM_FREE: {
+    const uint64_t Free = Topology.getFreeMemory(hDevice->MemNodes);
+    if (!Free)
+      return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
+    return ReturnValue(std::min(Free, hDevice->mem_size));
+  }
   case UR_DEVICE_INFO_ESIMD_SUPPORT:
     return ReturnValue(false);
   case UR_DEVICE_INFO_COMPONENT_DEVICES:
@@ -406,7 +424,11 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
 
   case UR_DEVICE_INFO_VIRTUAL_MEMORY_SUPPORT:
+#ifdef __linux__
+    return ReturnValue(true);
+#else
     return ReturnValue(false);
+#endif
 
   case UR_DEVICE_INFO_COMMAND_BUFFER_SUPPORT_EXP:
   case UR_DEVICE_INFO_COMMAND_BUFFER_EVENT_SUPPORT_EXP:
@@ -416,19 +438,19 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
         static_cast<ur_device_command_buffer_update_capability_flags_t>(0));
 
   case UR_DEVICE_INFO_TIMESTAMP_RECORDING_SUPPORT_EXP:
-    return ReturnValue(false);
+    return ReturnValue(true);
 
   case UR_DEVICE_INFO_ENQUEUE_NATIVE_COMMAND_SUPPORT_EXP:
-    return ReturnValue(false);
+    return ReturnValue(true);
 
   case UR_DEVICE_INFO_HOST_PIPE_READ_WRITE_SUPPORTED:
-    return ReturnValue(ur_bool_t{false});
+    return ReturnValue(ur_bool_t{true});
 
   case UR_DEVICE_INFO_USM_POOL_SUPPORT:
-    return ReturnValue(false);
+    return ReturnValue(true);
 
   case UR_DEVICE_INFO_LOW_POWER_EVENTS_EXP:
-    return ReturnValue(false);
+    return ReturnValue(true);
 
   case UR_DEVICE_INFO_KERNEL_SET_SPECIALIZATION_CONSTANTS:
   case UR_DEVICE_INFO_PROGRAM_SET_SPECIALIZATION_CONSTANTS:
@@ -443,6 +465,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
 UR_APIEXPORT ur_result_t UR_APICALL urDeviceRetain(ur_device_handle_t hDevice) {
   UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE)
 
+  // The root device lives as long as the platform.
+  if (hDevice->Parent)
+    hDevice->incrementReferenceCount();
   return UR_RESULT_SUCCESS;
 }
 
@@ -450,28 +475,118 @@ UR_APIEXPORT ur_result_t UR_APICALL
 urDeviceRelease(ur_device_handle_t hDevice) {
   UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE)
 
+  if (hDevice->Parent)
+    decrementOrDelete(hDevice);
   return UR_RESULT_SUCCESS;
 }
 
+// Splits the compute units of hDevice into the CPU sets of the sub-devices
+// described by pProperties.
+static ur_result_t
+partitionCpus(ur_device_handle_t hDevice,
+              const ur_device_partition_properties_t *pProperties,
+              std::vector<std::vector<int>> &Groups) {
+  const std::vector<int> &Cpus = hDevice->cpus;
+  const ur_device_partition_property_t &First = pProperties->pProperties[0];
+  switch (First.type) {
+  case UR_DEVICE_PARTITION_EQUALLY: {
+    const size_t PerDevice = First.value.equally;
+    UR_ASSERT(PerDevice != 0, UR_RESULT_ERROR_INVALID_VALUE);
+    UR_ASSERT(PerDevice <= Cpus.size(),
+              UR_RESULT_ERROR_DEVICE_PARTITION_FAILED);
+    for (size_t Start = 0; Start + PerDevice <= Cpus.size();
+         Start += PerDevice) {
+      Groups.emplace_back(Cpus.begin() + Start,
+                          Cpus.begin() + Start + PerDevice);
+    }
+    return UR_RESULT_SUCCESS;
+  }
+  case UR_DEVICE_PARTITION_BY_COUNTS: {
+    size_t Start = 0;
+    for (size_t I = 0; I < pProperties->PropCount; I++) {
+      const ur_device_partition_property_t &Property =
+          pProperties->pProperties[I];
+      UR_ASSERT(Property.type == UR_DEVICE_PARTITION_BY_COUNTS,
+                UR_RESULT_ERROR_INVALID_VALUE);
+      const size_t Count = Property.value.count;
+      UR_ASSERT(Count != 0 && Count <= Cpus.size() - Start,
+                UR_RESULT_ERROR_INVALID_DEVICE_PARTITION_COUNT);
+      Groups.emplace_back(Cpus.begin() + Start, Cpus.begin() + Start + Count);
+      Start += Count;
+    }
+    return UR_RESULT_SUCCESS;
+  }
+  case UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN: {
+    // NUMA nodes are the only domain a CPU is partitioned along.
+    UR_ASSERT(First.value.affinity_domain ==
+                      UR_DEVICE_AFFINITY_DOMAIN_FLAG_NUMA ||
+                  First.value.affinity_domain ==
+                      UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE,
+              UR_RESULT_ERROR_DEVICE_PARTITION_FAILED);
+    for (const auto &Node : hDevice->Platform->Topology.getNumaNodes()) {
+      std::vector<int> Group;
+      std::copy_if(Cpus.begin(), Cpus.end(), std::back_inserter(Group),
+                   [&](int Cpu) {
+                     return std::find(Node.Cpus.begin(), Node.Cpus.end(),
+                                      Cpu) != Node.Cpus.end();
+                   });
+      if (!Group.empty())
+        Groups.push_back(std::move(Group));
+    }
+    // Without NUMA information everything is in a single domain.
+    if (Groups.empty())
+      Groups.push_back(Cpus);
+    return UR_RESULT_SUCCESS;
+  }
+  default:
+    return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
+  }
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urDevicePartition(
     ur_device_handle_t hDevice,
     const ur_device_partition_properties_t *pProperties, uint32_t NumDevices,
-    ur_device_handle_t *phSubDevices, uint32_t *pNumDevicesRet) {
-  std::ignore = hDevice;
-  std::ignore = NumDevices;
-  std::ignore = pProperties;
-  std::ignore = phSubDevices;
-  std::ignore = pNumDevicesRet;
+    ur_device_handle_t *phSubDevices, uint32_t *pNumDevicesRet) try {
+  UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pProperties && pProperties->pProperties,
+            UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pProperties->PropCount != 0, UR_RESULT_ERROR_INVALID_VALUE);
+
+  std::vector<std::vector<int>> Groups;
+  if (auto Result = partitionCpus(hDevice, pProperties, Groups);
+      Result != UR_RESULT_SUCCESS) {
+    return Result;
+  }
 
-  DIE_NO_IMPLEMENTATION;
+  if (pNumDevicesRet) {
+    *pNumDevicesRet = static_cast<uint32_t>(Groups.size());
+  }
+  if (phSubDevices) {
+    const size_t Count = std::min<size_t>(NumDevices, Groups.size());
+    for (size_t I = 0; I < Count; I++) {
+      ur_device_partition_property_t Partition = pProperties->pProperties[0];
+      if (Partition.type == UR_DEVICE_PARTITION_BY_COUNTS) {
+        Partition = pProperties->pProperties[I];
+      } else if (Partition.type == UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN) {
+        Partition.value.affinity_domain = UR_DEVICE_AFFINITY_DOMAIN_FLAG_NUMA;
+      }
+      phSubDevices[I] = new ur_device_handle_t_(hDevice, Groups[I], Partition);
+    }
+  }
+  return UR_RESULT_SUCCESS;
+} catch (...) {
+  return exceptionToResult(std::current_exception());
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetNativeHandle(
     ur_device_handle_t hDevice, ur_native_handle_t *phNativeDevice) {
-  std::ignore = hDevice;
-  std::ignore = phNativeDevice;
+  UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(phNativeDevice, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
-  DIE_NO_IMPLEMENTATION
+  // There is no native API behind the device, the handle itself is what
+  // identifies it. This is also used to key the USM pools.
+  *phNativeDevice = reinterpret_cast<ur_native_handle_t>(hDevice);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urDeviceCreateWithNativeHandle(
@@ -523,5 +638,48 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceSelectBinary(
   return UR_RESULT_ERROR_INVALID_BINARY;
 }
 
+// Returns the NUMA nodes holding the memory of a sub-device on Cpus, or none
+// if that is all the memory of the system.
+static std::vector<int> local_memory_nodes(ur_device_handle_t Parent,
+                                           const std::vector<int> &Cpus) {
+  const native_cpu::topology &Topology = Parent->Platform->Topology;
+  std::vector<int> Nodes = Topology.getNodesOf(Cpus);
+  if (Nodes.size() == Topology.getNumaNodes().size() ||
+      !Topology.getMemSize(Nodes))
+    return {};
+  return Nodes;
+}
+
 ur_device_handle_t_::ur_device_handle_t_(ur_platform_handle_t ArgPlt)
-    : mem_size(os_memory_bounded_size()), Platform(ArgPlt) {}
+    : mem_size(bounded_memory_size(os_memory_total_size())), Platform(ArgPlt) {
+  // Calibrate the timestamp clock up front rather than on the first
+  // profiled command.
+  native_cpu::detail::get_tsc_calibration();
+
+  // Sub-devices pin a worker to each of their CPUs, and mustn't share them,
+  // so only as many CPUs as there are workers are partitioned, each of them
+  // once even if the workers outnumber them.
+  const std::vector<int> &Available = Platform->Topology.getCpus();
+  cpus.assign(Available.begin(),
+              Available.begin() +
+                  std::min<size_t>(tp.num_threads(), Available.size()));
+}
+
+ur_device_handle_t_::ur_device_handle_t_(
+    ur_device_handle_t Parent, const std::vector<int> &Cpus,
+    const ur_device_partition_property_t &Partition)
+    : tp(Cpus), mem_size(Parent->mem_size), Platform(Parent->Platform),
+      cpus(Cpus), MemNodes(local_memory_nodes(Parent, Cpus)), Parent(Parent),
+      PartitionType(Partition) {
+  // A sub-device confined to some of the NUMA nodes reports their memory.
+  if (!MemNodes.empty()) {
+    mem_size = bounded_memory_size(Platform->Topology.getMemSize(MemNodes));
+  }
+  // Sub-devices keep their parent alive.
+  urDeviceRetain(Parent);
+}
+
+ur_device_handle_t_::~ur_device_handle_t_() {
+  if (Parent)
+    urDeviceRelease(Parent);
+}
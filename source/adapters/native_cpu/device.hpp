@@ -10,13 +10,40 @@
 
 #pragma once
 
+#include "common.hpp"
 #include "threadpool.hpp"
 #include <ur/ur.hpp>
+#include <vector>
 
-struct ur_device_handle_t_ {
+namespace native_cpu {
+// The most image arguments a kernel may read and write, which kernels are
+// held to as their arguments are set.
+constexpr uint32_t MaxReadImageArgs = 128;
+constexpr uint32_t MaxWriteImageArgs = 64;
+} // namespace native_cpu
+
+struct ur_device_handle_t_ : RefCounted {
   native_cpu::threadpool_t tp;
   ur_device_handle_t_(ur_platform_handle_t ArgPlt);
+  // Creates a sub-device of Parent with one worker pinned to each of Cpus.
+  ur_device_handle_t_(ur_device_handle_t Parent, const std::vector<int> &Cpus,
+                      const ur_device_partition_property_t &Partition);
+  ~ur_device_handle_t_();
 
-  const uint64_t mem_size;
+  uint64_t mem_size;
   ur_platform_handle_t Platform;
+
+  // The distinct CPU of each compute unit, which partitioning splits between
+  // the sub-devices. The workers of the root device aren't pinned, so for it
+  // these are just the CPUs the process may run on, no more than there are
+  // workers. With more workers than CPUs, the extra workers don't add compute
+  // units.
+  std::vector<int> cpus;
+  // The NUMA nodes the memory of the device is on, none if it is all the
+  // memory of the system.
+  std::vector<int> MemNodes;
+  // Null for the root device.
+  ur_device_handle_t Parent = nullptr;
+  // How the device was partitioned from its parent.
+  ur_device_partition_property_t PartitionType{};
 };
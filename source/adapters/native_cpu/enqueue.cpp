@@ -5,9 +5,14 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 //
 //===----------------------------------------------------------------------===//
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include "ur_api.h"
@@ -15,61 +20,58 @@
 #include "common.hpp"
 #include "event.hpp"
 #include "kernel.hpp"
+#include "launch_plan.hpp"
 #include "memory.hpp"
+#include "program.hpp"
 #include "queue.hpp"
 #include "threadpool.hpp"
 
-namespace native_cpu {
-struct NDRDescT {
-  using RangeT = std::array<size_t, 3>;
-  uint32_t WorkDim;
-  RangeT GlobalOffset;
-  RangeT GlobalSize;
-  RangeT LocalSize;
-  NDRDescT(uint32_t WorkDim, const size_t *GlobalWorkOffset,
-           const size_t *GlobalWorkSize, const size_t *LocalWorkSize)
-      : WorkDim(WorkDim) {
-    for (uint32_t I = 0; I < WorkDim; I++) {
-      GlobalOffset[I] = GlobalWorkOffset[I];
-      GlobalSize[I] = GlobalWorkSize[I];
-      LocalSize[I] = LocalWorkSize ? LocalWorkSize[I] : 1;
+// Executes the work-groups of a chunk of a launch plan.
+static void runChunk(const native_cpu::launch_plan_t &plan,
+                     const native_cpu::launch_chunk_t &chunk,
+                     ur_kernel_handle_t_ &kernel, size_t threadId) {
+  const auto &numGroups =
+      chunk.Resized ? plan.ResizedNumGroups : plan.NumGroups;
+  native_cpu::state state = chunk.Resized ? plan.ResizedState : plan.State;
+  const auto args = kernel.getArgs(plan.NumThreads, threadId);
+  size_t g0 = chunk.Begin % numGroups[0];
+  size_t g1 = chunk.Begin / numGroups[0] % numGroups[1];
+  size_t g2 = chunk.Begin / numGroups[0] / numGroups[1];
+  for (size_t group = chunk.Begin; group < chunk.End; group++) {
+#ifndef NATIVECPU_USE_OCK
+    const auto &localSize = plan.ndr.LocalSize;
+    for (size_t local2 = 0; local2 < localSize[2]; local2++) {
+      for (size_t local1 = 0; local1 < localSize[1]; local1++) {
+        for (size_t local0 = 0; local0 < localSize[0]; local0++) {
+          state.update(g0, g1, g2, local0, local1, local2);
+          kernel._subhandler(args.data(), &state);
+        }
+      }
     }
-    for (uint32_t I = WorkDim; I < 3; I++) {
-      GlobalSize[I] = 1;
-      LocalSize[I] = LocalSize[0] ? 1 : 0;
-      GlobalOffset[I] = 0;
+#else
+    state.update(g0, g1, g2);
+    kernel._subhandler(args.data(), &state);
+#endif
+    if (++g0 == numGroups[0]) {
+      g0 = 0;
+      if (++g1 == numGroups[1]) {
+        g1 = 0;
+        g2++;
+      }
     }
   }
-
-  void dump(std::ostream &os) const {
-    os << "GlobalSize: " << GlobalSize[0] << " " << GlobalSize[1] << " "
-       << GlobalSize[2] << "\n";
-    os << "LocalSize: " << LocalSize[0] << " " << LocalSize[1] << " "
-       << LocalSize[2] << "\n";
-    os << "GlobalOffset: " << GlobalOffset[0] << " " << GlobalOffset[1] << " "
-       << GlobalOffset[2] << "\n";
-  }
-};
-} // namespace native_cpu
-
-#ifdef NATIVECPU_USE_OCK
-static native_cpu::state getResizedState(const native_cpu::NDRDescT &ndr,
-                                         size_t itemsPerThread) {
-  native_cpu::state resized_state(
-      ndr.GlobalSize[0], ndr.GlobalSize[1], ndr.GlobalSize[2], itemsPerThread,
-      ndr.LocalSize[1], ndr.LocalSize[2], ndr.GlobalOffset[0],
-      ndr.GlobalOffset[1], ndr.GlobalOffset[2]);
-  return resized_state;
 }
-#endif
 
-UR_APIEXPORT ur_result_t UR_APICALL urEnqueueKernelLaunch(
+// Cooperative launches run every work-group in a task of its own, and the
+// threadpool runs all these tasks at the same time, so they can't outnumber
+// the workers.
+static ur_result_t enqueueKernelLaunch_impl(
     ur_queue_handle_t hQueue, ur_kernel_handle_t hKernel, uint32_t workDim,
     const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
     const size_t *pLocalWorkSize, uint32_t numEventsInWaitList,
-    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent,
+    bool cooperative) {
 
-  urEventWait(numEventsInWaitList, phEventWaitList);
   UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
   UR_ASSERT(hKernel, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
   UR_ASSERT(pGlobalWorkOffset, UR_RESULT_ERROR_INVALID_NULL_POINTER);
@@ -80,194 +82,130 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueKernelLaunch(
     DIE_NO_IMPLEMENTATION;
   }
 
-  // Check reqd_work_group_size and other kernel constraints
-  if (pLocalWorkSize != nullptr) {
-    uint64_t TotalNumWIs = 1;
-    for (uint32_t Dim = 0; Dim < workDim; Dim++) {
-      TotalNumWIs *= pLocalWorkSize[Dim];
-      if (auto Reqd = hKernel->getReqdWGSize();
-          Reqd && pLocalWorkSize[Dim] != Reqd.value()[Dim]) {
-        return UR_RESULT_ERROR_INVALID_WORK_GROUP_SIZE;
-      }
-      if (auto MaxWG = hKernel->getMaxWGSize();
-          MaxWG && pLocalWorkSize[Dim] > MaxWG.value()[Dim]) {
-        return UR_RESULT_ERROR_INVALID_WORK_GROUP_SIZE;
+  native_cpu::NDRDescT ndr(workDim, pGlobalWorkOffset, pGlobalWorkSize,
+                           pLocalWorkSize);
+  const size_t numParallelThreads = hQueue->getDevice()->tp.num_threads();
+  const bool localSizeGiven = pLocalWorkSize != nullptr;
+  auto &planCache = hKernel->getLaunchPlans();
+  auto plan = planCache.find(ndr, localSizeGiven, numParallelThreads,
+                             hKernel->hasLocalArgs());
+  if (!plan) {
+    // Check reqd_work_group_size and other kernel constraints
+    if (pLocalWorkSize != nullptr) {
+      uint64_t TotalNumWIs = 1;
+      for (uint32_t Dim = 0; Dim < workDim; Dim++) {
+        TotalNumWIs *= pLocalWorkSize[Dim];
+        if (auto Reqd = hKernel->getReqdWGSize();
+            Reqd && pLocalWorkSize[Dim] != Reqd.value()[Dim]) {
+          return UR_RESULT_ERROR_INVALID_WORK_GROUP_SIZE;
+        }
+        if (auto MaxWG = hKernel->getMaxWGSize();
+            MaxWG && pLocalWorkSize[Dim] > MaxWG.value()[Dim]) {
+          return UR_RESULT_ERROR_INVALID_WORK_GROUP_SIZE;
+        }
       }
-    }
-    if (auto MaxLinearWG = hKernel->getMaxLinearWGSize()) {
-      if (TotalNumWIs > MaxLinearWG) {
-        return UR_RESULT_ERROR_INVALID_WORK_GROUP_SIZE;
+      if (auto MaxLinearWG = hKernel->getMaxLinearWGSize()) {
+        if (TotalNumWIs > MaxLinearWG) {
+          return UR_RESULT_ERROR_INVALID_WORK_GROUP_SIZE;
+        }
       }
     }
+
+    // TODO: add proper error checking
+    plan = std::make_shared<const native_cpu::launch_plan_t>(
+        ndr, localSizeGiven, numParallelThreads, hKernel->hasLocalArgs());
+    planCache.insert(plan);
+  }
+
+  const size_t numGroups =
+      plan->NumGroups[0] * plan->NumGroups[1] * plan->NumGroups[2];
+  if (cooperative && numGroups > numParallelThreads) {
+    return UR_RESULT_ERROR_OUT_OF_RESOURCES;
   }
 
-  // TODO: add proper error checking
-  native_cpu::NDRDescT ndr(workDim, pGlobalWorkOffset, pGlobalWorkSize,
-                           pLocalWorkSize);
-  auto &tp = hQueue->getDevice()->tp;
-  const size_t numParallelThreads = tp.num_threads();
-  std::vector<std::future<void>> futures;
-  std::vector<std::function<void(size_t, ur_kernel_handle_t_ &)>> groups;
-  auto numWG0 = ndr.GlobalSize[0] / ndr.LocalSize[0];
-  auto numWG1 = ndr.GlobalSize[1] / ndr.LocalSize[1];
-  auto numWG2 = ndr.GlobalSize[2] / ndr.LocalSize[2];
-  native_cpu::state state(ndr.GlobalSize[0], ndr.GlobalSize[1],
-                          ndr.GlobalSize[2], ndr.LocalSize[0], ndr.LocalSize[1],
-                          ndr.LocalSize[2], ndr.GlobalOffset[0],
-                          ndr.GlobalOffset[1], ndr.GlobalOffset[2]);
   auto event = new ur_event_handle_t_(hQueue, UR_COMMAND_KERNEL_LAUNCH);
-  event->tick_start();
 
   // Create a copy of the kernel and its arguments.
   auto kernel = std::make_unique<ur_kernel_handle_t_>(*hKernel);
   kernel->updateMemPool(numParallelThreads);
 
-#ifndef NATIVECPU_USE_OCK
-  for (unsigned g2 = 0; g2 < numWG2; g2++) {
-    for (unsigned g1 = 0; g1 < numWG1; g1++) {
-      for (unsigned g0 = 0; g0 < numWG0; g0++) {
-        for (unsigned local2 = 0; local2 < ndr.LocalSize[2]; local2++) {
-          for (unsigned local1 = 0; local1 < ndr.LocalSize[1]; local1++) {
-            for (unsigned local0 = 0; local0 < ndr.LocalSize[0]; local0++) {
-              state.update(g0, g1, g2, local0, local1, local2);
-              kernel->_subhandler(kernel->getArgs(1, 0).data(), &state);
-            }
-          }
-        }
-      }
+  native_cpu::command_t cmd(native_cpu::command_t::kind_t::kernel_launch,
+                            event, numEventsInWaitList, phEventWaitList);
+  cmd.work = ndr.GlobalSize[0] * ndr.GlobalSize[1] * ndr.GlobalSize[2];
+  cmd.cooperative = cooperative;
+  // The tasks are scheduled on the threadpool when the command is dispatched.
+  // They refer to the plan and the kernel copy, which the event keeps alive
+  // until the launch has completed.
+  if (cooperative) {
+    cmd.tasks.reserve(numGroups);
+    for (size_t group = 0; group < numGroups; group++) {
+      const native_cpu::launch_chunk_t chunk{group, group + 1, false};
+      cmd.tasks.push_back(
+          [&plan = *plan, chunk, &kernel = *kernel](size_t threadId) {
+            runChunk(plan, chunk, kernel, threadId);
+          });
     }
-  }
-#else
-  bool isLocalSizeOne =
-      ndr.LocalSize[0] == 1 && ndr.LocalSize[1] == 1 && ndr.LocalSize[2] == 1;
-  if (isLocalSizeOne && ndr.GlobalSize[0] > numParallelThreads &&
-      !kernel->hasLocalArgs()) {
-    // If the local size is one, we make the assumption that we are running a
-    // parallel_for over a sycl::range.
-    // Todo: we could add more compiler checks and
-    // kernel properties for this (e.g. check that no barriers are called).
-
-    // Todo: this assumes that dim 0 is the best dimension over which we want to
-    // parallelize
-
-    // Since we also vectorize the kernel, and vectorization happens within the
-    // work group loop, it's better to have a large-ish local size. We can
-    // divide the global range by the number of threads, set that as the local
-    // size and peel everything else.
-
-    size_t new_num_work_groups_0 = numParallelThreads;
-    size_t itemsPerThread = ndr.GlobalSize[0] / numParallelThreads;
-
-    for (unsigned g2 = 0; g2 < numWG2; g2++) {
-      for (unsigned g1 = 0; g1 < numWG1; g1++) {
-        for (unsigned g0 = 0; g0 < new_num_work_groups_0; g0 += 1) {
-          futures.emplace_back(tp.schedule_task(
-              [ndr, itemsPerThread, &kernel = *kernel, g0, g1, g2](size_t) {
-                native_cpu::state resized_state =
-                    getResizedState(ndr, itemsPerThread);
-                resized_state.update(g0, g1, g2);
-                kernel._subhandler(kernel.getArgs().data(), &resized_state);
-              }));
-        }
-        // Peel the remaining work items. Since the local size is 1, we iterate
-        // over the work groups.
-        for (unsigned g0 = new_num_work_groups_0 * itemsPerThread; g0 < numWG0;
-             g0++) {
-          state.update(g0, g1, g2);
-          kernel->_subhandler(kernel->getArgs().data(), &state);
-        }
-      }
-    }
-
   } else {
-    // We are running a parallel_for over an nd_range
-
-    if (numWG1 * numWG2 >= numParallelThreads) {
-      // Dimensions 1 and 2 have enough work, split them across the threadpool
-      for (unsigned g2 = 0; g2 < numWG2; g2++) {
-        for (unsigned g1 = 0; g1 < numWG1; g1++) {
-          futures.emplace_back(
-              tp.schedule_task([state, &kernel = *kernel, numWG0, g1, g2,
-                                numParallelThreads](size_t threadId) mutable {
-                for (unsigned g0 = 0; g0 < numWG0; g0++) {
-                  state.update(g0, g1, g2);
-                  kernel._subhandler(
-                      kernel.getArgs(numParallelThreads, threadId).data(),
-                      &state);
-                }
-              }));
-        }
-      }
-    } else {
-      // Split dimension 0 across the threadpool
-      // Here we try to create groups of workgroups in order to reduce
-      // synchronization overhead
-      for (unsigned g2 = 0; g2 < numWG2; g2++) {
-        for (unsigned g1 = 0; g1 < numWG1; g1++) {
-          for (unsigned g0 = 0; g0 < numWG0; g0++) {
-            groups.push_back([state, g0, g1, g2, numParallelThreads](
-                                 size_t threadId,
-                                 ur_kernel_handle_t_ &kernel) mutable {
-              state.update(g0, g1, g2);
-              kernel._subhandler(
-                  kernel.getArgs(numParallelThreads, threadId).data(), &state);
-            });
-          }
-        }
-      }
-      auto numGroups = groups.size();
-      auto groupsPerThread = numGroups / numParallelThreads;
-      auto remainder = numGroups % numParallelThreads;
-      for (unsigned thread = 0; thread < numParallelThreads; thread++) {
-        futures.emplace_back(
-            tp.schedule_task([groups, thread, groupsPerThread,
-                              &kernel = *kernel](size_t threadId) {
-              for (unsigned i = 0; i < groupsPerThread; i++) {
-                auto index = thread * groupsPerThread + i;
-                groups[index](threadId, kernel);
-              }
-            }));
-      }
-
-      // schedule the remaining tasks
-      if (remainder) {
-        futures.emplace_back(
-            tp.schedule_task([groups, remainder,
-                              scheduled = numParallelThreads * groupsPerThread,
-                              &kernel = *kernel](size_t threadId) {
-              for (unsigned i = 0; i < remainder; i++) {
-                auto index = scheduled + i;
-                groups[index](threadId, kernel);
-              }
-            }));
-      }
+    cmd.tasks.reserve(plan->Chunks.size());
+    for (const auto &chunk : plan->Chunks) {
+      cmd.tasks.push_back(
+          [&plan = *plan, &chunk, &kernel = *kernel](size_t threadId) {
+            runChunk(plan, chunk, kernel, threadId);
+          });
     }
   }
 
-#endif // NATIVECPU_USE_OCK
-  event->set_futures(futures);
+  event->set_callback(
+      [kernel = std::move(kernel), hKernel, plan = std::move(plan)]() {
+        // TODO: avoid calling clear() here.
+        hKernel->_localArgInfo.clear();
+      });
+  hQueue->submit(std::move(cmd));
 
   if (phEvent) {
     *phEvent = event;
   }
-  event->set_callback([kernel = std::move(kernel), hKernel, event]() {
-    event->tick_end();
-    // TODO: avoid calling clear() here.
-    hKernel->_localArgInfo.clear();
-  });
 
-  if (hQueue->isInOrder()) {
+  // With deferred submission, the commands of in-order queues are waited on
+  // in order when they are dispatched.
+  if (hQueue->isInOrder() && !hQueue->isBatched()) {
     urEventWait(1, &event);
   }
 
   return UR_RESULT_SUCCESS;
 }
 
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueKernelLaunch(
+    ur_queue_handle_t hQueue, ur_kernel_handle_t hKernel, uint32_t workDim,
+    const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
+    const size_t *pLocalWorkSize, uint32_t numEventsInWaitList,
+    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  return enqueueKernelLaunch_impl(hQueue, hKernel, workDim, pGlobalWorkOffset,
+                                  pGlobalWorkSize, pLocalWorkSize,
+                                  numEventsInWaitList, phEventWaitList, phEvent,
+                                  /*cooperative=*/false);
+}
+
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueCooperativeKernelLaunchExp(
+    ur_queue_handle_t hQueue, ur_kernel_handle_t hKernel, uint32_t workDim,
+    const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
+    const size_t *pLocalWorkSize, uint32_t numEventsInWaitList,
+    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  return enqueueKernelLaunch_impl(hQueue, hKernel, workDim, pGlobalWorkOffset,
+                                  pGlobalWorkSize, pLocalWorkSize,
+                                  numEventsInWaitList, phEventWaitList, phEvent,
+                                  /*cooperative=*/true);
+}
+
 ur_result_t withTimingEvent(ur_command_t command_type, ur_queue_handle_t hQueue,
                             uint32_t numEventsInWaitList,
                             const ur_event_handle_t *phEventWaitList,
                             ur_event_handle_t *phEvent,
                             const std::function<ur_result_t()> &f) {
+  // Commands that aren't recorded for deferred submission execute on the host
+  // right away, so anything recorded before them must be dispatched first.
+  if (hQueue->isInOrder())
+    hQueue->flush();
   urEventWait(numEventsInWaitList, phEventWaitList);
   ur_event_handle_t event = nullptr;
   if (phEvent) {
@@ -284,6 +222,35 @@ ur_result_t withTimingEvent(ur_command_t command_type, ur_queue_handle_t hQueue,
   return result;
 }
 
+// Enqueues a command that Run starts once the wait list has completed,
+// without blocking the host. Run is given the function to call once the
+// command is done, which may be called from any thread.
+static ur_result_t
+enqueueAsync(ur_command_t command_type, ur_queue_handle_t hQueue,
+             uint32_t numEventsInWaitList,
+             const ur_event_handle_t *phEventWaitList,
+             ur_event_handle_t *phEvent,
+             std::function<void(std::function<void()> &&)> &&Run) {
+  // The command holds a reference to its event until it is done.
+  auto Event = new ur_event_handle_t_(hQueue, command_type);
+  if (phEvent) {
+    Event->incrementReferenceCount();
+    *phEvent = Event;
+  }
+  auto Finished = std::make_shared<std::promise<void>>();
+  Event->set_futures({Finished->get_future().share()});
+  native_cpu::when_complete(
+      numEventsInWaitList, phEventWaitList, [=, Run = std::move(Run)]() {
+        Event->tick_start();
+        Run([=]() {
+          Event->tick_end();
+          Finished->set_value();
+          decrementOrDelete(Event);
+        });
+      });
+  return UR_RESULT_SUCCESS;
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueEventsWait(
     ur_queue_handle_t hQueue, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
@@ -303,11 +270,16 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueEventsWaitWithBarrier(
 }
 
 UR_APIEXPORT ur_result_t urEnqueueEventsWaitWithBarrierExt(
-    ur_queue_handle_t hQueue, const ur_exp_enqueue_ext_properties_t *,
+    ur_queue_handle_t hQueue,
+    const ur_exp_enqueue_ext_properties_t *pProperties,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
-  return urEnqueueEventsWaitWithBarrier(hQueue, numEventsInWaitList,
-                                        phEventWaitList, phEvent);
+  ur_result_t result = urEnqueueEventsWaitWithBarrier(
+      hQueue, numEventsInWaitList, phEventWaitList, phEvent);
+  if (result == UR_RESULT_SUCCESS && phEvent && pProperties &&
+      (pProperties->flags & UR_EXP_ENQUEUE_EXT_FLAG_LOW_POWER_EVENTS))
+    (*phEvent)->set_wait_policy(native_cpu::wait_policy_t::block);
+  return result;
 }
 
 template <bool IsRead>
@@ -359,10 +331,29 @@ static inline ur_result_t enqueueMemBufferReadWriteRect_impl(
 
 static inline ur_result_t doCopy_impl(ur_queue_handle_t hQueue, void *DstPtr,
                                       const void *SrcPtr, size_t Size,
+                                      bool blocking,
                                       uint32_t numEventsInWaitList,
                                       const ur_event_handle_t *phEventWaitList,
                                       ur_event_handle_t *phEvent,
                                       ur_command_t command_type) {
+  if (hQueue->isBatched()) {
+    ur_event_handle_t event = nullptr;
+    if (phEvent) {
+      event = new ur_event_handle_t_(hQueue, command_type);
+      *phEvent = event;
+    }
+    native_cpu::command_t cmd(native_cpu::command_t::kind_t::copy, event,
+                              numEventsInWaitList, phEventWaitList);
+    cmd.dst = DstPtr;
+    cmd.src = SrcPtr;
+    cmd.size = Size;
+    hQueue->submit(std::move(cmd));
+    // Copies are performed by the thread flushing the queue
+    if (blocking)
+      hQueue->flush();
+    return UR_RESULT_SUCCESS;
+  }
+
   return withTimingEvent(command_type, hQueue, numEventsInWaitList,
                          phEventWaitList, phEvent, [&]() {
                            if (SrcPtr != DstPtr && Size)
@@ -375,11 +366,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferRead(
     ur_queue_handle_t hQueue, ur_mem_handle_t hBuffer, bool blockingRead,
     size_t offset, size_t size, void *pDst, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
-  std::ignore = blockingRead;
-
   void *FromPtr = /*Src*/ hBuffer->_mem + offset;
-  auto res = doCopy_impl(hQueue, pDst, FromPtr, size, numEventsInWaitList,
-                         phEventWaitList, phEvent, UR_COMMAND_MEM_BUFFER_READ);
+  auto res = doCopy_impl(hQueue, pDst, FromPtr, size, blockingRead,
+                         numEventsInWaitList, phEventWaitList, phEvent,
+                         UR_COMMAND_MEM_BUFFER_READ);
   return res;
 }
 
@@ -387,11 +377,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferWrite(
     ur_queue_handle_t hQueue, ur_mem_handle_t hBuffer, bool blockingWrite,
     size_t offset, size_t size, const void *pSrc, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
-  std::ignore = blockingWrite;
-
   void *ToPtr = hBuffer->_mem + offset;
-  auto res = doCopy_impl(hQueue, ToPtr, pSrc, size, numEventsInWaitList,
-                         phEventWaitList, phEvent, UR_COMMAND_MEM_BUFFER_WRITE);
+  auto res = doCopy_impl(hQueue, ToPtr, pSrc, size, blockingWrite,
+                         numEventsInWaitList, phEventWaitList, phEvent,
+                         UR_COMMAND_MEM_BUFFER_WRITE);
   return res;
 }
 
@@ -426,11 +415,11 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferCopy(
     ur_mem_handle_t hBufferDst, size_t srcOffset, size_t dstOffset, size_t size,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
-  urEventWait(numEventsInWaitList, phEventWaitList);
   const void *SrcPtr = hBufferSrc->_mem + srcOffset;
   void *DstPtr = hBufferDst->_mem + dstOffset;
-  return doCopy_impl(hQueue, DstPtr, SrcPtr, size, numEventsInWaitList,
-                     phEventWaitList, phEvent, UR_COMMAND_MEM_BUFFER_COPY);
+  return doCopy_impl(hQueue, DstPtr, SrcPtr, size, false /*blocking*/,
+                     numEventsInWaitList, phEventWaitList, phEvent,
+                     UR_COMMAND_MEM_BUFFER_COPY);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferCopyRect(
@@ -471,24 +460,176 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferFill(
       });
 }
 
+static ur_result_t
+checkEventWaitList(uint32_t numEventsInWaitList,
+                   const ur_event_handle_t *phEventWaitList) {
+  UR_ASSERT((numEventsInWaitList == 0) == (phEventWaitList == nullptr),
+            UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST);
+  for (uint32_t I = 0; I < numEventsInWaitList; I++) {
+    UR_ASSERT(phEventWaitList[I], UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST);
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+static bool imageRegionInBounds(const _ur_image &Image,
+                                ur_rect_offset_t Origin,
+                                ur_rect_region_t Region) {
+  const size_t Offsets[] = {Origin.x, Origin.y, Origin.z};
+  const size_t Sizes[] = {Region.width, Region.height, Region.depth};
+  for (int I = 0; I < 3; I++) {
+    if (Sizes[I] == 0 || Offsets[I] > Image.Extent[I] ||
+        Sizes[I] > Image.Extent[I] - Offsets[I]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+using copy_row_fn_t = std::function<void(size_t Y, size_t Z)>;
+
+// Calls CopyRow(Y, Z) for every row of the region and then Done. Large
+// regions are split into bands of rows run by the workers of the device, the
+// last of which to finish calls Done. Small ones aren't worth the scheduling
+// and are copied by the calling thread.
+static void forEachImageRow(ur_queue_handle_t hQueue, ur_rect_region_t Region,
+                            size_t RowSize, const copy_row_fn_t &CopyRow,
+                            std::function<void()> &&Done) {
+  constexpr size_t MinBytesPerTask = 256 * 1024;
+  const size_t Rows = Region.height * Region.depth;
+  auto &tp = hQueue->getDevice()->tp;
+  const size_t Tasks =
+      std::min({tp.num_threads(), Rows, Rows * RowSize / MinBytesPerTask});
+  if (Tasks <= 1) {
+    for (size_t Row = 0; Row < Rows; Row++) {
+      CopyRow(Row % Region.height, Row / Region.height);
+    }
+    Done();
+    return;
+  }
+
+  struct bands_t {
+    copy_row_fn_t CopyRow;
+    std::function<void()> Done;
+    std::atomic<size_t> Remaining;
+  };
+  const size_t RowsPerTask = (Rows + Tasks - 1) / Tasks;
+  auto Bands = std::make_shared<bands_t>();
+  Bands->CopyRow = CopyRow;
+  Bands->Done = std::move(Done);
+  Bands->Remaining = (Rows + RowsPerTask - 1) / RowsPerTask;
+  for (size_t First = 0; First < Rows; First += RowsPerTask) {
+    const size_t Last = std::min(First + RowsPerTask, Rows);
+    tp.schedule_task([=](size_t) {
+      for (size_t Row = First; Row < Last; Row++) {
+        Bands->CopyRow(Row % Region.height, Row / Region.height);
+      }
+      if (Bands->Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        Bands->Done();
+    });
+  }
+}
+
+// Likewise, returning once all the rows have been copied.
+static void forEachImageRow(ur_queue_handle_t hQueue, ur_rect_region_t Region,
+                            size_t RowSize, const copy_row_fn_t &CopyRow) {
+  auto Finished = std::make_shared<std::promise<void>>();
+  auto Future = Finished->get_future();
+  forEachImageRow(hQueue, Region, RowSize, CopyRow,
+                  [Finished]() { Finished->set_value(); });
+  Future.wait();
+}
+
+// Copies the texels of row (Y, Z) of a region of Image, starting at Origin,
+// from or to the linear row at Host. The row is copied in the runs it is
+// split into by the tiles, with memcpy doing the vectorised moves.
+template <bool IsRead>
+static void copyImageRow(
+    const _ur_image &Image, ur_rect_offset_t Origin, size_t Width, size_t Y,
+    size_t Z,
+    typename std::conditional<IsRead, char *, const char *>::type Host) {
+  const size_t ElementSize = Image.ElementSize;
+  for (size_t X = 0, Run; X < Width; X += Run) {
+    char *Texel = Image.texel(Origin.x + X, Origin.y + Y, Origin.z + Z, Run);
+    Run = std::min(Run, Width - X);
+    if constexpr (IsRead)
+      memcpy(Host + X * ElementSize, Texel, Run * ElementSize);
+    else
+      memcpy(Texel, Host + X * ElementSize, Run * ElementSize);
+  }
+}
+
+// Converts a region between the tiled layout of an image and linear host
+// memory.
+template <bool IsRead>
+static inline ur_result_t enqueueMemImageReadWrite_impl(
+    ur_queue_handle_t hQueue, ur_mem_handle_t hImage, bool blocking,
+    ur_rect_offset_t origin, ur_rect_region_t region, size_t rowPitch,
+    size_t slicePitch,
+    typename std::conditional<IsRead, void *, const void *>::type HostPtr,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_event_handle_t *phEvent) {
+  UR_ASSERT(hQueue && hImage, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(HostPtr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(hImage->isImage(), UR_RESULT_ERROR_INVALID_MEM_OBJECT);
+  if (auto Result = checkEventWaitList(numEventsInWaitList, phEventWaitList);
+      Result != UR_RESULT_SUCCESS) {
+    return Result;
+  }
+
+  const auto *Image = static_cast<const _ur_image *>(hImage);
+  UR_ASSERT(imageRegionInBounds(*Image, origin, region),
+            UR_RESULT_ERROR_INVALID_SIZE);
+
+  // The layers of 1D image arrays are apart by the slice pitch.
+  const size_t RowSize = region.width * Image->ElementSize;
+  const bool Is1DArray = Image->Desc.type == UR_MEM_TYPE_IMAGE1D_ARRAY;
+  if (rowPitch == 0)
+    rowPitch = RowSize;
+  if (slicePitch == 0)
+    slicePitch = Is1DArray ? rowPitch : rowPitch * region.height;
+  const size_t YPitch = Is1DArray ? slicePitch : rowPitch;
+
+  const copy_row_fn_t CopyRow = [=](size_t Y, size_t Z) {
+    auto *Host =
+        ur_cast<typename std::conditional<IsRead, char *, const char *>::type>(
+            HostPtr);
+    copyImageRow<IsRead>(*Image, origin, region.width, Y, Z,
+                         Host + Z * slicePitch + Y * YPitch);
+  };
+  const ur_command_t command_type =
+      IsRead ? UR_COMMAND_MEM_IMAGE_READ : UR_COMMAND_MEM_IMAGE_WRITE;
+
+  // Commands of in-order queues complete before the enqueue returns, like
+  // kernel launches do.
+  if (blocking || hQueue->isInOrder()) {
+    return withTimingEvent(command_type, hQueue, numEventsInWaitList,
+                           phEventWaitList, phEvent, [&]() {
+                             forEachImageRow(hQueue, region, RowSize, CopyRow);
+                             return UR_RESULT_SUCCESS;
+                           });
+  }
+
+  // The image is kept alive until the copy is done.
+  urMemRetain(hImage);
+  return enqueueAsync(command_type, hQueue, numEventsInWaitList,
+                      phEventWaitList, phEvent,
+                      [=](std::function<void()> &&Done) {
+                        forEachImageRow(hQueue, region, RowSize, CopyRow,
+                                        [=]() {
+                                          urMemRelease(hImage);
+                                          Done();
+                                        });
+                      });
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemImageRead(
     ur_queue_handle_t hQueue, ur_mem_handle_t hImage, bool blockingRead,
     ur_rect_offset_t origin, ur_rect_region_t region, size_t rowPitch,
     size_t slicePitch, void *pDst, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
-  std::ignore = hQueue;
-  std::ignore = hImage;
-  std::ignore = blockingRead;
-  std::ignore = origin;
-  std::ignore = region;
-  std::ignore = rowPitch;
-  std::ignore = slicePitch;
-  std::ignore = pDst;
-  std::ignore = numEventsInWaitList;
-  std::ignore = phEventWaitList;
-  std::ignore = phEvent;
-
-  DIE_NO_IMPLEMENTATION;
+  return enqueueMemImageReadWrite_impl<true>(
+      hQueue, hImage, blockingRead, origin, region, rowPitch, slicePitch, pDst,
+      numEventsInWaitList, phEventWaitList, phEvent);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemImageWrite(
@@ -496,19 +637,18 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemImageWrite(
     ur_rect_offset_t origin, ur_rect_region_t region, size_t rowPitch,
     size_t slicePitch, void *pSrc, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
-  std::ignore = hQueue;
-  std::ignore = hImage;
-  std::ignore = blockingWrite;
-  std::ignore = origin;
-  std::ignore = region;
-  std::ignore = rowPitch;
-  std::ignore = slicePitch;
-  std::ignore = pSrc;
-  std::ignore = numEventsInWaitList;
-  std::ignore = phEventWaitList;
-  std::ignore = phEvent;
+  return enqueueMemImageReadWrite_impl<false>(
+      hQueue, hImage, blockingWrite, origin, region, rowPitch, slicePitch,
+      pSrc, numEventsInWaitList, phEventWaitList, phEvent);
+}
 
-  DIE_NO_IMPLEMENTATION;
+static bool imageRegionsOverlap(ur_rect_offset_t A, ur_rect_offset_t B,
+                                ur_rect_region_t Region) {
+  auto Overlap = [](size_t First, size_t Second, size_t Size) {
+    return First < Second + Size && Second < First + Size;
+  };
+  return Overlap(A.x, B.x, Region.width) && Overlap(A.y, B.y, Region.height) &&
+         Overlap(A.z, B.z, Region.depth);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemImageCopy(
@@ -517,17 +657,58 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemImageCopy(
     ur_rect_offset_t dstOrigin, ur_rect_region_t region,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
-  std::ignore = hQueue;
-  std::ignore = hImageSrc;
-  std::ignore = hImageDst;
-  std::ignore = srcOrigin;
-  std::ignore = dstOrigin;
-  std::ignore = region;
-  std::ignore = numEventsInWaitList;
-  std::ignore = phEventWaitList;
-  std::ignore = phEvent;
+  UR_ASSERT(hQueue && hImageSrc && hImageDst,
+            UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(hImageSrc->isImage() && hImageDst->isImage(),
+            UR_RESULT_ERROR_INVALID_MEM_OBJECT);
+  if (auto Result = checkEventWaitList(numEventsInWaitList, phEventWaitList);
+      Result != UR_RESULT_SUCCESS) {
+    return Result;
+  }
 
-  DIE_NO_IMPLEMENTATION;
+  const auto &Src = *static_cast<const _ur_image *>(hImageSrc);
+  const auto &Dst = *static_cast<const _ur_image *>(hImageDst);
+  UR_ASSERT(Src.Format.channelOrder == Dst.Format.channelOrder &&
+                Src.Format.channelType == Dst.Format.channelType,
+            UR_RESULT_ERROR_INVALID_MEM_OBJECT);
+  UR_ASSERT(imageRegionInBounds(Src, srcOrigin, region) &&
+                imageRegionInBounds(Dst, dstOrigin, region),
+            UR_RESULT_ERROR_INVALID_SIZE);
+
+  const size_t RowSize = region.width * Src.ElementSize;
+  return withTimingEvent(
+      UR_COMMAND_MEM_IMAGE_COPY, hQueue, numEventsInWaitList, phEventWaitList,
+      phEvent, [&]() {
+        // Rows of overlapping regions of an image are read and written by
+        // different workers, so the region is staged in linear memory first.
+        if (&Src == &Dst && imageRegionsOverlap(srcOrigin, dstOrigin, region)) {
+          std::vector<char> Staging(RowSize * region.height * region.depth);
+          auto Row = [&](size_t Y, size_t Z) {
+            return Staging.data() + (Z * region.height + Y) * RowSize;
+          };
+          forEachImageRow(hQueue, region, RowSize, [&](size_t Y, size_t Z) {
+            copyImageRow<true>(Src, srcOrigin, region.width, Y, Z, Row(Y, Z));
+          });
+          forEachImageRow(hQueue, region, RowSize, [&](size_t Y, size_t Z) {
+            copyImageRow<false>(Dst, dstOrigin, region.width, Y, Z, Row(Y, Z));
+          });
+          return UR_RESULT_SUCCESS;
+        }
+
+        const size_t ElementSize = Src.ElementSize;
+        forEachImageRow(hQueue, region, RowSize, [&](size_t Y, size_t Z) {
+          for (size_t X = 0, Run; X < region.width; X += Run) {
+            size_t SrcRun, DstRun;
+            const char *From = Src.texel(srcOrigin.x + X, srcOrigin.y + Y,
+                                         srcOrigin.z + Z, SrcRun);
+            char *To = Dst.texel(dstOrigin.x + X, dstOrigin.y + Y,
+                                 dstOrigin.z + Z, DstRun);
+            Run = std::min({SrcRun, DstRun, region.width - X});
+            memcpy(To, From, Run * ElementSize);
+          }
+        });
+        return UR_RESULT_SUCCESS;
+      });
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferMap(
@@ -617,18 +798,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMMemcpy(
     ur_queue_handle_t hQueue, bool blocking, void *pDst, const void *pSrc,
     size_t size, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
-  std::ignore = blocking;
-  return withTimingEvent(
-      UR_COMMAND_USM_MEMCPY, hQueue, numEventsInWaitList, phEventWaitList,
-      phEvent, [&]() {
-        UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_QUEUE);
-        UR_ASSERT(pDst, UR_RESULT_ERROR_INVALID_NULL_POINTER);
-        UR_ASSERT(pSrc, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_QUEUE);
+  UR_ASSERT(pDst, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pSrc, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
-        memcpy(pDst, pSrc, size);
-
-        return UR_RESULT_SUCCESS;
-      });
+  return doCopy_impl(hQueue, pDst, pSrc, size, blocking, numEventsInWaitList,
+                     phEventWaitList, phEvent, UR_COMMAND_USM_MEMCPY);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMPrefetch(
@@ -699,23 +874,45 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMMemcpy2D(
   DIE_NO_IMPLEMENTATION;
 }
 
+template <bool IsRead>
+static ur_result_t enqueueDeviceGlobalVariable_impl(
+    ur_queue_handle_t hQueue, ur_program_handle_t hProgram, const char *name,
+    bool blocking, size_t count, size_t offset,
+    typename std::conditional<IsRead, void *, const void *>::type Ptr,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_event_handle_t *phEvent) {
+  UR_ASSERT(hQueue && hProgram, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(name && Ptr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  if (auto Result = checkEventWaitList(numEventsInWaitList, phEventWaitList);
+      Result != UR_RESULT_SUCCESS) {
+    return Result;
+  }
+
+  auto *Global = hProgram->getDeviceGlobal(name);
+  if (!Global || offset > Global->size || count > Global->size - offset)
+    return UR_RESULT_ERROR_INVALID_VALUE;
+
+  // The variable lives in host memory, so this is a plain copy ordered like
+  // any other on the queue.
+  void *Addr = static_cast<char *>(Global->addr) + offset;
+  if constexpr (IsRead)
+    return doCopy_impl(hQueue, Ptr, Addr, count, blocking, numEventsInWaitList,
+                       phEventWaitList, phEvent,
+                       UR_COMMAND_DEVICE_GLOBAL_VARIABLE_READ);
+  else
+    return doCopy_impl(hQueue, Addr, Ptr, count, blocking, numEventsInWaitList,
+                       phEventWaitList, phEvent,
+                       UR_COMMAND_DEVICE_GLOBAL_VARIABLE_WRITE);
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueDeviceGlobalVariableWrite(
     ur_queue_handle_t hQueue, ur_program_handle_t hProgram, const char *name,
     bool blockingWrite, size_t count, size_t offset, const void *pSrc,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
-  std::ignore = hQueue;
-  std::ignore = hProgram;
-  std::ignore = name;
-  std::ignore = blockingWrite;
-  std::ignore = count;
-  std::ignore = offset;
-  std::ignore = pSrc;
-  std::ignore = numEventsInWaitList;
-  std::ignore = phEventWaitList;
-  std::ignore = phEvent;
-
-  DIE_NO_IMPLEMENTATION;
+  return enqueueDeviceGlobalVariable_impl<false /*write*/>(
+      hQueue, hProgram, name, blockingWrite, count, offset, pSrc,
+      numEventsInWaitList, phEventWaitList, phEvent);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueDeviceGlobalVariableRead(
@@ -723,18 +920,62 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueDeviceGlobalVariableRead(
     bool blockingRead, size_t count, size_t offset, void *pDst,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
-  std::ignore = hQueue;
-  std::ignore = hProgram;
-  std::ignore = name;
-  std::ignore = blockingRead;
-  std::ignore = count;
-  std::ignore = offset;
-  std::ignore = pDst;
-  std::ignore = numEventsInWaitList;
-  std::ignore = phEventWaitList;
-  std::ignore = phEvent;
+  return enqueueDeviceGlobalVariable_impl<true /*read*/>(
+      hQueue, hProgram, name, blockingRead, count, offset, pDst,
+      numEventsInWaitList, phEventWaitList, phEvent);
+}
 
-  DIE_NO_IMPLEMENTATION;
+template <bool IsRead>
+static ur_result_t enqueueHostPipe_impl(
+    ur_queue_handle_t hQueue, ur_program_handle_t hProgram,
+    const char *pipe_symbol, bool blocking,
+    typename std::conditional<IsRead, void *, const void *>::type Ptr,
+    size_t size, uint32_t numEventsInWaitList,
+    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  UR_ASSERT(hQueue && hProgram, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pipe_symbol && Ptr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  if (auto Result = checkEventWaitList(numEventsInWaitList, phEventWaitList);
+      Result != UR_RESULT_SUCCESS) {
+    return Result;
+  }
+
+  native_cpu::host_pipe_t *Pipe = hProgram->getHostPipe(pipe_symbol);
+  if (!Pipe)
+    return UR_RESULT_ERROR_INVALID_VALUE;
+  UR_ASSERT(size <= Pipe->getCapacity(), UR_RESULT_ERROR_INVALID_SIZE);
+  auto Transfer = [Pipe, Ptr, size](native_cpu::host_pipe_t::done_fn_t &&Done) {
+    if constexpr (IsRead)
+      Pipe->read(Ptr, size, std::move(Done));
+    else
+      Pipe->write(Ptr, size, std::move(Done));
+  };
+  const ur_command_t command_type =
+      IsRead ? UR_COMMAND_READ_HOST_PIPE : UR_COMMAND_WRITE_HOST_PIPE;
+
+  // Commands of in-order queues complete before the enqueue returns, like
+  // kernel launches do.
+  if (blocking || hQueue->isInOrder()) {
+    return withTimingEvent(command_type, hQueue, numEventsInWaitList,
+                           phEventWaitList, phEvent, [&]() {
+                             auto Done = std::make_shared<std::promise<void>>();
+                             Transfer([Done]() { Done->set_value(); });
+                             Done->get_future().wait();
+                             return UR_RESULT_SUCCESS;
+                           });
+  }
+
+  // The transfer is queued on the pipe once its dependencies have completed,
+  // and made by whichever thread makes room or data for it at the other end.
+  // It holds a reference to the program that owns the pipe until then.
+  hProgram->incrementReferenceCount();
+  return enqueueAsync(command_type, hQueue, numEventsInWaitList,
+                      phEventWaitList, phEvent,
+                      [=](std::function<void()> &&Done) {
+                        Transfer([=]() {
+                          decrementOrDelete(hProgram);
+                          Done();
+                        });
+                      });
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueReadHostPipe(
@@ -742,17 +983,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueReadHostPipe(
     const char *pipe_symbol, bool blocking, void *pDst, size_t size,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
-  std::ignore = hQueue;
-  std::ignore = hProgram;
-  std::ignore = pipe_symbol;
-  std::ignore = blocking;
-  std::ignore = pDst;
-  std::ignore = size;
-  std::ignore = numEventsInWaitList;
-  std::ignore = phEventWaitList;
-  std::ignore = phEvent;
-
-  DIE_NO_IMPLEMENTATION;
+  return enqueueHostPipe_impl<true>(hQueue, hProgram, pipe_symbol, blocking,
+                                    pDst, size, numEventsInWaitList,
+                                    phEventWaitList, phEvent);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueWriteHostPipe(
@@ -760,23 +993,62 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueWriteHostPipe(
     const char *pipe_symbol, bool blocking, void *pSrc, size_t size,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
-  std::ignore = hQueue;
-  std::ignore = hProgram;
-  std::ignore = pipe_symbol;
-  std::ignore = blocking;
-  std::ignore = pSrc;
-  std::ignore = size;
-  std::ignore = numEventsInWaitList;
-  std::ignore = phEventWaitList;
-  std::ignore = phEvent;
-
-  DIE_NO_IMPLEMENTATION;
+  return enqueueHostPipe_impl<false>(hQueue, hProgram, pipe_symbol, blocking,
+                                     pSrc, size, numEventsInWaitList,
+                                     phEventWaitList, phEvent);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueNativeCommandExp(
-    ur_queue_handle_t, ur_exp_enqueue_native_command_function_t, void *,
-    uint32_t, const ur_mem_handle_t *,
-    const ur_exp_enqueue_native_command_properties_t *, uint32_t,
-    const ur_event_handle_t *, ur_event_handle_t *) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_queue_handle_t hQueue,
+    ur_exp_enqueue_native_command_function_t pfnNativeEnqueue, void *data,
+    uint32_t numMemsInMemList, const ur_mem_handle_t *phMemList,
+    const ur_exp_enqueue_native_command_properties_t *pProperties,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_event_handle_t *phEvent) {
+  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pfnNativeEnqueue, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(numMemsInMemList == 0 || phMemList,
+            UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(std::all_of(phMemList, phMemList + numMemsInMemList,
+                        [](ur_mem_handle_t hMem) { return hMem; }),
+            UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(!pProperties || !(UR_EXP_ENQUEUE_NATIVE_COMMAND_FLAGS_MASK &
+                                pProperties->flags),
+            UR_RESULT_ERROR_INVALID_ENUMERATION);
+  if (auto Result = checkEventWaitList(numEventsInWaitList, phEventWaitList);
+      Result != UR_RESULT_SUCCESS) {
+    return Result;
+  }
+
+  // The memory objects need no migration, their native handles are the host
+  // pointers the function can get from urMemGetNativeHandle. The function runs
+  // as a single task on the threadpool, ordered like a kernel launch.
+  auto event = new ur_event_handle_t_(hQueue, UR_COMMAND_ENQUEUE_NATIVE_EXP);
+  // The command holds a reference to its event until it is done. The one the
+  // event was created with is handed out if the user asked for the event.
+  event->incrementReferenceCount();
+  event->add_user_callback(
+      UR_EXECUTION_INFO_COMPLETE,
+      [](ur_event_handle_t hEvent, ur_execution_info_t, void *) {
+        decrementOrDelete(hEvent);
+      },
+      nullptr);
+  native_cpu::command_t cmd(native_cpu::command_t::kind_t::kernel_launch,
+                            event, numEventsInWaitList, phEventWaitList);
+  cmd.tasks.push_back([hQueue, pfnNativeEnqueue, data](size_t) {
+    pfnNativeEnqueue(hQueue, data);
+  });
+  hQueue->submit(std::move(cmd));
+
+  if (hQueue->isInOrder() && !hQueue->isBatched()) {
+    urEventWait(1, &event);
+  }
+
+  if (phEvent) {
+    *phEvent = event;
+  } else {
+    decrementOrDelete(event);
+  }
+
+  return UR_RESULT_SUCCESS;
 }
@@ -14,7 +14,10 @@
 #include "event.hpp"
 #include "queue.hpp"
 #include <cstdint>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <utility>
 
 UR_APIEXPORT ur_result_t UR_APICALL urEventGetInfo(ur_event_handle_t hEvent,
                                                    ur_event_info_t propName,
@@ -43,16 +46,23 @@ UR_APIEXPORT ur_result_t UR_APICALL urEventGetInfo(ur_event_handle_t hEvent,
 UR_APIEXPORT ur_result_t UR_APICALL urEventGetProfilingInfo(
     ur_event_handle_t hEvent, ur_profiling_info_t propName, size_t propSize,
     void *pPropValue, size_t *pPropSizeRet) {
+  UR_ASSERT(hEvent, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  if (!hEvent->isProfiling())
+    return UR_RESULT_ERROR_PROFILING_INFO_NOT_AVAILABLE;
+
   UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
   switch (propName) {
+  case UR_PROFILING_INFO_COMMAND_QUEUED:
+    return ReturnValue(hEvent->get_queued_timestamp());
+  case UR_PROFILING_INFO_COMMAND_SUBMIT:
+    return ReturnValue(hEvent->get_submit_timestamp());
   case UR_PROFILING_INFO_COMMAND_START:
     return ReturnValue(hEvent->get_start_timestamp());
   case UR_PROFILING_INFO_COMMAND_END:
-    return ReturnValue(hEvent->get_end_timestamp());
-  case UR_PROFILING_INFO_COMMAND_QUEUED:
-  case UR_PROFILING_INFO_COMMAND_SUBMIT:
   case UR_PROFILING_INFO_COMMAND_COMPLETE:
-    return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
+    // Completion is signalled by the same worker that ends the command, so
+    // the two timestamps are the same.
+    return ReturnValue(hEvent->get_end_timestamp());
   default:
     break;
   }
@@ -101,30 +111,63 @@ UR_APIEXPORT ur_result_t UR_APICALL urEventCreateWithNativeHandle(
 UR_APIEXPORT ur_result_t UR_APICALL
 urEventSetCallback(ur_event_handle_t hEvent, ur_execution_info_t execStatus,
                    ur_event_callback_t pfnNotify, void *pUserData) {
-  std::ignore = hEvent;
-  std::ignore = execStatus;
-  std::ignore = pfnNotify;
-  std::ignore = pUserData;
+  UR_ASSERT(hEvent, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pfnNotify, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(execStatus <= UR_EXECUTION_INFO_QUEUED,
+            UR_RESULT_ERROR_INVALID_ENUMERATION);
+  // Every event starts in the queued state, a callback for it would never be
+  // triggered by a status change.
+  UR_ASSERT(execStatus != UR_EXECUTION_INFO_QUEUED,
+            UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION);
 
-  DIE_NO_IMPLEMENTATION;
+  hEvent->add_user_callback(execStatus, pfnNotify, pUserData);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueTimestampRecordingExp(
     ur_queue_handle_t hQueue, bool blocking, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
-  std::ignore = hQueue;
-  std::ignore = blocking;
-  std::ignore = numEventsInWaitList;
-  std::ignore = phEventWaitList;
-  std::ignore = phEvent;
+  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(phEvent, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
-  DIE_NO_IMPLEMENTATION;
+  auto event =
+      new ur_event_handle_t_(hQueue, UR_COMMAND_TIMESTAMP_RECORDING_EXP);
+  // In-order queues complete each command before the next one is enqueued,
+  // so once the recorded commands have been dispatched and the dependencies
+  // are satisfied the command is at the head of the stream.
+  if (hQueue->isInOrder())
+    hQueue->flush();
+  if (blocking) {
+    urEventWait(numEventsInWaitList, phEventWaitList);
+    event->record_timestamp();
+  } else {
+    // Record the timestamp once the dependencies have completed, rather than
+    // blocking the host until they do. Waiters that see the event before then
+    // wait for recorded.
+    auto recorded = std::make_shared<std::promise<void>>();
+    event->set_futures({recorded->get_future().share()});
+    native_cpu::when_complete(numEventsInWaitList, phEventWaitList,
+                              [event, recorded]() {
+                                event->record_timestamp();
+                                recorded->set_value();
+                              });
+  }
+  *phEvent = event;
+
+  return UR_RESULT_SUCCESS;
 }
 
 ur_event_handle_t_::ur_event_handle_t_(ur_queue_handle_t queue,
                                        ur_command_t command_type)
     : queue(queue), context(queue->getContext()), command_type(command_type),
-      done(false) {
+      done(false),
+      // Timestamp recording commands are always timed, regardless of whether
+      // profiling was requested on the queue.
+      profiling(queue->isProfiling() ||
+                command_type == UR_COMMAND_TIMESTAMP_RECORDING_EXP),
+      waitPolicy(queue->getWaitPolicy()), status(UR_EVENT_STATUS_QUEUED) {
+  if (profiling)
+    timestamp_queued.store(get_timestamp(), std::memory_order_relaxed);
   this->queue->addEvent(this);
 }
 
@@ -132,16 +175,31 @@ ur_event_handle_t_::~ur_event_handle_t_() {
   if (!done) {
     wait();
   }
+  auto *cb = user_callbacks.load();
+  while (cb) {
+    delete std::exchange(cb, cb->next);
+  }
 }
 
 void ur_event_handle_t_::wait() {
+  // The command may still be recorded on a queue with deferred submission.
+  if (getExecutionStatus() == UR_EVENT_STATUS_QUEUED)
+    queue->flush();
   std::unique_lock<std::mutex> lock(mutex);
   if (done) {
     return;
   }
-  for (auto &f : futures) {
-    f.wait();
+  // Once the command has been ended by its last task there is no need to wait
+  // for the futures to become ready, which allows a user callback running on a
+  // worker to release the event. The thread that ended the command may still
+  // be invoking the callbacks though, see complete.
+  if (getExecutionStatus() != UR_EVENT_STATUS_COMPLETE) {
+    for (auto &f : futures) {
+      native_cpu::wait_ready(f, waitPolicy);
+    }
   }
+  while (completing.load(std::memory_order_acquire))
+    std::this_thread::yield();
   queue->removeEvent(this);
   done = true;
   // The callback may need to acquire the lock, so we unlock it here
@@ -149,18 +207,148 @@ void ur_event_handle_t_::wait() {
 
   if (callback.valid())
     callback();
+
+  // Commands executed synchronously by the host thread may not have ticked
+  // their end yet. This must come last, see fire_user_callbacks.
+  if (getExecutionStatus() != UR_EVENT_STATUS_COMPLETE)
+    tick_end();
+}
+
+void ur_event_handle_t_::tick_submit() {
+  uint32_t expected = UR_EVENT_STATUS_QUEUED;
+  if (!status.compare_exchange_strong(expected, UR_EVENT_STATUS_SUBMITTED))
+    return;
+  if (profiling)
+    timestamp_submit.store(get_timestamp(), std::memory_order_relaxed);
+  fire_user_callbacks(UR_EVENT_STATUS_SUBMITTED);
 }
 
 void ur_event_handle_t_::tick_start() {
-  if (!queue->isProfiling())
+  // Fast path for all the workers but the first one.
+  uint32_t expected = status.load(std::memory_order_acquire);
+  if (expected <= UR_EVENT_STATUS_RUNNING)
     return;
-  std::lock_guard<std::mutex> lock(mutex);
-  timestamp_start = get_timestamp();
+  const uint64_t now = profiling ? get_timestamp() : 0;
+  while (expected > UR_EVENT_STATUS_RUNNING) {
+    if (profiling) {
+      // A command that didn't go through an explicit submission step was
+      // submitted when it started running. The timestamps are written before
+      // the status changes so that they are visible to anyone observing the
+      // new status.
+      if (expected == UR_EVENT_STATUS_QUEUED)
+        timestamp_submit.store(now, std::memory_order_relaxed);
+      timestamp_start.store(now, std::memory_order_relaxed);
+    }
+    if (status.compare_exchange_weak(expected, UR_EVENT_STATUS_RUNNING)) {
+      fire_user_callbacks(UR_EVENT_STATUS_RUNNING);
+      return;
+    }
+  }
 }
 
 void ur_event_handle_t_::tick_end() {
-  if (!queue->isProfiling())
+  tick_start();
+  // Only the first call ends the command.
+  if (ended.exchange(true))
     return;
-  std::lock_guard<std::mutex> lock(mutex);
-  timestamp_end = get_timestamp();
+  if (profiling)
+    timestamp_end.store(get_timestamp(), std::memory_order_relaxed);
+  complete();
+}
+
+void ur_event_handle_t_::record_timestamp() {
+  // There is no separate dispatch step, the command is submitted as soon as
+  // it is enqueued.
+  timestamp_submit.store(timestamp_queued.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+  const uint64_t now = get_timestamp();
+  timestamp_start.store(now, std::memory_order_relaxed);
+  timestamp_end.store(now, std::memory_order_relaxed);
+  ended.store(true);
+  complete();
+}
+
+void ur_event_handle_t_::complete() {
+  // Whoever waits for the event stops waiting for the tasks as soon as it sees
+  // it complete, and may then release it. Hold a reference until the
+  // callbacks have been invoked, and let waiters know they are still running.
+  // If the reference count is already zero the event is being destroyed by a
+  // waiter, which waits for completing to drop back to zero.
+  const bool retained = tryIncrementReferenceCount();
+  completing.fetch_add(1);
+  status.store(UR_EVENT_STATUS_COMPLETE);
+  fire_user_callbacks(UR_EVENT_STATUS_COMPLETE);
+  completing.fetch_sub(1, std::memory_order_release);
+  if (retained)
+    decrementOrDelete(this);
+}
+
+void ur_event_handle_t_::add_user_callback(ur_execution_info_t execStatus,
+                                           ur_event_callback_t pfnNotify,
+                                           void *pUserData) {
+  auto *cb = new user_callback_t(execStatus, pfnNotify, pUserData);
+  cb->next = user_callbacks.load(std::memory_order_relaxed);
+  while (!user_callbacks.compare_exchange_weak(cb->next, cb))
+    ;
+  // If the status changed before the callback was visible in the list, the
+  // thread changing it may have missed it, so fire it from here. Both the
+  // push above and the status changes are sequentially consistent, so at
+  // least one of the two threads sees the other's update.
+  fire_user_callback(*cb, getExecutionStatus());
+}
+
+void ur_event_handle_t_::fire_user_callbacks(uint32_t newStatus) {
+  auto *cb = user_callbacks.load();
+  if (!cb)
+    return;
+  // A callback may release the last reference to the event, keep it alive
+  // until all of them have been invoked. The reference count is only zero
+  // here if the event is already being destroyed.
+  const bool retained = tryIncrementReferenceCount();
+  for (; cb; cb = cb->next) {
+    fire_user_callback(*cb, newStatus);
+  }
+  if (retained)
+    decrementOrDelete(this);
+}
+
+namespace {
+
+// Counts down the events left to complete before calling f.
+struct pending_events_t {
+  pending_events_t(uint32_t numEvents, std::function<void()> &&f)
+      : remaining(numEvents + 1), f(std::move(f)) {}
+
+  static void notify(ur_event_handle_t, ur_execution_info_t, void *pUserData) {
+    static_cast<pending_events_t *>(pUserData)->release();
+  }
+
+  void release() {
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+      return;
+    f();
+    delete this;
+  }
+
+  // Starts with an extra count on behalf of the thread registering the
+  // callbacks.
+  std::atomic<uint32_t> remaining;
+  std::function<void()> f;
+};
+
+} // namespace
+
+void native_cpu::when_complete(uint32_t numEvents,
+                               const ur_event_handle_t *phEvents,
+                               std::function<void()> &&f) {
+  auto pending = new pending_events_t(numEvents, std::move(f));
+  for (uint32_t i = 0; i < numEvents; i++) {
+    // Events still recorded on a queue with deferred submission would
+    // otherwise only complete once something else flushes their queue.
+    if (phEvents[i]->getExecutionStatus() == UR_EVENT_STATUS_QUEUED)
+      phEvents[i]->getQueue()->flush();
+    phEvents[i]->add_user_callback(UR_EXECUTION_INFO_COMPLETE,
+                                   pending_events_t::notify, pending);
+  }
+  pending->release();
 }
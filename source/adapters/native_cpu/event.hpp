@@ -9,8 +9,11 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 #include "common.hpp"
+#include "threadpool.hpp"
 #include "ur_api.h"
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <future>
 #include <mutex>
 #include <vector>
@@ -27,13 +30,13 @@ struct ur_event_handle_t_ : RefCounted {
 
   void wait();
 
-  uint32_t getExecutionStatus() {
-    // TODO: add support for UR_EVENT_STATUS_RUNNING
-    std::lock_guard<std::mutex> lock(mutex);
-    if (done) {
-      return UR_EVENT_STATUS_COMPLETE;
-    }
-    return UR_EVENT_STATUS_SUBMITTED;
+  // Events start with the wait policy of their queue.
+  void set_wait_policy(native_cpu::wait_policy_t policy) {
+    waitPolicy = policy;
+  }
+
+  uint32_t getExecutionStatus() const {
+    return status.load(std::memory_order_acquire);
   }
 
   ur_queue_handle_t getQueue() const { return queue; }
@@ -42,27 +45,123 @@ struct ur_event_handle_t_ : RefCounted {
 
   ur_command_t getCommandType() const { return command_type; }
 
-  void set_futures(std::vector<std::future<void>> &fs) {
+  // Futures may be shared by several events when their tasks have been merged
+  void set_futures(std::vector<std::shared_future<void>> &&fs) {
     std::lock_guard<std::mutex> lock(mutex);
     futures = std::move(fs);
   }
 
+  // The tick_* functions record the transitions of the command through the
+  // QUEUED -> SUBMITTED -> RUNNING -> COMPLETE states. They may be called from
+  // worker threads and don't take the event mutex.
+  void tick_submit();
+
+  // Only the first call has any effect, so every worker executing a part of
+  // the command can call it when it starts.
   void tick_start();
 
   void tick_end();
 
-  uint64_t get_start_timestamp() const { return timestamp_start; }
+  // Completes a command that consists of sampling the clock only, such as a
+  // timestamp recording command: start and end are the same point in time.
+  void record_timestamp();
 
-  uint64_t get_end_timestamp() const { return timestamp_end; }
+  bool isProfiling() const { return profiling; }
+
+  // Registers a user callback, invoked once the event reaches execStatus or a
+  // later status. If it already has, the callback is invoked immediately.
+  void add_user_callback(ur_execution_info_t execStatus,
+                         ur_event_callback_t pfnNotify, void *pUserData);
+
+  // Used for commands split into several tasks: each task registers itself
+  // with add_pending_task before it is scheduled and calls finish_task once it
+  // completes. The task that brings the count to zero ends the command. The
+  // count starts at one on behalf of the submitting thread, which must call
+  // finish_task once all the tasks have been scheduled.
+  void add_pending_task() {
+    pending_tasks.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void finish_task() {
+    if (pending_tasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      tick_end();
+  }
+
+  uint64_t get_queued_timestamp() const {
+    return timestamp_queued.load(std::memory_order_relaxed);
+  }
+
+  uint64_t get_submit_timestamp() const {
+    return timestamp_submit.load(std::memory_order_relaxed);
+  }
+
+  uint64_t get_start_timestamp() const {
+    return timestamp_start.load(std::memory_order_relaxed);
+  }
+
+  uint64_t get_end_timestamp() const {
+    return timestamp_end.load(std::memory_order_relaxed);
+  }
 
 private:
+  // User callbacks are kept in a lock-free singly linked list. Nodes are only
+  // ever pushed at the head and are freed with the event, so the list can be
+  // walked while other threads register more callbacks.
+  struct user_callback_t {
+    user_callback_t(ur_execution_info_t execStatus,
+                    ur_event_callback_t pfnNotify, void *pUserData)
+        : execStatus(execStatus), pfnNotify(pfnNotify), pUserData(pUserData) {}
+    const ur_execution_info_t execStatus;
+    const ur_event_callback_t pfnNotify;
+    void *const pUserData;
+    // Set by whichever thread invokes the callback, so that it runs once even
+    // if registration races with a status change.
+    std::atomic<bool> fired = false;
+    user_callback_t *next = nullptr;
+  };
+
+  // Invokes the user callbacks that are due now that the event has reached
+  // newStatus. This must be the last thing a status change does, since a
+  // callback may release the event.
+  void fire_user_callbacks(uint32_t newStatus);
+
+  // Publishes the COMPLETE status and invokes the user callbacks that are due.
+  void complete();
+
+  void fire_user_callback(user_callback_t &cb, uint32_t newStatus) {
+    if (newStatus <= static_cast<uint32_t>(cb.execStatus) &&
+        !cb.fired.exchange(true))
+      cb.pfnNotify(this, cb.execStatus, cb.pUserData);
+  }
+
   ur_queue_handle_t queue;
   ur_context_handle_t context;
   ur_command_t command_type;
   bool done;
+  const bool profiling;
+  native_cpu::wait_policy_t waitPolicy;
+  std::atomic<uint32_t> status;
+  std::atomic<uint32_t> pending_tasks = 1;
+  // Set by the thread that ends the command.
+  std::atomic<bool> ended = false;
+  // The number of threads that published the COMPLETE status and may still be
+  // touching the event.
+  std::atomic<uint32_t> completing = 0;
   std::mutex mutex;
-  std::vector<std::future<void>> futures;
+  std::vector<std::shared_future<void>> futures;
   std::packaged_task<void()> callback;
-  uint64_t timestamp_start = 0;
-  uint64_t timestamp_end = 0;
+  std::atomic<user_callback_t *> user_callbacks = nullptr;
+  std::atomic<uint64_t> timestamp_queued = 0;
+  std::atomic<uint64_t> timestamp_submit = 0;
+  std::atomic<uint64_t> timestamp_start = 0;
+  std::atomic<uint64_t> timestamp_end = 0;
 };
+
+namespace native_cpu {
+
+// Calls f once all the events have completed, from whichever thread completes
+// the last of them, or from the calling thread if they all have already.
+void when_complete(uint32_t numEvents, const ur_event_handle_t *phEvents,
+                   std::function<void()> &&f);
+
+} // namespace native_cpu
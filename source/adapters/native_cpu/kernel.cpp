@@ -12,9 +12,11 @@
 #include "ur_util.hpp"
 
 #include "common.hpp"
+#include "device.hpp"
 #include "kernel.hpp"
 #include "memory.hpp"
 #include "program.hpp"
+#include "sampler.hpp"
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urKernelCreate(ur_program_handle_t hProgram, const char *pKernelName,
@@ -22,33 +24,11 @@ urKernelCreate(ur_program_handle_t hProgram, const char *pKernelName,
   UR_ASSERT(hProgram, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
   UR_ASSERT(pKernelName, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
-  auto kernelEntry = hProgram->_kernels.find(pKernelName);
-  if (kernelEntry == hProgram->_kernels.end())
+  auto Desc = hProgram->getKernel(pKernelName);
+  if (!Desc)
     return UR_RESULT_ERROR_INVALID_KERNEL;
 
-  auto f = reinterpret_cast<nativecpu_ptr_t>(
-      const_cast<unsigned char *>(kernelEntry->second));
-  ur_kernel_handle_t_ *kernel;
-
-  // Set reqd_work_group_size for kernel if needed
-  std::optional<native_cpu::WGSize_t> ReqdWG;
-  const auto &ReqdMap = hProgram->KernelReqdWorkGroupSizeMD;
-  if (auto ReqdIt = ReqdMap.find(pKernelName); ReqdIt != ReqdMap.end()) {
-    ReqdWG = ReqdIt->second;
-  }
-
-  std::optional<native_cpu::WGSize_t> MaxWG;
-  const auto &MaxMap = hProgram->KernelMaxWorkGroupSizeMD;
-  if (auto MaxIt = MaxMap.find(pKernelName); MaxIt != MaxMap.end()) {
-    MaxWG = MaxIt->second;
-  }
-  std::optional<uint64_t> MaxLinearWG;
-  const auto &MaxLinMap = hProgram->KernelMaxLinearWorkGroupSizeMD;
-  if (auto MaxLIt = MaxLinMap.find(pKernelName); MaxLIt != MaxLinMap.end()) {
-    MaxLinearWG = MaxLIt->second;
-  }
-  kernel = new ur_kernel_handle_t_(hProgram, pKernelName, *f, ReqdWG, MaxWG,
-                                   MaxLinearWG);
+  auto kernel = new ur_kernel_handle_t_(hProgram, std::move(Desc));
 
   *phKernel = kernel;
 
@@ -100,7 +80,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urKernelGetInfo(ur_kernel_handle_t hKernel,
     //  case UR_KERNEL_INFO_PROGRAM:
     //    return ReturnValue(ur_program_handle_t{ Kernel->Program });
   case UR_KERNEL_INFO_FUNCTION_NAME:
-    return ReturnValue(hKernel->_name);
+    return ReturnValue(hKernel->getName().c_str());
   case UR_KERNEL_INFO_REFERENCE_COUNT:
     return ReturnValue(uint32_t{hKernel->getReferenceCount()});
   case UR_KERNEL_INFO_ATTRIBUTES:
@@ -134,10 +114,8 @@ urKernelGetGroupInfo(ur_kernel_handle_t hKernel, ur_device_handle_t hDevice,
   }
   case UR_KERNEL_GROUP_INFO_COMPILE_WORK_GROUP_SIZE: {
     size_t GroupSize[3] = {0, 0, 0};
-    const auto &ReqdWGSizeMDMap = hKernel->hProgram->KernelReqdWorkGroupSizeMD;
-    const auto ReqdWGSizeMD = ReqdWGSizeMDMap.find(hKernel->_name);
-    if (ReqdWGSizeMD != ReqdWGSizeMDMap.end()) {
-      const auto ReqdWGSize = ReqdWGSizeMD->second;
+    if (const auto &ReqdWGSizeMD = hKernel->getReqdWGSize()) {
+      const auto &ReqdWGSize = *ReqdWGSizeMD;
       GroupSize[0] = std::get<0>(ReqdWGSize);
       GroupSize[1] = std::get<1>(ReqdWGSize);
       GroupSize[2] = std::get<2>(ReqdWGSize);
@@ -247,21 +225,19 @@ UR_APIEXPORT ur_result_t UR_APICALL
 urKernelSetArgSampler(ur_kernel_handle_t hKernel, uint32_t argIndex,
                       const ur_kernel_arg_sampler_properties_t *pProperties,
                       ur_sampler_handle_t hArgValue) {
-  std::ignore = hKernel;
-  std::ignore = argIndex;
   std::ignore = pProperties;
-  std::ignore = hArgValue;
 
-  DIE_NO_IMPLEMENTATION
+  UR_ASSERT(hKernel, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(hArgValue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+
+  hKernel->addPtrArg(&hArgValue->KernelArg, argIndex);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urKernelSetArgMemObj(ur_kernel_handle_t hKernel, uint32_t argIndex,
                      const ur_kernel_arg_mem_obj_properties_t *pProperties,
                      ur_mem_handle_t hArgValue) {
-  std::ignore = argIndex;
-  std::ignore = pProperties;
-
   UR_ASSERT(hKernel, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
 
   // Taken from ur/adapters/cuda/kernel.cpp
@@ -271,6 +247,17 @@ urKernelSetArgMemObj(ur_kernel_handle_t hKernel, uint32_t argIndex,
     return UR_RESULT_SUCCESS;
   }
 
+  if (hArgValue->isImage()) {
+    // Images are read and written unless the access is restricted.
+    ur_mem_flags_t Access = UR_MEM_FLAG_READ_WRITE;
+    if (pProperties && pProperties->memoryAccess)
+      Access = pProperties->memoryAccess;
+    UR_ASSERT(hKernel->addImageArg(
+                  &static_cast<_ur_image *>(hArgValue)->KernelArg, argIndex,
+                  Access),
+              UR_RESULT_ERROR_OUT_OF_RESOURCES);
+    return UR_RESULT_SUCCESS;
+  }
   hKernel->addPtrArg(hArgValue->_mem, argIndex);
   return UR_RESULT_SUCCESS;
 }
@@ -307,6 +294,23 @@ UR_APIEXPORT ur_result_t UR_APICALL urKernelCreateWithNativeHandle(
   DIE_NO_IMPLEMENTATION
 }
 
+UR_APIEXPORT ur_result_t UR_APICALL urKernelSuggestMaxCooperativeGroupCountExp(
+    ur_kernel_handle_t hKernel, ur_device_handle_t hDevice, uint32_t workDim,
+    const size_t *pLocalWorkSize, size_t dynamicSharedMemorySize,
+    uint32_t *pGroupCountRet) {
+  UR_ASSERT(hKernel, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pLocalWorkSize, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pGroupCountRet, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  std::ignore = workDim;
+  std::ignore = dynamicSharedMemorySize;
+
+  // Every work-group of a cooperative launch gets a worker of its own,
+  // whatever its size.
+  *pGroupCountRet = static_cast<uint32_t>(hDevice->tp.num_threads());
+  return UR_RESULT_SUCCESS;
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urKernelGetSuggestedLocalWorkSize(
     [[maybe_unused]] ur_kernel_handle_t hKernel,
     [[maybe_unused]] ur_queue_handle_t hQueue,
@@ -15,10 +15,6 @@
 #include <ur_api.h>
 #include <utility>
 
-using nativecpu_kernel_t = void(void *const *, native_cpu::state *);
-using nativecpu_ptr_t = nativecpu_kernel_t *;
-using nativecpu_task_t = std::function<nativecpu_kernel_t>;
-
 struct local_arg_info_t {
   uint32_t argIndex;
   size_t argSize;
@@ -28,26 +24,17 @@ struct local_arg_info_t {
 
 struct ur_kernel_handle_t_ : RefCounted {
 
-  ur_kernel_handle_t_(ur_program_handle_t hProgram, const char *name,
-                      nativecpu_task_t subhandler)
-      : hProgram(hProgram), _name{name}, _subhandler{std::move(subhandler)} {}
+  ur_kernel_handle_t_(ur_program_handle_t hProgram,
+                      native_cpu::kernel_descriptor_ptr_t desc)
+      : hProgram(hProgram), _desc(std::move(desc)) {}
 
   ur_kernel_handle_t_(const ur_kernel_handle_t_ &other)
-      : Args(other.Args), hProgram(other.hProgram), _name(other._name),
-        _subhandler(other._subhandler), _localArgInfo(other._localArgInfo),
-        ReqdWGSize(other.ReqdWGSize) {}
+      : Args(other.Args), hProgram(other.hProgram), _desc(other._desc),
+        _localArgInfo(other._localArgInfo),
+        _imageArgAccess(other._imageArgAccess) {}
 
   ~ur_kernel_handle_t_() { free(_localMemPool); }
 
-  ur_kernel_handle_t_(ur_program_handle_t hProgram, const char *name,
-                      nativecpu_task_t subhandler,
-                      std::optional<native_cpu::WGSize_t> ReqdWGSize,
-                      std::optional<native_cpu::WGSize_t> MaxWGSize,
-                      std::optional<uint64_t> MaxLinearWGSize)
-      : hProgram(hProgram), _name{name}, _subhandler{std::move(subhandler)},
-        ReqdWGSize(ReqdWGSize), MaxWGSize(MaxWGSize),
-        MaxLinearWGSize(MaxLinearWGSize) {}
-
   struct arguments {
     using args_index_t = std::vector<void *>;
     args_index_t Indices;
@@ -131,17 +118,31 @@ struct ur_kernel_handle_t_ : RefCounted {
   } Args;
 
   ur_program_handle_t hProgram;
-  std::string _name;
-  nativecpu_task_t _subhandler;
+  // Shared with the program and all the other handles for the same kernel.
+  native_cpu::kernel_descriptor_ptr_t _desc;
   std::vector<local_arg_info_t> _localArgInfo;
 
-  std::optional<native_cpu::WGSize_t> getReqdWGSize() const {
-    return ReqdWGSize;
+  const std::string &getName() const { return _desc->name; }
+
+  native_cpu::launch_plan_cache_t &getLaunchPlans() const {
+    return _desc->launchPlans;
   }
 
-  std::optional<native_cpu::WGSize_t> getMaxWGSize() const { return MaxWGSize; }
+  void _subhandler(void *const *args, native_cpu::state *state) const {
+    _desc->entry(args, state);
+  }
 
-  std::optional<uint64_t> getMaxLinearWGSize() const { return MaxLinearWGSize; }
+  const std::optional<native_cpu::WGSize_t> &getReqdWGSize() const {
+    return _desc->reqdWGSize;
+  }
+
+  const std::optional<native_cpu::WGSize_t> &getMaxWGSize() const {
+    return _desc->maxWGSize;
+  }
+
+  const std::optional<uint64_t> &getMaxLinearWGSize() const {
+    return _desc->maxLinearWGSize;
+  }
 
   void updateMemPool(size_t numParallelThreads) {
     // compute requested size.
@@ -182,14 +183,55 @@ struct ur_kernel_handle_t_ : RefCounted {
 
   void addArg(const void *Ptr, size_t Index, size_t Size) {
     Args.addArg(Index, Size, Ptr);
+    setImageArgAccess(Index, 0);
+  }
+
+  void addPtrArg(void *Ptr, size_t Index) {
+    Args.addPtrArg(Index, Ptr);
+    setImageArgAccess(Index, 0);
   }
 
-  void addPtrArg(void *Ptr, size_t Index) { Args.addPtrArg(Index, Ptr); }
+  // Sets an image argument, read and/or written as given by Access. Returns
+  // false, leaving the arguments unchanged, if the kernel would then read or
+  // write more images than the device supports.
+  bool addImageArg(void *Ptr, size_t Index, ur_mem_flags_t Access) {
+    uint32_t Reads = isRead(Access);
+    uint32_t Writes = isWritten(Access);
+    for (size_t I = 0; I < _imageArgAccess.size(); I++) {
+      if (I != Index) {
+        Reads += isRead(_imageArgAccess[I]);
+        Writes += isWritten(_imageArgAccess[I]);
+      }
+    }
+    if (Reads > native_cpu::MaxReadImageArgs ||
+        Writes > native_cpu::MaxWriteImageArgs) {
+      return false;
+    }
+    Args.addPtrArg(Index, Ptr);
+    setImageArgAccess(Index, Access);
+    return true;
+  }
 
 private:
+  static bool isRead(ur_mem_flags_t Access) {
+    return Access & (UR_MEM_FLAG_READ_WRITE | UR_MEM_FLAG_READ_ONLY);
+  }
+
+  static bool isWritten(ur_mem_flags_t Access) {
+    return Access & (UR_MEM_FLAG_READ_WRITE | UR_MEM_FLAG_WRITE_ONLY);
+  }
+
+  void setImageArgAccess(size_t Index, ur_mem_flags_t Access) {
+    if (Index >= _imageArgAccess.size()) {
+      if (!Access)
+        return;
+      _imageArgAccess.resize(Index + 1, 0);
+    }
+    _imageArgAccess[Index] = Access;
+  }
+
   char *_localMemPool = nullptr;
   size_t _localMemPoolSize = 0;
-  std::optional<native_cpu::WGSize_t> ReqdWGSize = std::nullopt;
-  std::optional<native_cpu::WGSize_t> MaxWGSize = std::nullopt;
-  std::optional<uint64_t> MaxLinearWGSize = std::nullopt;
+  // How each argument that is an image is accessed, 0 for the others.
+  std::vector<ur_mem_flags_t> _imageArgAccess;
 };
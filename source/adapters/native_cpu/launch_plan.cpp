@@ -0,0 +1,125 @@
+//===--------- launch_plan.cpp - Native CPU Adapter -----------------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "launch_plan.hpp"
+
+native_cpu::launch_plan_t::launch_plan_t(const NDRDescT &ndr,
+                                         bool LocalSizeGiven,
+                                         size_t NumThreads, bool HasLocalArgs)
+    : ndr(ndr), LocalSizeGiven(LocalSizeGiven), NumThreads(NumThreads),
+      HasLocalArgs(HasLocalArgs),
+      State(ndr.GlobalSize[0], ndr.GlobalSize[1], ndr.GlobalSize[2],
+            ndr.LocalSize[0], ndr.LocalSize[1], ndr.LocalSize[2],
+            ndr.GlobalOffset[0], ndr.GlobalOffset[1], ndr.GlobalOffset[2]),
+      ResizedState(State),
+      NumGroups{ndr.GlobalSize[0] / ndr.LocalSize[0],
+                ndr.GlobalSize[1] / ndr.LocalSize[1],
+                ndr.GlobalSize[2] / ndr.LocalSize[2]},
+      ResizedNumGroups(NumGroups) {
+  const size_t NumWG0 = NumGroups[0];
+  const size_t NumWG1 = NumGroups[1];
+  const size_t NumWG2 = NumGroups[2];
+
+#ifndef NATIVECPU_USE_OCK
+  // Without the work-group loops added by the compiler every work-item is
+  // invoked on its own, all of them from a single task.
+  Chunks.push_back({0, NumWG0 * NumWG1 * NumWG2, false});
+#else
+  bool isLocalSizeOne =
+      ndr.LocalSize[0] == 1 && ndr.LocalSize[1] == 1 && ndr.LocalSize[2] == 1;
+  if (isLocalSizeOne && ndr.GlobalSize[0] > NumThreads && !HasLocalArgs) {
+    // If the local size is one, we make the assumption that we are running a
+    // parallel_for over a sycl::range.
+    // Todo: we could add more compiler checks and
+    // kernel properties for this (e.g. check that no barriers are called).
+
+    // Todo: this assumes that dim 0 is the best dimension over which we want to
+    // parallelize
+
+    // Since we also vectorize the kernel, and vectorization happens within the
+    // work group loop, it's better to have a large-ish local size. We can
+    // divide the global range by the number of threads, set that as the local
+    // size and peel everything else.
+    const size_t ItemsPerThread = ndr.GlobalSize[0] / NumThreads;
+    ResizedState = state(ndr.GlobalSize[0], ndr.GlobalSize[1],
+                         ndr.GlobalSize[2], ItemsPerThread, ndr.LocalSize[1],
+                         ndr.LocalSize[2], ndr.GlobalOffset[0],
+                         ndr.GlobalOffset[1], ndr.GlobalOffset[2]);
+    ResizedNumGroups[0] = NumThreads;
+
+    for (size_t Row = 0; Row < NumWG1 * NumWG2; Row++) {
+      for (size_t G0 = 0; G0 < NumThreads; G0++) {
+        const size_t Group = Row * NumThreads + G0;
+        Chunks.push_back({Group, Group + 1, true});
+      }
+      // Peel the remaining work items. Since the local size is 1, we iterate
+      // over the work groups.
+      if (NumThreads * ItemsPerThread < NumWG0) {
+        Chunks.push_back({Row * NumWG0 + NumThreads * ItemsPerThread,
+                          (Row + 1) * NumWG0, false});
+      }
+    }
+  } else if (NumWG1 * NumWG2 >= NumThreads) {
+    // Dimensions 1 and 2 have enough work, split them across the threadpool
+    for (size_t Row = 0; Row < NumWG1 * NumWG2; Row++) {
+      Chunks.push_back({Row * NumWG0, (Row + 1) * NumWG0, false});
+    }
+  } else {
+    // Split dimension 0 across the threadpool
+    // Here we try to create groups of workgroups in order to reduce
+    // synchronization overhead
+    const size_t NumGroupsTotal = NumWG0 * NumWG1 * NumWG2;
+    const size_t GroupsPerThread = NumGroupsTotal / NumThreads;
+    if (GroupsPerThread) {
+      for (size_t Thread = 0; Thread < NumThreads; Thread++) {
+        Chunks.push_back({Thread * GroupsPerThread,
+                          (Thread + 1) * GroupsPerThread, false});
+      }
+    }
+    // schedule the remaining tasks
+    if (NumThreads * GroupsPerThread < NumGroupsTotal) {
+      Chunks.push_back({NumThreads * GroupsPerThread, NumGroupsTotal, false});
+    }
+  }
+#endif // NATIVECPU_USE_OCK
+}
+
+native_cpu::launch_plan_ptr_t
+native_cpu::launch_plan_cache_t::find(const NDRDescT &ndr, bool LocalSizeGiven,
+                                      size_t NumThreads,
+                                      bool HasLocalArgs) const {
+  if (auto Snapshot = std::atomic_load_explicit(&Plans,
+                                                std::memory_order_acquire)) {
+    for (auto &Plan : *Snapshot) {
+      if (Plan->matches(ndr, LocalSizeGiven, NumThreads, HasLocalArgs)) {
+        Hits.fetch_add(1, std::memory_order_relaxed);
+        return Plan;
+      }
+    }
+  }
+  Misses.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+void native_cpu::launch_plan_cache_t::insert(launch_plan_ptr_t Plan) {
+  std::lock_guard<std::mutex> Lock(InsertMutex);
+  auto Current = std::atomic_load(&Plans);
+  auto Updated = Current ? std::make_shared<plan_list_t>(*Current)
+                         : std::make_shared<plan_list_t>();
+  if (Updated->size() < Capacity) {
+    Updated->push_back(std::move(Plan));
+  } else {
+    (*Updated)[Oldest] = std::move(Plan);
+    Oldest = (Oldest + 1) % Capacity;
+  }
+  std::shared_ptr<const plan_list_t> Snapshot = std::move(Updated);
+  std::atomic_store_explicit(&Plans, std::move(Snapshot),
+                             std::memory_order_release);
+}
@@ -0,0 +1,145 @@
+//===--------- launch_plan.hpp - Native CPU Adapter -----------------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "nativecpu_state.hpp"
+
+namespace native_cpu {
+
+struct NDRDescT {
+  using RangeT = std::array<size_t, 3>;
+  uint32_t WorkDim;
+  RangeT GlobalOffset;
+  RangeT GlobalSize;
+  RangeT LocalSize;
+  NDRDescT(uint32_t WorkDim, const size_t *GlobalWorkOffset,
+           const size_t *GlobalWorkSize, const size_t *LocalWorkSize)
+      : WorkDim(WorkDim) {
+    for (uint32_t I = 0; I < WorkDim; I++) {
+      GlobalOffset[I] = GlobalWorkOffset[I];
+      GlobalSize[I] = GlobalWorkSize[I];
+      LocalSize[I] = LocalWorkSize ? LocalWorkSize[I] : 1;
+    }
+    for (uint32_t I = WorkDim; I < 3; I++) {
+      GlobalSize[I] = 1;
+      LocalSize[I] = LocalSize[0] ? 1 : 0;
+      GlobalOffset[I] = 0;
+    }
+  }
+
+  bool operator==(const NDRDescT &Other) const {
+    return WorkDim == Other.WorkDim && GlobalOffset == Other.GlobalOffset &&
+           GlobalSize == Other.GlobalSize && LocalSize == Other.LocalSize;
+  }
+
+  void dump(std::ostream &os) const {
+    os << "GlobalSize: " << GlobalSize[0] << " " << GlobalSize[1] << " "
+       << GlobalSize[2] << "\n";
+    os << "LocalSize: " << LocalSize[0] << " " << LocalSize[1] << " "
+       << LocalSize[2] << "\n";
+    os << "GlobalOffset: " << GlobalOffset[0] << " " << GlobalOffset[1] << " "
+       << GlobalOffset[2] << "\n";
+  }
+};
+
+// A threadpool task of a kernel launch. It executes the work-groups
+// [Begin, End) of the launch, numbered with dimension 0 varying fastest.
+struct launch_chunk_t {
+  size_t Begin;
+  size_t End;
+  // Whether these are work-groups of the resized ND-range of the plan.
+  bool Resized;
+};
+
+// How a kernel launch is split into threadpool tasks. Plans are validated
+// against the constraints of the kernel before they are built, and only
+// depend on the ND-range, the number of threads and whether the kernel has
+// local arguments, so identical launches of a kernel share theirs.
+struct launch_plan_t {
+  launch_plan_t(const NDRDescT &ndr, bool LocalSizeGiven, size_t NumThreads,
+                bool HasLocalArgs);
+
+  bool matches(const NDRDescT &Other, bool OtherLocalSizeGiven,
+               size_t OtherNumThreads, bool OtherHasLocalArgs) const {
+    return ndr == Other && LocalSizeGiven == OtherLocalSizeGiven &&
+           NumThreads == OtherNumThreads && HasLocalArgs == OtherHasLocalArgs;
+  }
+
+  const NDRDescT ndr;
+  // Launches without a local size aren't checked against the work-group size
+  // constraints of the kernel.
+  const bool LocalSizeGiven;
+  const size_t NumThreads;
+  const bool HasLocalArgs;
+
+  // The state of the first work-item, and the work-group counts, of the
+  // ND-range and of its resized counterpart. Ranges with a local size of one
+  // may be resized to one work-group per thread along dimension 0.
+  state State;
+  state ResizedState;
+  std::array<size_t, 3> NumGroups;
+  std::array<size_t, 3> ResizedNumGroups;
+  std::vector<launch_chunk_t> Chunks;
+};
+
+using launch_plan_ptr_t = std::shared_ptr<const launch_plan_t>;
+
+// Lookups of the launch plan cache of a kernel.
+struct launch_plan_stats_t {
+  uint64_t Hits;
+  uint64_t Misses;
+};
+
+// The plans of the latest distinct launches of a kernel. Lookups don't lock,
+// as launches of the same kernel from several threads would otherwise
+// contend on every launch.
+class launch_plan_cache_t {
+public:
+  // Returns nullptr if there is no matching plan.
+  launch_plan_ptr_t find(const NDRDescT &ndr, bool LocalSizeGiven,
+                         size_t NumThreads, bool HasLocalArgs) const;
+
+  // Adds Plan, replacing the oldest plan if the cache is full.
+  void insert(launch_plan_ptr_t Plan);
+
+  launch_plan_stats_t getStats() const noexcept {
+    return {Hits.load(std::memory_order_relaxed),
+            Misses.load(std::memory_order_relaxed)};
+  }
+
+private:
+  // Iterative workloads alternate between a few ND-ranges at most, so a
+  // short list is searched faster than a hash table.
+  static constexpr size_t Capacity = 8;
+
+  using plan_list_t = std::vector<launch_plan_ptr_t>;
+
+  // Only ever replaced as a whole, by insert, so that find can search a
+  // snapshot of it without locking. Null until the first insertion.
+  std::shared_ptr<const plan_list_t> Plans;
+  // Serializes insertions.
+  std::mutex InsertMutex;
+  size_t Oldest = 0;
+
+  mutable std::atomic<uint64_t> Hits{0};
+  mutable std::atomic<uint64_t> Misses{0};
+};
+
+} // namespace native_cpu
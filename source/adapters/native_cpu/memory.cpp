@@ -8,27 +8,395 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "memory.hpp"
 #include "common.hpp"
+#include "platform.hpp"
+#include "sampler.hpp"
 #include "ur_api.h"
 
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Returns the size in bytes of a texel of the given format, or 0 if the
+// format isn't supported.
+size_t getElementSize(const ur_image_format_t &Format) {
+  size_t Channels;
+  switch (Format.channelOrder) {
+  case UR_IMAGE_CHANNEL_ORDER_A:
+  case UR_IMAGE_CHANNEL_ORDER_R:
+  case UR_IMAGE_CHANNEL_ORDER_RX:
+  case UR_IMAGE_CHANNEL_ORDER_INTENSITY:
+  case UR_IMAGE_CHANNEL_ORDER_LUMINANCE:
+    Channels = 1;
+    break;
+  case UR_IMAGE_CHANNEL_ORDER_RG:
+  case UR_IMAGE_CHANNEL_ORDER_RA:
+  case UR_IMAGE_CHANNEL_ORDER_RGX:
+    Channels = 2;
+    break;
+  case UR_IMAGE_CHANNEL_ORDER_RGB:
+  case UR_IMAGE_CHANNEL_ORDER_RGBX:
+    // These orders are only valid with the packed channel types below.
+    Channels = 0;
+    break;
+  case UR_IMAGE_CHANNEL_ORDER_RGBA:
+  case UR_IMAGE_CHANNEL_ORDER_BGRA:
+  case UR_IMAGE_CHANNEL_ORDER_ARGB:
+  case UR_IMAGE_CHANNEL_ORDER_ABGR:
+    Channels = 4;
+    break;
+  case UR_IMAGE_CHANNEL_ORDER_SRGBA:
+    return Format.channelType == UR_IMAGE_CHANNEL_TYPE_UNORM_INT8 ? 4 : 0;
+  default:
+    return 0;
+  }
+
+  switch (Format.channelType) {
+  case UR_IMAGE_CHANNEL_TYPE_SNORM_INT8:
+  case UR_IMAGE_CHANNEL_TYPE_UNORM_INT8:
+  case UR_IMAGE_CHANNEL_TYPE_SIGNED_INT8:
+  case UR_IMAGE_CHANNEL_TYPE_UNSIGNED_INT8:
+    return Channels;
+  case UR_IMAGE_CHANNEL_TYPE_SNORM_INT16:
+  case UR_IMAGE_CHANNEL_TYPE_UNORM_INT16:
+  case UR_IMAGE_CHANNEL_TYPE_SIGNED_INT16:
+  case UR_IMAGE_CHANNEL_TYPE_UNSIGNED_INT16:
+  case UR_IMAGE_CHANNEL_TYPE_HALF_FLOAT:
+    return Channels * 2;
+  case UR_IMAGE_CHANNEL_TYPE_SIGNED_INT32:
+  case UR_IMAGE_CHANNEL_TYPE_UNSIGNED_INT32:
+  case UR_IMAGE_CHANNEL_TYPE_FLOAT:
+    return Channels * 4;
+  case UR_IMAGE_CHANNEL_TYPE_UNORM_SHORT_565:
+  case UR_IMAGE_CHANNEL_TYPE_UNORM_SHORT_555:
+  case UR_IMAGE_CHANNEL_TYPE_INT_101010: {
+    const bool Packable =
+        Format.channelOrder == UR_IMAGE_CHANNEL_ORDER_RGB ||
+        Format.channelOrder == UR_IMAGE_CHANNEL_ORDER_RGBX;
+    if (!Packable) {
+      return 0;
+    }
+    return Format.channelType == UR_IMAGE_CHANNEL_TYPE_INT_101010 ? 4 : 2;
+  }
+  default:
+    return 0;
+  }
+}
+
+size_t floorPowerOf2(size_t Value) {
+  size_t Result = 1;
+  while (Result * 2 <= Value) {
+    Result *= 2;
+  }
+  return Result;
+}
+
+size_t getFirstTouchThreshold() {
+  static const size_t Threshold = [] {
+    if (const char *Value =
+            std::getenv("UR_NATIVE_CPU_BUFFER_FIRST_TOUCH_THRESHOLD")) {
+      return static_cast<size_t>(std::strtoull(Value, nullptr, 0));
+    }
+    // Smaller buffers fit in the caches, where it matters less which node
+    // their pages are on.
+    return size_t{1} << 20;
+  }();
+  return Threshold;
+}
+
+#ifdef __linux__
+// Sets the policy of the pages of the mapping to be interleaved across Nodes,
+// which takes effect as they are first touched. Calls mbind directly rather
+// than through libnuma, which the adapter doesn't depend on.
+void interleave(void *Ptr, size_t Length, const std::vector<int> &Nodes) {
+  if (Nodes.size() < 2) {
+    return;
+  }
+  constexpr size_t BitsPerWord = sizeof(unsigned long) * 8;
+  const size_t MaxNode = *std::max_element(Nodes.begin(), Nodes.end());
+  std::vector<unsigned long> Mask(MaxNode / BitsPerWord + 1, 0);
+  for (int Node : Nodes) {
+    Mask[Node / BitsPerWord] |= 1UL << (Node % BitsPerWord);
+  }
+  // If this fails the pages are placed by the first touch instead.
+  if (syscall(SYS_mbind, Ptr, Length, MPOL_INTERLEAVE, Mask.data(),
+              Mask.size() * BitsPerWord + 1, 0) != 0) {
+    logger::warning("native_cpu: failed to interleave a buffer across the "
+                    "NUMA nodes of the device");
+  }
+}
+#endif
+
+} // namespace
+
+native_cpu::buffer_mem_t
+native_cpu::alloc_buffer_mem(ur_context_handle_t Context, size_t Size,
+                             const void *HostPtr) {
+  ur_device_handle_t Device = Context->_device;
+  const size_t Workers = Device->tp.num_threads();
+  const size_t Threshold = getFirstTouchThreshold();
+  const bool Large = Threshold != 0 && Size >= Threshold && Workers != 0;
+  const size_t PageSize = get_page_size();
+  buffer_mem_t Mem{nullptr, 0};
+  // Whether the pages are to be touched by the workers that use them.
+  bool FirstTouch = false;
+#ifdef __linux__
+  // Touching the pages from the workers only places them near the workers
+  // that use them if each worker stays on its CPU, as those of sub-devices do.
+  // The workers of the root device can run anywhere, so its buffers are only
+  // mapped here when they are to be interleaved.
+  const bool Interleave = std::getenv("UR_NATIVE_CPU_BUFFER_INTERLEAVE");
+  if (Large && (Device->tp.is_pinned() || Interleave)) {
+    const size_t Length = (Size + PageSize - 1) & ~(PageSize - 1);
+    void *Map = mmap(nullptr, Length, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (Map != MAP_FAILED) {
+      Mem = {static_cast<char *>(Map), Length};
+      if (Interleave) {
+        std::vector<int> Nodes = Device->MemNodes;
+        if (Nodes.empty()) {
+          for (const auto &Node : Device->Platform->Topology.getNumaNodes()) {
+            Nodes.push_back(Node.Id);
+          }
+        }
+        interleave(Mem.Ptr, Length, Nodes);
+      }
+      FirstTouch = Device->tp.is_pinned();
+    }
+  }
+#endif
+  if (!Mem.Ptr) {
+    Mem.Ptr = static_cast<char *>(malloc(Size));
+    if (!Mem.Ptr) {
+      throw UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+    }
+  }
+  // Without placement to care about, large copies are still shared with the
+  // workers, but a single worker wouldn't make them any faster.
+  if (!FirstTouch && (!HostPtr || !Large || Workers < 2)) {
+    if (HostPtr) {
+      memcpy(Mem.Ptr, HostPtr, Size);
+    }
+    return Mem;
+  }
+  // Worker I gets the I-th of as many slices as there are workers, as the
+  // work-groups of a 1D kernel are, but in whole pages. Slices of busy
+  // workers are copied or touched by this thread instead.
+  char *Ptr = Mem.Ptr;
+  const size_t Pages = (Size + PageSize - 1) / PageSize;
+  const size_t Slice = (Pages + Workers - 1) / Workers * PageSize;
+  Device->tp.run_on_idle_workers([=](size_t I) {
+    const size_t First = std::min(I * Slice, Size);
+    const size_t Last = std::min(First + Slice, Size);
+    if (HostPtr) {
+      memcpy(Ptr + First, static_cast<const char *>(HostPtr) + First,
+             Last - First);
+    } else {
+      for (size_t Page = First; Page < Last; Page += PageSize) {
+        Ptr[Page] = 0;
+      }
+    }
+  });
+  return Mem;
+}
+
+void native_cpu::free_buffer_mem(const buffer_mem_t &Mem) {
+#ifdef __linux__
+  if (Mem.MappedSize) {
+    munmap(Mem.Ptr, Mem.MappedSize);
+    return;
+  }
+#endif
+  free(Mem.Ptr);
+}
+
+_ur_image::_ur_image(ur_context_handle_t Context,
+                     const ur_image_format_t &Format,
+                     const ur_image_desc_t &Desc, size_t ElementSize,
+                     ur_mem_flags_t Flags, void *HostPtr)
+    : ur_mem_handle_t_(Context, 0, HostPtr, true), Format(Format), Desc(Desc),
+      ElementSize(ElementSize),
+      LoadTexel(native_cpu::getTexelLoader(Format)), Extent{Desc.width, 1, 1},
+      Tiled(!(Flags & UR_MEM_FLAG_USE_HOST_POINTER)) {
+  switch (Desc.type) {
+  case UR_MEM_TYPE_IMAGE1D_ARRAY:
+    Extent[1] = Desc.arraySize;
+    break;
+  case UR_MEM_TYPE_IMAGE2D:
+    Extent[1] = Desc.height;
+    break;
+  case UR_MEM_TYPE_IMAGE2D_ARRAY:
+    Extent[1] = Desc.height;
+    Extent[2] = Desc.arraySize;
+    break;
+  case UR_MEM_TYPE_IMAGE3D:
+    Extent[1] = Desc.height;
+    Extent[2] = Desc.depth;
+    break;
+  default:
+    break;
+  }
+  Size = Extent[0] * Extent[1] * Extent[2] * ElementSize;
+
+  KernelArg.Texel = [](const native_cpu::image_t *Arg, size_t X, size_t Y,
+                       size_t Z) {
+    return static_cast<const _ur_image *>(Arg->Impl)->texel(X, Y, Z);
+  };
+  KernelArg.Read = [](const native_cpu::image_t *Arg, size_t X, size_t Y,
+                      size_t Z, float Texel[4]) {
+    const auto *Image = static_cast<const _ur_image *>(Arg->Impl);
+    Image->LoadTexel(*Image, Image->texel(X, Y, Z), Texel);
+  };
+  KernelArg.ChannelOrder = Format.channelOrder;
+  KernelArg.ChannelType = Format.channelType;
+  KernelArg.ElementSize = ElementSize;
+  std::copy(Extent, Extent + 3, KernelArg.Extent);
+  KernelArg.Impl = this;
+
+  // Host memory is laid out as described by the pitches, where the slice
+  // pitch of 1D image arrays is the distance between layers.
+  const size_t RowPitch =
+      Desc.rowPitch ? Desc.rowPitch : Desc.width * ElementSize;
+  const bool Is1DArray = Desc.type == UR_MEM_TYPE_IMAGE1D_ARRAY;
+  const size_t SlicePitch =
+      Desc.slicePitch ? Desc.slicePitch
+                      : (Is1DArray ? RowPitch : RowPitch * Extent[1]);
+  Pitch[0] = ElementSize;
+  Pitch[1] = Is1DArray ? SlicePitch : RowPitch;
+  Pitch[2] = SlicePitch;
+
+  if (!Tiled) {
+    return;
+  }
+
+  // A row of a tile fills a cache line. Tiles of 2D images are square in
+  // bytes for 4 byte texels, and those of 3D images are cubes of 4 rows of 4
+  // slices. The layers of image arrays are tiled on their own.
+  TileWidth = floorPowerOf2(std::max<size_t>(64 / ElementSize, 1));
+  if (Desc.type == UR_MEM_TYPE_IMAGE3D) {
+    TileHeight = 4;
+    TileDepth = 4;
+  } else if (Desc.type == UR_MEM_TYPE_IMAGE2D ||
+             Desc.type == UR_MEM_TYPE_IMAGE2D_ARRAY) {
+    TileHeight = 16;
+  }
+  TileTexels = TileWidth * TileHeight * TileDepth;
+  TilesPerRow = (Extent[0] + TileWidth - 1) / TileWidth;
+  TilesPerSlice = TilesPerRow * ((Extent[1] + TileHeight - 1) / TileHeight);
+  const size_t Tiles =
+      TilesPerSlice * ((Extent[2] + TileDepth - 1) / TileDepth);
+
+  _mem = static_cast<char *>(
+      native_cpu::aligned_malloc(64, Tiles * TileTexels * ElementSize));
+  if (!_mem) {
+    throw UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  if (HostPtr) {
+    for (size_t Z = 0; Z < Extent[2]; Z++) {
+      for (size_t Y = 0; Y < Extent[1]; Y++) {
+        const char *Src =
+            static_cast<const char *>(HostPtr) + Z * Pitch[2] + Y * Pitch[1];
+        for (size_t X = 0, Run; X < Extent[0]; X += Run) {
+          char *Dst = texel(X, Y, Z, Run);
+          Run = std::min(Run, Extent[0] - X);
+          memcpy(Dst, Src + X * ElementSize, Run * ElementSize);
+        }
+      }
+    }
+  }
+}
+
+_ur_image::~_ur_image() {
+  if (Tiled) {
+    native_cpu::aligned_free(_mem);
+  }
+}
+
+size_t _ur_image::getSlicePitch() const {
+  if (!Tiled) {
+    return Desc.type == UR_MEM_TYPE_IMAGE1D || Desc.type == UR_MEM_TYPE_IMAGE2D
+               ? 0
+               : Pitch[2];
+  }
+  switch (Desc.type) {
+  case UR_MEM_TYPE_IMAGE1D_ARRAY:
+    return getRowPitch();
+  case UR_MEM_TYPE_IMAGE2D_ARRAY:
+  case UR_MEM_TYPE_IMAGE3D:
+    return getRowPitch() * Extent[1];
+  default:
+    return 0;
+  }
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urMemImageCreate(
     ur_context_handle_t hContext, ur_mem_flags_t flags,
     const ur_image_format_t *pImageFormat, const ur_image_desc_t *pImageDesc,
-    void *pHost, ur_mem_handle_t *phMem) {
-  std::ignore = hContext;
-  std::ignore = flags;
-  std::ignore = pImageFormat;
-  std::ignore = pImageDesc;
-  std::ignore = pHost;
-  std::ignore = phMem;
-
-  DIE_NO_IMPLEMENTATION
+    void *pHost, ur_mem_handle_t *phMem) try {
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT((flags & UR_MEM_FLAGS_MASK) == 0,
+            UR_RESULT_ERROR_INVALID_ENUMERATION);
+  UR_ASSERT(pImageFormat && pImageDesc && phMem,
+            UR_RESULT_ERROR_INVALID_NULL_POINTER);
+
+  const bool HostPtrFlags =
+      flags &
+      (UR_MEM_FLAG_USE_HOST_POINTER | UR_MEM_FLAG_ALLOC_COPY_HOST_POINTER);
+  UR_ASSERT(HostPtrFlags == (pHost != nullptr),
+            UR_RESULT_ERROR_INVALID_HOST_PTR);
+
+  const ur_image_desc_t &Desc = *pImageDesc;
+  UR_ASSERT(Desc.stype == UR_STRUCTURE_TYPE_IMAGE_DESC,
+            UR_RESULT_ERROR_INVALID_IMAGE_FORMAT_DESCRIPTOR);
+  UR_ASSERT(Desc.type == UR_MEM_TYPE_IMAGE1D ||
+                Desc.type == UR_MEM_TYPE_IMAGE1D_ARRAY ||
+                Desc.type == UR_MEM_TYPE_IMAGE2D ||
+                Desc.type == UR_MEM_TYPE_IMAGE2D_ARRAY ||
+                Desc.type == UR_MEM_TYPE_IMAGE3D,
+            UR_RESULT_ERROR_INVALID_IMAGE_FORMAT_DESCRIPTOR);
+  UR_ASSERT(Desc.numMipLevel == 0 && Desc.numSamples == 0,
+            UR_RESULT_ERROR_INVALID_IMAGE_FORMAT_DESCRIPTOR);
+  UR_ASSERT(pHost || (Desc.rowPitch == 0 && Desc.slicePitch == 0),
+            UR_RESULT_ERROR_INVALID_IMAGE_FORMAT_DESCRIPTOR);
+
+  const size_t ElementSize = getElementSize(*pImageFormat);
+  UR_ASSERT(ElementSize, UR_RESULT_ERROR_UNSUPPORTED_IMAGE_FORMAT);
+
+  // Matches the limits reported in urDeviceGetInfo.
+  const bool Is3D = Desc.type == UR_MEM_TYPE_IMAGE3D;
+  const bool Is2D = Desc.type == UR_MEM_TYPE_IMAGE2D ||
+                    Desc.type == UR_MEM_TYPE_IMAGE2D_ARRAY;
+  const bool IsArray = Desc.type == UR_MEM_TYPE_IMAGE1D_ARRAY ||
+                       Desc.type == UR_MEM_TYPE_IMAGE2D_ARRAY;
+  const size_t MaxExtent = Is3D ? 2048 : 8192;
+  UR_ASSERT(Desc.width && Desc.width <= MaxExtent,
+            UR_RESULT_ERROR_INVALID_IMAGE_SIZE);
+  UR_ASSERT(!(Is2D || Is3D) || (Desc.height && Desc.height <= MaxExtent),
+            UR_RESULT_ERROR_INVALID_IMAGE_SIZE);
+  UR_ASSERT(!Is3D || (Desc.depth && Desc.depth <= MaxExtent),
+            UR_RESULT_ERROR_INVALID_IMAGE_SIZE);
+  UR_ASSERT(!IsArray || (Desc.arraySize && Desc.arraySize <= 2048),
+            UR_RESULT_ERROR_INVALID_IMAGE_SIZE);
+
+  *phMem = new _ur_image(hContext, *pImageFormat, Desc, ElementSize, flags,
+                         pHost);
+  return UR_RESULT_SUCCESS;
+} catch (...) {
+  return exceptionToResult(std::current_exception());
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urMemBufferCreate(
     ur_context_handle_t hContext, ur_mem_flags_t flags, size_t size,
-    const ur_buffer_properties_t *pProperties, ur_mem_handle_t *phBuffer) {
+    const ur_buffer_properties_t *pProperties, ur_mem_handle_t *phBuffer) try {
 
   // TODO: add proper error checking and double check flag semantics
   // TODO: support UR_MEM_FLAG_ALLOC_COPY_HOST_POINTER flag
@@ -51,21 +419,24 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemBufferCreate(
   ur_mem_handle_t_ *retMem;
 
   if (useHostPtr) {
-    retMem = new _ur_buffer(hContext, pProperties->pHost);
-  } else if (copyHostPtr) {
     retMem = new _ur_buffer(hContext, pProperties->pHost, size);
+  } else if (copyHostPtr) {
+    retMem = new _ur_buffer(hContext, size, pProperties->pHost);
   } else {
     retMem = new _ur_buffer(hContext, size);
   }
 
   *phBuffer = retMem;
   return UR_RESULT_SUCCESS;
+} catch (...) {
+  return exceptionToResult(std::current_exception());
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urMemRetain(ur_mem_handle_t hMem) {
-  std::ignore = hMem;
+  UR_ASSERT(hMem, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
 
-  DIE_NO_IMPLEMENTATION
+  hMem->_refCount++;
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urMemRelease(ur_mem_handle_t hMem) {
@@ -111,13 +482,17 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemBufferPartition(
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urMemGetNativeHandle(ur_mem_handle_t hMem, ur_device_handle_t hDevice,
+urMemGetNativeHandle(ur_mem_handle_t hMem, ur_device_handle_t,
                      ur_native_handle_t *phNativeMem) {
-  std::ignore = hMem;
-  std::ignore = hDevice;
-  std::ignore = phNativeMem;
+  UR_ASSERT(hMem, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(phNativeMem, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
-  DIE_NO_IMPLEMENTATION
+  // The native handle of a buffer is the host memory backing it. Images have
+  // none, as nothing outside the adapter knows the layout of their tiles.
+  if (hMem->isImage())
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  *phNativeMem = reinterpret_cast<ur_native_handle_t>(hMem->_mem);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urMemBufferCreateWithNativeHandle(
@@ -150,13 +525,19 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemGetInfo(ur_mem_handle_t hMemory,
                                                  size_t propSize,
                                                  void *pPropValue,
                                                  size_t *pPropSizeRet) {
-  std::ignore = hMemory;
-  std::ignore = propName;
-  std::ignore = propSize;
-  std::ignore = pPropValue;
-  std::ignore = pPropSizeRet;
-
-  DIE_NO_IMPLEMENTATION
+  UR_ASSERT(hMemory, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+  switch (propName) {
+  case UR_MEM_INFO_SIZE:
+    return ReturnValue(hMemory->Size);
+  case UR_MEM_INFO_CONTEXT:
+    return ReturnValue(hMemory->Context);
+  case UR_MEM_INFO_REFERENCE_COUNT:
+    return ReturnValue(hMemory->_refCount.load());
+  default:
+    return UR_RESULT_ERROR_INVALID_ENUMERATION;
+  }
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urMemImageGetInfo(ur_mem_handle_t hMemory,
@@ -164,11 +545,33 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemImageGetInfo(ur_mem_handle_t hMemory,
                                                       size_t propSize,
                                                       void *pPropValue,
                                                       size_t *pPropSizeRet) {
-  std::ignore = hMemory;
-  std::ignore = propName;
-  std::ignore = propSize;
-  std::ignore = pPropValue;
-  std::ignore = pPropSizeRet;
-
-  DIE_NO_IMPLEMENTATION
+  UR_ASSERT(hMemory, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(hMemory->isImage(), UR_RESULT_ERROR_INVALID_MEM_OBJECT);
+
+  const auto *Image = static_cast<const _ur_image *>(hMemory);
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+  switch (propName) {
+  case UR_IMAGE_INFO_FORMAT:
+    return ReturnValue(Image->Format);
+  case UR_IMAGE_INFO_ELEMENT_SIZE:
+    return ReturnValue(Image->ElementSize);
+  case UR_IMAGE_INFO_ROW_PITCH:
+    return ReturnValue(Image->getRowPitch());
+  case UR_IMAGE_INFO_SLICE_PITCH:
+    return ReturnValue(Image->getSlicePitch());
+  case UR_IMAGE_INFO_WIDTH:
+    return ReturnValue(Image->Desc.width);
+  case UR_IMAGE_INFO_HEIGHT:
+    return ReturnValue(Image->Desc.height);
+  case UR_IMAGE_INFO_DEPTH:
+    return ReturnValue(Image->Desc.depth);
+  case UR_IMAGE_INFO_ARRAY_SIZE:
+    return ReturnValue(Image->Desc.arraySize);
+  case UR_IMAGE_INFO_NUM_MIP_LEVELS:
+    return ReturnValue(Image->Desc.numMipLevel);
+  case UR_IMAGE_INFO_NUM_SAMPLES:
+    return ReturnValue(Image->Desc.numSamples);
+  default:
+    return UR_RESULT_ERROR_INVALID_ENUMERATION;
+  }
 }
@@ -13,28 +13,52 @@
 #include <atomic>
 #include <cstdlib>
 #include <cstring>
+#include <ur_api.h>
 
 #include "common.hpp"
 #include "context.hpp"
+#include "nativecpu_state.hpp"
+
+namespace native_cpu {
+
+// Memory owned by a buffer. It is mapped if MappedSize isn't zero, and
+// allocated with malloc otherwise.
+struct buffer_mem_t {
+  char *Ptr;
+  size_t MappedSize;
+};
+
+// Allocates Size bytes for a buffer of Context and copies HostPtr into them
+// unless it is null. Buffers of UR_NATIVE_CPU_BUFFER_FIRST_TOUCH_THRESHOLD
+// bytes or more (1 MiB by default, 0 disables this) are copied or touched by
+// the workers that are idle, each in the slice of the buffer it would process
+// in a 1D kernel over it, and by the calling thread for the others. On Linux,
+// those of sub-devices, whose workers are pinned, are mapped so that their
+// pages end up on the NUMA nodes of the workers using them. With
+// UR_NATIVE_CPU_BUFFER_INTERLEAVE set the pages of these buffers, and of those
+// of the root device, are interleaved across the NUMA nodes of the device
+// instead. Throws UR_RESULT_ERROR_OUT_OF_HOST_MEMORY on failure.
+buffer_mem_t alloc_buffer_mem(ur_context_handle_t Context, size_t Size,
+                              const void *HostPtr);
+
+void free_buffer_mem(const buffer_mem_t &Mem);
+
+} // namespace native_cpu
 
 struct ur_mem_handle_t_ : _ur_object {
-  ur_mem_handle_t_(size_t Size, bool _IsImage)
-      : _mem{static_cast<char *>(malloc(Size))}, _ownsMem{true},
-        IsImage{_IsImage} {}
-
-  ur_mem_handle_t_(void *HostPtr, size_t Size, bool _IsImage)
-      : _mem{static_cast<char *>(malloc(Size))}, _ownsMem{true},
-        IsImage{_IsImage} {
-    memcpy(_mem, HostPtr, Size);
-  }
+  ur_mem_handle_t_(ur_context_handle_t Context, size_t Size,
+                   native_cpu::buffer_mem_t Mem, bool _IsImage)
+      : Context{Context}, Size{Size}, _mem{Mem.Ptr}, _ownsMem{true},
+        _mappedSize{Mem.MappedSize}, IsImage{_IsImage} {}
 
-  ur_mem_handle_t_(void *HostPtr, bool _IsImage)
-      : _mem{static_cast<char *>(HostPtr)}, _ownsMem{false}, IsImage{_IsImage} {
-  }
+  ur_mem_handle_t_(ur_context_handle_t Context, size_t Size, void *HostPtr,
+                   bool _IsImage)
+      : Context{Context}, Size{Size}, _mem{static_cast<char *>(HostPtr)},
+        _ownsMem{false}, IsImage{_IsImage} {}
 
-  ~ur_mem_handle_t_() {
+  virtual ~ur_mem_handle_t_() {
     if (_ownsMem) {
-      free(_mem);
+      native_cpu::free_buffer_mem({_mem, _mappedSize});
     }
   }
 
@@ -43,8 +67,13 @@ struct ur_mem_handle_t_ : _ur_object {
   // Method to get type of the derived object (image or buffer)
   bool isImage() const { return this->IsImage; }
 
+  const ur_context_handle_t Context;
+  // The size reported to the user, which doesn't include the padding of the
+  // tiles of images.
+  size_t Size;
   char *_mem;
   bool _ownsMem;
+  size_t _mappedSize = 0;
   std::atomic_uint32_t _refCount = {1};
 
 private:
@@ -52,16 +81,18 @@ private:
 };
 
 struct _ur_buffer final : ur_mem_handle_t_ {
-  // Buffer constructor
-  _ur_buffer(ur_context_handle_t /* Context*/, void *HostPtr)
-      : ur_mem_handle_t_(HostPtr, false) {}
-  _ur_buffer(ur_context_handle_t /* Context*/, void *HostPtr, size_t Size)
-      : ur_mem_handle_t_(HostPtr, Size, false) {}
-  _ur_buffer(ur_context_handle_t /* Context*/, size_t Size)
-      : ur_mem_handle_t_(Size, false) {}
+  // Aliases the host memory.
+  _ur_buffer(ur_context_handle_t Context, void *HostPtr, size_t Size)
+      : ur_mem_handle_t_(Context, Size, HostPtr, false) {}
+  // Allocates memory of its own, and copies HostPtr into it unless it is null.
+  _ur_buffer(ur_context_handle_t Context, size_t Size,
+             const void *HostPtr = nullptr)
+      : ur_mem_handle_t_(Context, Size,
+                         native_cpu::alloc_buffer_mem(Context, Size, HostPtr),
+                         false) {}
   _ur_buffer(_ur_buffer *b, size_t Offset, size_t Size)
-      : ur_mem_handle_t_(b->_mem + Offset, false), SubBuffer(b) {
-    std::ignore = Size;
+      : ur_mem_handle_t_(b->Context, Size, b->_mem + Offset, false),
+        SubBuffer(b) {
     SubBuffer.Origin = Offset;
   }
 
@@ -74,3 +105,75 @@ struct _ur_buffer final : ur_mem_handle_t_ {
     size_t Origin; // only valid if Parent != nullptr
   } SubBuffer;
 };
+
+// Images keep their texels in tiles of TileWidth x TileHeight x TileDepth,
+// stored one after the other in row-major order and with the texels of a
+// tile in row-major order too. A row of a tile spans a cache line, so texels
+// that are close in any dimension are also close in memory, which is what
+// sampling and 2D and 3D stencils access.
+//
+// Images created with UR_MEM_FLAG_USE_HOST_POINTER alias the host memory and
+// keep its linear layout instead.
+struct _ur_image final : ur_mem_handle_t_ {
+  // HostPtr is either null, or the memory to alias or copy from depending on
+  // the flags.
+  _ur_image(ur_context_handle_t Context, const ur_image_format_t &Format,
+            const ur_image_desc_t &Desc, size_t ElementSize,
+            ur_mem_flags_t Flags, void *HostPtr);
+  ~_ur_image();
+
+  // Returns the address of the texel at (X, Y, Z), where Y is the layer of 1D
+  // image arrays and Z the layer of 2D image arrays. Run is set to the number
+  // of texels from there on along the row that are contiguous in memory.
+  char *texel(size_t X, size_t Y, size_t Z, size_t &Run) const {
+    if (!Tiled) {
+      Run = Extent[0] - X;
+      return _mem + Z * Pitch[2] + Y * Pitch[1] + X * ElementSize;
+    }
+    const size_t InX = X & (TileWidth - 1);
+    const size_t InY = Y & (TileHeight - 1);
+    const size_t InZ = Z & (TileDepth - 1);
+    const size_t Tile = (Z / TileDepth) * TilesPerSlice +
+                        (Y / TileHeight) * TilesPerRow + X / TileWidth;
+    Run = TileWidth - InX;
+    return _mem +
+           (Tile * TileTexels + (InZ * TileHeight + InY) * TileWidth + InX) *
+               ElementSize;
+  }
+
+  char *texel(size_t X, size_t Y, size_t Z) const {
+    size_t Run;
+    return texel(X, Y, Z, Run);
+  }
+
+  // Pitches reported to the user, which are those of a linear image unless
+  // the image aliases host memory.
+  size_t getRowPitch() const {
+    return Tiled ? Extent[0] * ElementSize : Pitch[1];
+  }
+  size_t getSlicePitch() const;
+
+  const ur_image_format_t Format;
+  const ur_image_desc_t Desc;
+  const size_t ElementSize;
+  // Converts the texel at Ptr to floats in RGBA order, picked for the format
+  // when the image is created.
+  void (*const LoadTexel)(const _ur_image &Image, const char *Ptr,
+                          float Texel[4]);
+  // Width, height and depth of the image, counting array layers as the
+  // dimension following the last one of the image.
+  size_t Extent[3];
+  // What kernels are given for the image.
+  native_cpu::image_t KernelArg;
+
+private:
+  bool Tiled;
+  size_t TileWidth = 1;
+  size_t TileHeight = 1;
+  size_t TileDepth = 1;
+  size_t TileTexels = 1;
+  size_t TilesPerRow = 0;
+  size_t TilesPerSlice = 0;
+  // Byte strides between rows and slices of linear images.
+  size_t Pitch[3] = {};
+};
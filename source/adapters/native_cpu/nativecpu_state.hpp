@@ -8,6 +8,7 @@
 //
 //===----------------------------------------------------------------------===//
 #pragma once
+#include <cstdint>
 #include <cstdlib>
 namespace native_cpu {
 
@@ -65,4 +66,45 @@ struct state {
   }
 };
 
+// Image and sampler kernel arguments are passed as pointers to these
+// descriptors, which outlive the kernel launches using them. Kernels access
+// texels through the functions they point to rather than through the storage
+// of the image, which may be tiled.
+struct image_t {
+  // Returns the address of the texel at (X, Y, Z), where Y is the layer of 1D
+  // image arrays and Z the layer of 2D image arrays.
+  char *(*Texel)(const image_t *Image, size_t X, size_t Y, size_t Z);
+  // Reads the texel at (X, Y, Z) converted to floats in RGBA order.
+  void (*Read)(const image_t *Image, size_t X, size_t Y, size_t Z,
+               float Texel[4]);
+  // A ur_image_channel_order_t and a ur_image_channel_type_t.
+  uint32_t ChannelOrder;
+  uint32_t ChannelType;
+  size_t ElementSize;
+  // Width, height and depth, counting array layers as the dimension following
+  // the last one of the image.
+  size_t Extent[3];
+  // The adapter's image object.
+  const void *Impl;
+};
+
+struct sampler_t {
+  // Samples Image at Coords, which holds as many coordinates as the image has
+  // dimensions followed by the layer for image arrays, and writes the texel
+  // converted to floats in RGBA order to Texel.
+  void (*Sample)(const sampler_t *Sampler, const image_t *Image,
+                 const float *Coords, float Texel[4]);
+  // The adapter's sampler object.
+  const void *Impl;
+};
+
 } // namespace native_cpu
+
+// The nativecpu_entry struct is also defined as LLVM-IR in the
+// clang-offload-wrapper tool. The two definitions need to match,
+// therefore any change to this struct needs to be reflected in the
+// offload-wrapper.
+struct nativecpu_entry {
+  const char *kernelname;
+  const unsigned char *kernel_ptr;
+};
@@ -12,24 +12,94 @@
 #include "common.hpp"
 #include "context.hpp"
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+ur_physical_mem_handle_t_::~ur_physical_mem_handle_t_() {
+#ifdef __linux__
+  close(fd);
+#endif
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urPhysicalMemCreate(
-    ur_context_handle_t, ur_device_handle_t, size_t,
-    const ur_physical_mem_properties_t *, ur_physical_mem_handle_t *) {
+    ur_context_handle_t hContext, ur_device_handle_t hDevice, size_t size,
+    const ur_physical_mem_properties_t *pProperties,
+    ur_physical_mem_handle_t *phPhysicalMem) {
+#ifdef __linux__
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(phPhysicalMem, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(!pProperties || !(pProperties->flags & UR_PHYSICAL_MEM_FLAGS_MASK),
+            UR_RESULT_ERROR_INVALID_ENUMERATION);
+  UR_ASSERT(size != 0 && size % native_cpu::get_page_size() == 0,
+            UR_RESULT_ERROR_INVALID_SIZE);
+
+  int fd = memfd_create("ur_native_cpu_physical_mem", MFD_CLOEXEC);
+  if (fd < 0)
+    return UR_RESULT_ERROR_OUT_OF_RESOURCES;
+  // The file is sparse, its pages are only allocated when first touched
+  // through a mapping.
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    close(fd);
+    return UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  ur_physical_mem_properties_t properties{
+      UR_STRUCTURE_TYPE_PHYSICAL_MEM_PROPERTIES, nullptr, 0};
+  if (pProperties)
+    properties = *pProperties;
+  try {
+    *phPhysicalMem = new ur_physical_mem_handle_t_(fd, hContext, hDevice, size,
+                                                   properties);
+  } catch (...) {
+    close(fd);
+    return UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  return UR_RESULT_SUCCESS;
+#else
+  std::ignore = hContext;
+  std::ignore = hDevice;
+  std::ignore = size;
+  std::ignore = pProperties;
+  std::ignore = phPhysicalMem;
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+#endif
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urPhysicalMemRetain(ur_physical_mem_handle_t) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+urPhysicalMemRetain(ur_physical_mem_handle_t hPhysicalMem) {
+  UR_ASSERT(hPhysicalMem, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  hPhysicalMem->incrementReferenceCount();
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urPhysicalMemRelease(ur_physical_mem_handle_t) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+urPhysicalMemRelease(ur_physical_mem_handle_t hPhysicalMem) {
+  UR_ASSERT(hPhysicalMem, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  decrementOrDelete(hPhysicalMem);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urPhysicalMemGetInfo(ur_physical_mem_handle_t, ur_physical_mem_info_t, size_t,
-                     void *, size_t *) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+urPhysicalMemGetInfo(ur_physical_mem_handle_t hPhysicalMem,
+                     ur_physical_mem_info_t propName, size_t propSize,
+                     void *pPropValue, size_t *pPropSizeRet) {
+  UR_ASSERT(hPhysicalMem, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+  switch (propName) {
+  case UR_PHYSICAL_MEM_INFO_CONTEXT:
+    return ReturnValue(hPhysicalMem->getContext());
+  case UR_PHYSICAL_MEM_INFO_DEVICE:
+    return ReturnValue(hPhysicalMem->getDevice());
+  case UR_PHYSICAL_MEM_INFO_SIZE:
+    return ReturnValue(hPhysicalMem->getSize());
+  case UR_PHYSICAL_MEM_INFO_PROPERTIES:
+    return ReturnValue(hPhysicalMem->getProperties());
+  case UR_PHYSICAL_MEM_INFO_REFERENCE_COUNT:
+    return ReturnValue(hPhysicalMem->getReferenceCount());
+  default:
+    return UR_RESULT_ERROR_INVALID_ENUMERATION;
+  }
 }
@@ -9,8 +9,39 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
-/// UR queue mapping on physical memory allocations used in virtual memory
-/// management.
-/// TODO: Implement.
+#include "common.hpp"
+
+/// Physical memory used in virtual memory management. It is backed by an
+/// anonymous in-memory file, so that any range of it can be mapped into any
+/// number of reserved virtual ranges with mmap.
 ///
-struct ur_physical_mem_handle_t_ {};
+struct ur_physical_mem_handle_t_ : RefCounted {
+  ur_physical_mem_handle_t_(int fd, ur_context_handle_t context,
+                            ur_device_handle_t device, size_t size,
+                            ur_physical_mem_properties_t properties)
+      : fd(fd), context(context), device(device), size(size),
+        properties(properties) {}
+
+  ~ur_physical_mem_handle_t_();
+
+  int getFd() const noexcept { return fd; }
+
+  ur_context_handle_t getContext() const noexcept { return context; }
+
+  ur_device_handle_t getDevice() const noexcept { return device; }
+
+  size_t getSize() const noexcept { return size; }
+
+  ur_physical_mem_properties_t getProperties() const noexcept {
+    return properties;
+  }
+
+private:
+  // Mappings of the file keep its memory alive after the descriptor is
+  // closed, so the handle may be released while it is still mapped.
+  int fd;
+  ur_context_handle_t context;
+  ur_device_handle_t device;
+  size_t size;
+  ur_physical_mem_properties_t properties;
+};
@@ -0,0 +1,252 @@
+//===----------- pipe.hpp - Native CPU Adapter ----------------------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace native_cpu {
+
+// Host pipes are never given more than this many bytes.
+constexpr size_t MaxHostPipeCapacity = size_t{1} << 30;
+
+// Returns the default capacity in bytes of host pipes, selected through the
+// UR_NATIVE_CPU_HOST_PIPE_CAPACITY environment variable.
+size_t getHostPipeCapacity();
+
+class host_pipe_t;
+
+// Returns the pipe kernels reach through the pointer-sized device global at
+// Addr, creating it and pointing the global at it if there is none. Every
+// program created from the same binary shares its device globals, so they
+// share its pipes too. The global is cleared once the last program using the
+// pipe releases it.
+std::shared_ptr<host_pipe_t> acquireHostPipe(void *Addr, size_t MinCapacity);
+
+// A bounded ring buffer connecting producers and consumers. Each side owns
+// one of the indices and only reads the other one, so a producer and a
+// consumer never wait for each other and a transfer costs a copy and a pair of
+// atomic operations. Producers are serialized by a lock of their own, and so
+// are consumers, since host threads, queues and kernels may all use the same
+// pipe. A transfer moves all its bytes at once: a reader never sees part of a
+// record.
+//
+// Transfers the pipe isn't ready for can be queued instead of waited for. A
+// queued transfer is made by whichever thread makes room or data for it, so
+// it doesn't need a thread of its own, and it is made before any transfer in
+// the same direction that comes after it.
+//
+// The indices grow without bound and are reduced modulo the capacity, which
+// is a power of two, when the buffer is accessed.
+class host_pipe_t {
+public:
+  // Called once a queued transfer has been made, with no lock held.
+  using done_fn_t = std::function<void()>;
+
+  explicit host_pipe_t(size_t MinCapacity)
+      : Capacity(roundUpCapacity(MinCapacity)), Buffer(new char[Capacity]) {}
+
+  size_t getCapacity() const { return Capacity; }
+
+  // Returns false if there isn't room for Size bytes, or if writes are queued.
+  bool tryWrite(const void *Src, size_t Size) {
+    {
+      std::lock_guard<std::mutex> Lock(Write.Mutex);
+      if (!Write.Queued.empty() ||
+          !tryWriteLocked(static_cast<const char *>(Src), Size)) {
+        return false;
+      }
+    }
+    makeQueuedTransfers();
+    return true;
+  }
+
+  // Returns false if fewer than Size bytes have been written, or if reads are
+  // queued.
+  bool tryRead(void *Dst, size_t Size) {
+    {
+      std::lock_guard<std::mutex> Lock(Read.Mutex);
+      if (!Read.Queued.empty() ||
+          !tryReadLocked(static_cast<char *>(Dst), Size)) {
+        return false;
+      }
+    }
+    makeQueuedTransfers();
+    return true;
+  }
+
+  // Wait until the transfer can be made. Size must not exceed the capacity.
+  void write(const void *Src, size_t Size) {
+    while (!tryWrite(Src, Size)) {
+      std::this_thread::yield();
+    }
+  }
+
+  void read(void *Dst, size_t Size) {
+    while (!tryRead(Dst, Size)) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Make the transfer now if the pipe is ready for it, otherwise queue it.
+  // Src or Dst must stay valid until Done has been called.
+  void write(const void *Src, size_t Size, done_fn_t &&Done) {
+    queue(Write, const_cast<void *>(Src), Size, std::move(Done));
+  }
+
+  void read(void *Dst, size_t Size, done_fn_t &&Done) {
+    queue(Read, Dst, Size, std::move(Done));
+  }
+
+private:
+  struct transfer_t {
+    void *Ptr;
+    size_t Size;
+    done_fn_t Done;
+  };
+
+  // The transfers queued in one direction. The count of the queued transfers
+  // saves taking the lock of a direction with none.
+  struct side_t {
+    std::mutex Mutex;
+    std::deque<transfer_t> Queued;
+    std::atomic<size_t> NumQueued{0};
+  };
+
+  static size_t roundUpCapacity(size_t MinCapacity) {
+    size_t Result = 64;
+    while (Result < std::min(MinCapacity, MaxHostPipeCapacity)) {
+      Result *= 2;
+    }
+    return Result;
+  }
+
+  bool tryWriteLocked(const char *Src, size_t Size) {
+    const size_t Tail = WriteIndex.load(std::memory_order_relaxed);
+    if (Capacity - (Tail - CachedReadIndex) < Size) {
+      CachedReadIndex = ReadIndex.load(std::memory_order_acquire);
+      if (Capacity - (Tail - CachedReadIndex) < Size) {
+        return false;
+      }
+    }
+    copyIn(Tail, Src, Size);
+    WriteIndex.store(Tail + Size, std::memory_order_release);
+    return true;
+  }
+
+  bool tryReadLocked(char *Dst, size_t Size) {
+    const size_t Head = ReadIndex.load(std::memory_order_relaxed);
+    if (CachedWriteIndex - Head < Size) {
+      CachedWriteIndex = WriteIndex.load(std::memory_order_acquire);
+      if (CachedWriteIndex - Head < Size) {
+        return false;
+      }
+    }
+    copyOut(Head, Dst, Size);
+    ReadIndex.store(Head + Size, std::memory_order_release);
+    return true;
+  }
+
+  bool tryTransferLocked(side_t &Side, const transfer_t &Transfer) {
+    if (&Side == &Read)
+      return tryReadLocked(static_cast<char *>(Transfer.Ptr), Transfer.Size);
+    return tryWriteLocked(static_cast<const char *>(Transfer.Ptr),
+                          Transfer.Size);
+  }
+
+  void queue(side_t &Side, void *Ptr, size_t Size, done_fn_t &&Done) {
+    {
+      std::lock_guard<std::mutex> Lock(Side.Mutex);
+      // Counted before trying, so that a thread on the other side that made
+      // room or data after this attempt sees it queued, see
+      // makeQueuedTransfers.
+      Side.NumQueued.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      transfer_t Transfer{Ptr, Size, std::move(Done)};
+      if (!Side.Queued.empty() || !tryTransferLocked(Side, Transfer)) {
+        Side.Queued.push_back(std::move(Transfer));
+        return;
+      }
+      Side.NumQueued.fetch_sub(1);
+      Done = std::move(Transfer.Done);
+    }
+    makeQueuedTransfers();
+    Done();
+  }
+
+  // Makes the queued transfers the pipe is ready for. Each one may make room
+  // or data for the other direction, so keep going until neither progresses.
+  void makeQueuedTransfers() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (Read.NumQueued.load(std::memory_order_relaxed) == 0 &&
+        Write.NumQueued.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    std::vector<done_fn_t> Done;
+    for (bool Progress = true; Progress;) {
+      Progress = false;
+      for (side_t *Side : {&Read, &Write}) {
+        std::lock_guard<std::mutex> Lock(Side->Mutex);
+        while (!Side->Queued.empty() &&
+               tryTransferLocked(*Side, Side->Queued.front())) {
+          Done.push_back(std::move(Side->Queued.front().Done));
+          Side->Queued.pop_front();
+          Side->NumQueued.fetch_sub(1, std::memory_order_relaxed);
+          Progress = true;
+        }
+      }
+    }
+    // The pipe may be destroyed by the last of these.
+    for (auto &D : Done) {
+      D();
+    }
+  }
+
+  void copyIn(size_t Index, const char *Src, size_t Size) {
+    const size_t Offset = Index & (Capacity - 1);
+    const size_t First = std::min(Size, Capacity - Offset);
+    std::memcpy(Buffer.get() + Offset, Src, First);
+    std::memcpy(Buffer.get(), Src + First, Size - First);
+  }
+
+  void copyOut(size_t Index, char *Dst, size_t Size) const {
+    const size_t Offset = Index & (Capacity - 1);
+    const size_t First = std::min(Size, Capacity - Offset);
+    std::memcpy(Dst, Buffer.get() + Offset, First);
+    std::memcpy(Dst + First, Buffer.get(), Size - First);
+  }
+
+  const size_t Capacity;
+  const std::unique_ptr<char[]> Buffer;
+
+  // The consumers' side. CachedWriteIndex saves reading the producers' index
+  // while there is data left from the previous read. Guarded by Read.Mutex,
+  // like CachedReadIndex is by Write.Mutex.
+  alignas(64) std::atomic<size_t> ReadIndex{0};
+  size_t CachedWriteIndex = 0;
+  side_t Read;
+
+  // The producers' side, on its own cache line so the two sides don't
+  // invalidate each other's lines on every transfer.
+  alignas(64) std::atomic<size_t> WriteIndex{0};
+  size_t CachedReadIndex = 0;
+  side_t Write;
+};
+
+} // namespace native_cpu
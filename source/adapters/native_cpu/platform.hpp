@@ -14,7 +14,10 @@
 
 #include "common.hpp"
 #include "device.hpp"
+#include "topology.hpp"
 
 struct ur_platform_handle_t_ {
+  // Must be initialized before the device, which is placed according to it.
+  native_cpu::topology Topology;
   ur_device_handle_t_ TheDevice{this};
 };
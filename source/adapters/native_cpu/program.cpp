@@ -13,8 +13,181 @@
 #include "common.hpp"
 #include "common/ur_util.hpp"
 #include "program.hpp"
+#include "ur_lib_loader.hpp"
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+size_t native_cpu::getHostPipeCapacity() {
+  if (const char *Capacity = std::getenv("UR_NATIVE_CPU_HOST_PIPE_CAPACITY")) {
+    return std::min<size_t>(std::strtoull(Capacity, nullptr, 0),
+                            MaxHostPipeCapacity);
+  }
+  return size_t{64} << 10;
+}
+
+namespace {
+// The pipes of all the programs, keyed by the device global they are
+// reached through. Guarded by HostPipesMutex.
+std::mutex HostPipesMutex;
+std::unordered_map<void *, std::weak_ptr<native_cpu::host_pipe_t>> HostPipes;
+} // namespace
+
+std::shared_ptr<native_cpu::host_pipe_t>
+native_cpu::acquireHostPipe(void *Addr, size_t MinCapacity) {
+  std::lock_guard<std::mutex> Lock(HostPipesMutex);
+  auto &Entry = HostPipes[Addr];
+  if (auto Pipe = Entry.lock())
+    return Pipe;
+
+  auto **Global = static_cast<host_pipe_t **>(Addr);
+  std::shared_ptr<host_pipe_t> Pipe(
+      new host_pipe_t(MinCapacity), [Global](host_pipe_t *Pipe) {
+        {
+          std::lock_guard<std::mutex> Lock(HostPipesMutex);
+          // Another program may have created a new pipe for the global since
+          // the last reference to this one was dropped.
+          if (*Global == Pipe) {
+            *Global = nullptr;
+            HostPipes.erase(Global);
+          }
+        }
+        delete Pipe;
+      });
+  Entry = Pipe;
+  *Global = Pipe.get();
+  return Pipe;
+}
+
+native_cpu::kernel_descriptor_t::~kernel_descriptor_t() {
+  const auto Stats = launchPlans.getStats();
+  if (Stats.Hits || Stats.Misses) {
+    logger::debug("native_cpu: launch plan cache of {}: {} hits, {} misses",
+                  name, Stats.Hits, Stats.Misses);
+  }
+}
+
+native_cpu::kernel_descriptor_ptr_t
+ur_program_handle_t_::makeKernelDescriptor(const char *name,
+                                           nativecpu_ptr_t entry) const {
+  auto Desc = std::make_shared<native_cpu::kernel_descriptor_t>(name, entry);
+  if (auto It = _kernelReqdWorkGroupSizeMD.find(Desc->name);
+      It != _kernelReqdWorkGroupSizeMD.end())
+    Desc->reqdWGSize = It->second;
+  if (auto It = _kernelMaxWorkGroupSizeMD.find(Desc->name);
+      It != _kernelMaxWorkGroupSizeMD.end())
+    Desc->maxWGSize = It->second;
+  if (auto It = _kernelMaxLinearWorkGroupSizeMD.find(Desc->name);
+      It != _kernelMaxLinearWorkGroupSizeMD.end())
+    Desc->maxLinearWGSize = It->second;
+  Desc->library = _library;
+  return Desc;
+}
+
+static void *getSymbol(const std::shared_ptr<void> &Library,
+                       const char *Name) {
+  return ur_loader::LibLoader::getFunctionPtr(
+      static_cast<HMODULE>(Library.get()), Name);
+}
+
+native_cpu::kernel_descriptor_ptr_t
+ur_program_handle_t_::getKernel(const char *name) {
+  // The kernels of programs built in the process are all known from their
+  // creation, and never change afterwards.
+  if (!_library) {
+    auto It = _kernels.find(name);
+    return It == _kernels.end() ? nullptr : It->second;
+  }
+  std::lock_guard<std::mutex> Lock(_kernelsMutex);
+  if (auto It = _kernels.find(name); It != _kernels.end())
+    return It->second;
+
+  auto *Entry = reinterpret_cast<nativecpu_ptr_t>(getSymbol(_library, name));
+  if (!Entry)
+    return nullptr;
+  auto Desc = makeKernelDescriptor(name, Entry);
+  std::string_view Name = Desc->name;
+  _kernels.emplace(Name, Desc);
+  return Desc;
+}
+
+static void addDeviceGlobals(ur_program_handle_t_ &Program,
+                             const nativecpu_device_global_entry *Global) {
+  for (; Global->name != nullptr; Global++) {
+    Program._deviceGlobals.emplace(
+        Global->name, native_cpu::device_global_t{
+                          Global->addr, static_cast<size_t>(Global->size)});
+  }
+}
+
+static void addHostPipes(ur_program_handle_t_ &Program,
+                         const nativecpu_host_pipe_entry *Pipe) {
+  static const size_t DefaultCapacity = native_cpu::getHostPipeCapacity();
+  for (; Pipe->name != nullptr; Pipe++) {
+    auto &HostPipe = Program._hostPipes[Pipe->name];
+    if (HostPipe)
+      continue;
+    HostPipe = native_cpu::acquireHostPipe(
+        Pipe->addr,
+        Pipe->size ? static_cast<size_t>(Pipe->size) : DefaultCapacity);
+  }
+}
+
+static bool isElfImage(const uint8_t *pBinary, size_t Length) {
+  return Length >= 4 && std::memcmp(pBinary, "\177ELF", 4) == 0;
+}
+
+static bool isSharedObject(const uint8_t *pBinary, size_t Length) {
+  const auto &Prefix = NativeCPUSharedObjectPathPrefix;
+  return isElfImage(pBinary, Length) ||
+         (Length > Prefix.size() &&
+          std::memcmp(pBinary, Prefix.data(), Prefix.size()) == 0);
+}
+
+// Loads the shared object given as a program binary. Its image is written to
+// an anonymous in-memory file so that it can be loaded without touching the
+// file system.
+static ur_result_t loadSharedObject(const uint8_t *pBinary, size_t Length,
+                                    std::shared_ptr<void> &Library) {
+  std::string Path;
+  if (isElfImage(pBinary, Length)) {
+#ifdef __linux__
+    int Fd = memfd_create("nativecpu-program", MFD_CLOEXEC);
+    if (Fd < 0)
+      return UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+    for (size_t Written = 0; Written < Length;) {
+      ssize_t Res = write(Fd, pBinary + Written, Length - Written);
+      if (Res < 0) {
+        close(Fd);
+        return UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+      }
+      Written += Res;
+    }
+    Path = "/proc/self/fd/" + std::to_string(Fd);
+    Library = ur_loader::LibLoader::loadAdapterLibrary(Path.c_str());
+    // The loaded library keeps its own reference to the file.
+    close(Fd);
+#else
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+#endif
+  } else {
+    const char *Begin = reinterpret_cast<const char *>(pBinary) +
+                        NativeCPUSharedObjectPathPrefix.size();
+    const char *End = reinterpret_cast<const char *>(pBinary) + Length;
+    Path.assign(Begin, std::find(Begin, End, '\0'));
+    Library = ur_loader::LibLoader::loadAdapterLibrary(Path.c_str());
+  }
+  return Library ? UR_RESULT_SUCCESS : UR_RESULT_ERROR_INVALID_BINARY;
+}
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urProgramCreateWithIL(ur_context_handle_t hContext, const void *pIL,
@@ -63,8 +236,6 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramCreateWithBinary(
 
   auto hDevice = phDevices[0];
   auto pBinary = ppBinaries[0];
-  std::ignore = pLengths;
-  std::ignore = pProperties;
 
   UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
   UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -89,21 +260,58 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramCreateWithBinary(
         if (res != UR_RESULT_SUCCESS) {
           return res;
         }
-        (isReqd ? hProgram->KernelReqdWorkGroupSizeMD
-                : hProgram->KernelMaxWorkGroupSizeMD)[Prefix] =
+        (isReqd ? hProgram->_kernelReqdWorkGroupSizeMD
+                : hProgram->_kernelMaxWorkGroupSizeMD)[Prefix] =
             std::move(wgSizeProp);
       } else if (Tag ==
                  __SYCL_UR_PROGRAM_METADATA_TAG_MAX_LINEAR_WORK_GROUP_SIZE) {
-        hProgram->KernelMaxLinearWorkGroupSizeMD[Prefix] = mdNode.value.data64;
+        hProgram->_kernelMaxLinearWorkGroupSizeMD[Prefix] = mdNode.value.data64;
       }
     }
   }
 
+  const size_t Length = pLengths ? pLengths[0] : 0;
+  if (isSharedObject(pBinary, Length)) {
+    if (auto Result = loadSharedObject(pBinary, Length, hProgram->_library);
+        Result != UR_RESULT_SUCCESS)
+      return Result;
+    // Kernels are resolved when they are first created, only the symbol
+    // tables of the device globals and host pipes are read now.
+    if (auto *Globals =
+            static_cast<const nativecpu_device_global_entry *>(getSymbol(
+                hProgram->_library, NativeCPUDeviceGlobalsEntryName.data())))
+      addDeviceGlobals(*hProgram, Globals);
+    if (auto *Pipes = static_cast<const nativecpu_host_pipe_entry *>(
+            getSymbol(hProgram->_library, NativeCPUHostPipesEntryName.data())))
+      addHostPipes(*hProgram, Pipes);
+    *phProgram = hProgram.release();
+    return UR_RESULT_SUCCESS;
+  }
+
   const nativecpu_entry *nativecpu_it =
       reinterpret_cast<const nativecpu_entry *>(pBinary);
   while (nativecpu_it->kernel_ptr != nullptr) {
-    hProgram->_kernels.insert(
-        std::make_pair(nativecpu_it->kernelname, nativecpu_it->kernel_ptr));
+    if (nativecpu_it->kernelname == NativeCPUDeviceGlobalsEntryName) {
+      addDeviceGlobals(*hProgram,
+                       reinterpret_cast<const nativecpu_device_global_entry *>(
+                           nativecpu_it->kernel_ptr));
+      nativecpu_it++;
+      continue;
+    }
+    if (nativecpu_it->kernelname == NativeCPUHostPipesEntryName) {
+      addHostPipes(*hProgram,
+                   reinterpret_cast<const nativecpu_host_pipe_entry *>(
+                       nativecpu_it->kernel_ptr));
+      nativecpu_it++;
+      continue;
+    }
+    auto Desc = hProgram->makeKernelDescriptor(
+        nativecpu_it->kernelname,
+        reinterpret_cast<nativecpu_ptr_t>(
+            const_cast<unsigned char *>(nativecpu_it->kernel_ptr)));
+    // The first entry wins if a name appears more than once
+    std::string_view Name = Desc->name;
+    hProgram->_kernels.emplace(Name, std::move(Desc));
     nativecpu_it++;
   }
 
@@ -213,12 +421,17 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramGetGlobalVariablePointer(
     ur_device_handle_t, ur_program_handle_t hProgram,
     const char *pGlobalVariableName, size_t *pGlobalVariableSizeRet,
     void **ppGlobalVariablePointerRet) {
-  std::ignore = hProgram;
-  std::ignore = pGlobalVariableName;
-  std::ignore = pGlobalVariableSizeRet;
-  std::ignore = ppGlobalVariablePointerRet;
-
-  DIE_NO_IMPLEMENTATION
+  UR_ASSERT(hProgram, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pGlobalVariableName && ppGlobalVariablePointerRet,
+            UR_RESULT_ERROR_INVALID_NULL_POINTER);
+
+  auto *Global = hProgram->getDeviceGlobal(pGlobalVariableName);
+  if (!Global)
+    return UR_RESULT_ERROR_INVALID_VALUE;
+  if (pGlobalVariableSizeRet)
+    *pGlobalVariableSizeRet = Global->size;
+  *ppGlobalVariablePointerRet = Global->addr;
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
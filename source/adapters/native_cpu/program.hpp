@@ -13,13 +13,51 @@
 #include <ur_api.h>
 
 #include "context.hpp"
+#include "launch_plan.hpp"
+#include "nativecpu_state.hpp"
+#include "pipe.hpp"
 
 #include <array>
-#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using nativecpu_kernel_t = void(void *const *, native_cpu::state *);
+using nativecpu_ptr_t = nativecpu_kernel_t *;
 
 namespace native_cpu {
 using WGSize_t = std::array<uint32_t, 3>;
-}
+
+// Describes a kernel entry point of a program. Descriptors are built once when
+// the program is created, are never modified afterwards and are shared by all
+// the kernel handles created for the entry point.
+struct kernel_descriptor_t {
+  kernel_descriptor_t(std::string name, nativecpu_ptr_t entry)
+      : name(std::move(name)), entry(entry) {}
+  // Logs the lookups of the launch plan cache.
+  ~kernel_descriptor_t();
+
+  const std::string name;
+  const nativecpu_ptr_t entry;
+  // Keeps the shared object the entry point was resolved from loaded, if any.
+  std::shared_ptr<void> library;
+  std::optional<WGSize_t> reqdWGSize;
+  std::optional<WGSize_t> maxWGSize;
+  std::optional<uint64_t> maxLinearWGSize;
+  // The plans of the recent launches, shared by all the kernel handles.
+  mutable launch_plan_cache_t launchPlans;
+};
+
+using kernel_descriptor_ptr_t = std::shared_ptr<const kernel_descriptor_t>;
+
+struct device_global_t {
+  void *addr;
+  size_t size;
+};
+} // namespace native_cpu
 
 struct ur_program_handle_t_ : RefCounted {
   ur_program_handle_t_(ur_context_handle_t ctx, const unsigned char *pBinary)
@@ -27,27 +65,86 @@ struct ur_program_handle_t_ : RefCounted {
 
   uint32_t getReferenceCount() const noexcept { return _refCount; }
 
+  // Returns nullptr if the program has no such kernel. Kernels of programs
+  // loaded from a shared object are resolved on the first call for them.
+  native_cpu::kernel_descriptor_ptr_t getKernel(const char *name);
+
+  // Returns the descriptor of the given entry point, with the work-group size
+  // metadata supplied for it when the program was created.
+  native_cpu::kernel_descriptor_ptr_t
+  makeKernelDescriptor(const char *name, nativecpu_ptr_t entry) const;
+
+  const native_cpu::device_global_t *getDeviceGlobal(const char *name) const {
+    auto it = _deviceGlobals.find(name);
+    return it == _deviceGlobals.end() ? nullptr : &it->second;
+  }
+
+  // Returns nullptr if the program declares no host pipe with the given
+  // symbol name.
+  native_cpu::host_pipe_t *getHostPipe(const char *name) const {
+    auto it = _hostPipes.find(name);
+    return it == _hostPipes.end() ? nullptr : it->second.get();
+  }
+
   ur_context_handle_t _ctx;
   const unsigned char *_ptr;
-  struct _compare {
-    bool operator()(char const *a, char const *b) const {
-      return std::strcmp(a, b) < 0;
-    }
-  };
-
-  std::map<const char *, const unsigned char *, _compare> _kernels;
+  // The shared object the program was loaded from, null if its binary is an
+  // in-process nativecpu_entry table.
+  std::shared_ptr<void> _library;
   std::unordered_map<std::string, native_cpu::WGSize_t>
-      KernelReqdWorkGroupSizeMD;
+      _kernelReqdWorkGroupSizeMD;
   std::unordered_map<std::string, native_cpu::WGSize_t>
-      KernelMaxWorkGroupSizeMD;
-  std::unordered_map<std::string, uint64_t> KernelMaxLinearWorkGroupSizeMD;
+      _kernelMaxWorkGroupSizeMD;
+  std::unordered_map<std::string, uint64_t> _kernelMaxLinearWorkGroupSizeMD;
+  // Keyed by the name owned by the descriptor.
+  std::unordered_map<std::string_view, native_cpu::kernel_descriptor_ptr_t>
+      _kernels;
+  // Keyed by the name in the binary's symbol table, which outlives the
+  // program like the kernel entry points do.
+  std::unordered_map<std::string_view, native_cpu::device_global_t>
+      _deviceGlobals;
+  // Acquired when the program is created and shared with the other programs
+  // created from the same binary, see native_cpu::acquireHostPipe. Keyed like
+  // _deviceGlobals.
+  std::unordered_map<std::string_view, std::shared_ptr<native_cpu::host_pipe_t>>
+      _hostPipes;
+
+private:
+  // Guards _kernels of programs loaded from a shared object, to which kernels
+  // are added as they are resolved.
+  std::mutex _kernelsMutex;
 };
 
-// The nativecpu_entry struct is also defined as LLVM-IR in the
-// clang-offload-wrapper tool. The two definitions need to match,
-// therefore any change to this struct needs to be reflected in the
-// offload-wrapper.
-struct nativecpu_entry {
-  const char *kernelname;
-  const unsigned char *kernel_ptr;
+// Program binaries built in the process are tables of nativecpu_entry, see
+// nativecpu_state.hpp.
+
+// An entry named __nativecpu_device_globals doesn't describe a kernel, its
+// kernel_ptr points to the program's device global symbol table instead. The
+// table is an array of the entries below, terminated by one with a null name.
+// Like nativecpu_entry, this layout has to match the offload-wrapper.
+struct nativecpu_device_global_entry {
+  const char *name;
+  void *addr;
+  uint64_t size;
 };
+
+inline constexpr std::string_view NativeCPUDeviceGlobalsEntryName =
+    "__nativecpu_device_globals";
+
+// Likewise, an entry named __nativecpu_host_pipes points to the program's host
+// pipe symbol table, made of entries of the same layout. The addr of each
+// entry points to a pointer-sized device global, which the adapter sets to the
+// native_cpu::host_pipe_t of the pipe when the first program using it is
+// created, and through which kernels use the pipe. size is the minimum
+// capacity of the pipe in bytes, zero for the default one.
+using nativecpu_host_pipe_entry = nativecpu_device_global_entry;
+
+inline constexpr std::string_view NativeCPUHostPipesEntryName =
+    "__nativecpu_host_pipes";
+
+// A program binary may also be an ELF shared object, given either as its
+// image or as this prefix followed by its path. Each kernel is exported from
+// it as a function named after the kernel, and the device global and host pipe
+// symbol tables, if any, as arrays named __nativecpu_device_globals and
+// __nativecpu_host_pipes.
+inline constexpr std::string_view NativeCPUSharedObjectPathPrefix = "file://";
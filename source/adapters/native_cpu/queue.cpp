@@ -10,6 +10,11 @@
 
 #include "queue.hpp"
 #include "common.hpp"
+#include "device.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
 
 #include "ur/ur.hpp"
 #include "ur_api.h"
@@ -31,7 +36,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urQueueGetInfo(ur_queue_handle_t hQueue,
 UR_APIEXPORT ur_result_t UR_APICALL urQueueCreate(
     ur_context_handle_t hContext, ur_device_handle_t hDevice,
     const ur_queue_properties_t *pProperties, ur_queue_handle_t *phQueue) {
-  // TODO: UR_QUEUE_FLAG_PROFILING_ENABLE and other props
+  UR_ASSERT(!pProperties ||
+                (pProperties->flags & UR_QUEUE_FLAG_PRIORITY_HIGH) == 0 ||
+                (pProperties->flags & UR_QUEUE_FLAG_PRIORITY_LOW) == 0,
+            UR_RESULT_ERROR_INVALID_QUEUE_PROPERTIES);
 
   auto Queue = new ur_queue_handle_t_(hDevice, hContext, pProperties);
   *phQueue = Queue;
@@ -81,7 +89,169 @@ UR_APIEXPORT ur_result_t UR_APICALL urQueueFinish(ur_queue_handle_t hQueue) {
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urQueueFlush(ur_queue_handle_t hQueue) {
-  std::ignore = hQueue;
+  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  hQueue->flush();
+  return UR_RESULT_SUCCESS;
+}
 
-  DIE_NO_IMPLEMENTATION;
+void ur_queue_handle_t_::submit(native_cpu::command_t &&cmd) {
+  if (!batched) {
+    dispatch(&cmd, 1);
+    return;
+  }
+  // The recorded command keeps its event and dependencies alive until it has
+  // been dispatched.
+  if (cmd.event)
+    cmd.event->incrementReferenceCount();
+  for (auto ev : cmd.waitList)
+    ev->incrementReferenceCount();
+  std::lock_guard<std::mutex> lock(mutex);
+  deferred.push_back(std::move(cmd));
+}
+
+void ur_queue_handle_t_::flush() {
+  if (!batched)
+    return;
+  // Dispatching waits for the dependencies of the commands, which flushes
+  // their queues. Some events of this queue are never recorded as commands,
+  // such as non-blocking timestamps, and stay queued until they complete, so
+  // waiting for one of them comes back here. This thread is already
+  // dispatching everything that was recorded before them.
+  if (flushingThread.load(std::memory_order_relaxed) ==
+      std::this_thread::get_id())
+    return;
+  std::lock_guard<std::mutex> flushLock(flushMutex);
+  flushingThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+  struct clear_t {
+    std::atomic<std::thread::id> &thread;
+    ~clear_t() { thread.store(std::thread::id(), std::memory_order_relaxed); }
+  } clear{flushingThread};
+  std::vector<native_cpu::command_t> cmds;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    cmds.swap(deferred);
+  }
+  if (cmds.empty())
+    return;
+
+  dispatch(cmds.data(), cmds.size());
+
+  for (auto &cmd : cmds) {
+    if (cmd.event)
+      decrementOrDelete(cmd.event);
+    for (auto ev : cmd.waitList)
+      decrementOrDelete(ev);
+  }
+}
+
+namespace {
+
+// Schedules consecutive kernel launches that may run concurrently. Each
+// launch is a job of the threadpool, in the lane of the queue, which gives
+// concurrent launches disjoint shares of the workers. Scheduling them together
+// wakes each worker once for the whole batch.
+void launchKernels(native_cpu::threadpool_t &tp, native_cpu::priority_t lane,
+                   native_cpu::command_t *cmds, size_t numCmds) {
+  std::vector<native_cpu::job_ptr_t> jobs;
+  jobs.reserve(numCmds);
+  for (size_t i = 0; i < numCmds; i++) {
+    auto event = cmds[i].event;
+    // The command is handed over to the threadpool from here on, and
+    // whichever worker picks up a task first marks it as running.
+    event->tick_submit();
+    std::vector<native_cpu::worker_task_t> tasks;
+    tasks.reserve(cmds[i].tasks.size());
+    for (auto &task : cmds[i].tasks) {
+      event->add_pending_task();
+      tasks.emplace_back([event, task = std::move(task)](size_t threadId) {
+        event->tick_start();
+        task(threadId);
+        event->finish_task();
+      });
+    }
+    auto job = std::make_shared<native_cpu::job_t>(
+        std::move(tasks), cmds[i].work, lane, cmds[i].cooperative);
+    event->set_futures({job->future});
+    jobs.push_back(std::move(job));
+  }
+
+  tp.schedule_jobs(std::move(jobs));
+
+  for (size_t i = 0; i < numCmds; i++) {
+    // Drop the reference held on behalf of this thread, this ends the command
+    // if all the tasks have already completed.
+    cmds[i].event->finish_task();
+  }
+}
+
+// Executes consecutive copies as a single memmove of the combined range. The
+// ranges are contiguous and don't overlap, so this is equivalent to
+// performing them one after the other.
+void copy(native_cpu::command_t *cmds, size_t numCmds) {
+  size_t size = 0;
+  for (size_t i = 0; i < numCmds; i++) {
+    size += cmds[i].size;
+    if (cmds[i].event)
+      cmds[i].event->tick_start();
+  }
+  if (cmds[0].src != cmds[0].dst && size)
+    memmove(cmds[0].dst, cmds[0].src, size);
+  for (size_t i = 0; i < numCmds; i++) {
+    if (cmds[i].event)
+      cmds[i].event->tick_end();
+  }
+}
+
+bool canMergeCopy(const native_cpu::command_t &first,
+                  const native_cpu::command_t &last,
+                  const native_cpu::command_t &next) {
+  if (next.kind != native_cpu::command_t::kind_t::copy ||
+      !next.waitList.empty())
+    return false;
+  auto src = static_cast<const char *>(first.src);
+  auto dst = static_cast<char *>(first.dst);
+  auto lastEnd = static_cast<size_t>(static_cast<const char *>(last.src) -
+                                     src) +
+                 last.size;
+  if (next.src != src + lastEnd || next.dst != dst + lastEnd)
+    return false;
+  // Once merged, no copy may read what a previous one wrote.
+  auto size = lastEnd + next.size;
+  return src + size <= dst || dst + size <= src;
+}
+
+} // namespace
+
+void ur_queue_handle_t_::dispatch(native_cpu::command_t *cmds,
+                                  size_t numCmds) {
+  using kind_t = native_cpu::command_t::kind_t;
+  size_t i = 0;
+  while (i < numCmds) {
+    auto &cmd = cmds[i];
+    // Find the commands that can be merged with this one. Only the first
+    // command of a group may have dependencies.
+    size_t end = i + 1;
+    if (cmd.kind == kind_t::kernel_launch) {
+      // Commands of in-order queues are executed one after the other.
+      while (!inOrder && end < numCmds &&
+             cmds[end].kind == kind_t::kernel_launch &&
+             cmds[end].waitList.empty())
+        end++;
+    } else {
+      while (end < numCmds && canMergeCopy(cmd, cmds[end - 1], cmds[end]))
+        end++;
+    }
+
+    urEventWait(cmd.waitList.size(), cmd.waitList.data());
+    if (cmd.kind == kind_t::kernel_launch) {
+      launchKernels(device->tp, priority, &cmd, end - i);
+      // In-order queues without deferred submission wait in the enqueue
+      // function instead.
+      if (inOrder && batched)
+        urEventWait(1, &cmd.event);
+    } else {
+      copy(&cmd, end - i);
+    }
+    i = end;
+  }
 }
@@ -10,8 +10,47 @@
 #pragma once
 #include "common.hpp"
 #include "event.hpp"
+#include "threadpool.hpp"
 #include "ur_api.h"
+#include <atomic>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <vector>
+
+namespace native_cpu {
+
+// A command submitted to a queue. On queues with deferred submission
+// commands are recorded in order and dispatched as a batch on the next flush,
+// otherwise they are dispatched straight away.
+struct command_t {
+  enum class kind_t { kernel_launch, copy };
+
+  command_t(kind_t kind, ur_event_handle_t event, uint32_t numEventsInWaitList,
+            const ur_event_handle_t *phEventWaitList)
+      : kind(kind), event(event),
+        waitList(phEventWaitList, phEventWaitList + numEventsInWaitList) {}
+
+  kind_t kind;
+  // Always set for kernel launches, copies only have an event if the user
+  // asked for one.
+  ur_event_handle_t event;
+  std::vector<ur_event_handle_t> waitList;
+
+  // kernel_launch: the tasks to schedule on the threadpool, and an estimate
+  // of their cost used to share the workers between concurrent launches.
+  std::vector<worker_task_t> tasks;
+  size_t work = 1;
+  // Whether all the tasks must run at the same time.
+  bool cooperative = false;
+
+  // copy: a memmove of size bytes from src to dst.
+  void *dst = nullptr;
+  const void *src = nullptr;
+  size_t size = 0;
+};
+
+} // namespace native_cpu
 
 struct ur_queue_handle_t_ : RefCounted {
   ur_queue_handle_t_(ur_device_handle_t device, ur_context_handle_t context,
@@ -21,24 +60,63 @@ struct ur_queue_handle_t_ : RefCounted {
                            UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE)
                        : true),
         profilingEnabled(pProps ? pProps->flags & UR_QUEUE_FLAG_PROFILING_ENABLE
-                                : false) {}
+                                : false),
+        batched(pProps ? pProps->flags & UR_QUEUE_FLAG_SUBMISSION_BATCHED
+                       : false),
+        priority(!pProps ? native_cpu::priority_t::normal
+                 : pProps->flags & UR_QUEUE_FLAG_PRIORITY_HIGH
+                     ? native_cpu::priority_t::high
+                 : pProps->flags & UR_QUEUE_FLAG_PRIORITY_LOW
+                     ? native_cpu::priority_t::low
+                     : native_cpu::priority_t::normal),
+        waitPolicy(pProps &&
+                           (pProps->flags & UR_QUEUE_FLAG_LOW_POWER_EVENTS_EXP)
+                       ? native_cpu::wait_policy_t::block
+                       : native_cpu::get_default_wait_policy()) {}
 
   ur_device_handle_t getDevice() const { return device; }
 
   ur_context_handle_t getContext() const { return context; }
 
-  void addEvent(ur_event_handle_t event) { events.insert(event); }
+  void addEvent(ur_event_handle_t event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.insert(event);
+  }
+
+  void removeEvent(ur_event_handle_t event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.erase(event);
+  }
+
+  // Dispatches cmd, or records it until the next flush on queues with
+  // deferred submission.
+  void submit(native_cpu::command_t &&cmd);
 
-  void removeEvent(ur_event_handle_t event) { events.erase(event); }
+  // Dispatches all the recorded commands. Kernel launches are scheduled
+  // together as far as their dependencies allow and contiguous copies are
+  // coalesced.
+  void flush();
 
   void finish() {
+    flush();
+    std::unique_lock<std::mutex> lock(mutex);
     while (!events.empty()) {
       auto ev = *events.begin();
-      // ur_event_handle_t_::wait removes itself from the events set in the
-      // queue
-      ev->wait();
+      // Events can be released from user callbacks running on worker threads,
+      // so hold a reference while waiting. If the event is already being
+      // destroyed its destructor will remove it from the set.
+      const bool retained = ev->tryIncrementReferenceCount();
+      lock.unlock();
+      if (retained) {
+        // ur_event_handle_t_::wait removes itself from the events set in the
+        // queue
+        ev->wait();
+        decrementOrDelete(ev);
+      } else {
+        std::this_thread::yield();
+      }
+      lock.lock();
     }
-    events.clear();
   }
 
   ~ur_queue_handle_t_() { finish(); }
@@ -47,10 +125,33 @@ struct ur_queue_handle_t_ : RefCounted {
 
   bool isProfiling() const { return profilingEnabled; }
 
+  bool isBatched() const { return batched; }
+
+  native_cpu::wait_policy_t getWaitPolicy() const { return waitPolicy; }
+
 private:
+  void dispatch(native_cpu::command_t *cmds, size_t numCmds);
+
   ur_device_handle_t device;
   ur_context_handle_t context;
+  // Guards events and deferred
+  std::mutex mutex;
   std::set<ur_event_handle_t> events;
   const bool inOrder;
   const bool profilingEnabled;
+  const bool batched;
+  // The threadpool lane of the kernel launches of the queue.
+  const native_cpu::priority_t priority;
+  // How the host waits for the events of the queue. Blocking is the only
+  // policy a queue can ask for, with UR_QUEUE_FLAG_LOW_POWER_EVENTS_EXP, as
+  // there is no queue property for the others. All other queues use the
+  // process-wide default.
+  const native_cpu::wait_policy_t waitPolicy;
+  // Serializes flushes, so that a thread flushing the queue returns only once
+  // the commands recorded so far have been dispatched, even if another thread
+  // took them.
+  std::mutex flushMutex;
+  // The thread holding flushMutex, if any.
+  std::atomic<std::thread::id> flushingThread;
+  std::vector<native_cpu::command_t> deferred;
 };
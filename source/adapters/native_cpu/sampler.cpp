@@ -8,52 +8,537 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 #include "ur_api.h"
 
 #include "common.hpp"
+#include "memory.hpp"
+#include "sampler.hpp"
+
+namespace {
+
+float halfToFloat(uint16_t Half) {
+  const uint32_t Sign = static_cast<uint32_t>(Half & 0x8000) << 16;
+  const uint32_t Exponent = (Half >> 10) & 0x1f;
+  const uint32_t Mantissa = Half & 0x3ff;
+  uint32_t Bits;
+  if (Exponent == 0x1f) {
+    Bits = Sign | 0x7f800000 | (Mantissa << 13);
+  } else if (Exponent != 0) {
+    Bits = Sign | ((Exponent + 112) << 23) | (Mantissa << 13);
+  } else {
+    // Zero or subnormal.
+    const float Value = std::ldexp(static_cast<float>(Mantissa), -24);
+    return Sign ? -Value : Value;
+  }
+  float Value;
+  std::memcpy(&Value, &Bits, sizeof(Value));
+  return Value;
+}
+
+float srgbToLinear(float Value) {
+  return Value <= 0.04045f ? Value / 12.92f
+                           : std::pow((Value + 0.055f) / 1.055f, 2.4f);
+}
+
+template <typename T> T load(const char *Ptr, size_t Index) {
+  T Value;
+  std::memcpy(&Value, Ptr + Index * sizeof(T), sizeof(T));
+  return Value;
+}
+
+// Reads the channels of the texel at Ptr in the order they are stored.
+void loadChannels(const char *Ptr, ur_image_channel_type_t Type,
+                  size_t Channels, float Values[4]) {
+  for (size_t I = 0; I < Channels; I++) {
+    switch (Type) {
+    case UR_IMAGE_CHANNEL_TYPE_SNORM_INT8:
+      Values[I] = std::max(-1.0f, load<int8_t>(Ptr, I) / 127.0f);
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_SNORM_INT16:
+      Values[I] = std::max(-1.0f, load<int16_t>(Ptr, I) / 32767.0f);
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_UNORM_INT8:
+      Values[I] = load<uint8_t>(Ptr, I) / 255.0f;
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_UNORM_INT16:
+      Values[I] = load<uint16_t>(Ptr, I) / 65535.0f;
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_SIGNED_INT8:
+      Values[I] = load<int8_t>(Ptr, I);
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_SIGNED_INT16:
+      Values[I] = load<int16_t>(Ptr, I);
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_SIGNED_INT32:
+      Values[I] = static_cast<float>(load<int32_t>(Ptr, I));
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_UNSIGNED_INT8:
+      Values[I] = load<uint8_t>(Ptr, I);
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_UNSIGNED_INT16:
+      Values[I] = load<uint16_t>(Ptr, I);
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_UNSIGNED_INT32:
+      Values[I] = static_cast<float>(load<uint32_t>(Ptr, I));
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_HALF_FLOAT:
+      Values[I] = halfToFloat(load<uint16_t>(Ptr, I));
+      break;
+    case UR_IMAGE_CHANNEL_TYPE_FLOAT:
+      Values[I] = load<float>(Ptr, I);
+      break;
+    default:
+      Values[I] = 0.0f;
+      break;
+    }
+  }
+}
+
+} // namespace
+
+void native_cpu::loadTexel(const _ur_image &Image, const char *Ptr,
+                           float Texel[4]) {
+  const ur_image_format_t &Format = Image.Format;
+  float C[4] = {};
+  switch (Format.channelType) {
+  case UR_IMAGE_CHANNEL_TYPE_UNORM_SHORT_565: {
+    const auto Value = load<uint16_t>(Ptr, 0);
+    C[0] = ((Value >> 11) & 0x1f) / 31.0f;
+    C[1] = ((Value >> 5) & 0x3f) / 63.0f;
+    C[2] = (Value & 0x1f) / 31.0f;
+    break;
+  }
+  case UR_IMAGE_CHANNEL_TYPE_UNORM_SHORT_555: {
+    const auto Value = load<uint16_t>(Ptr, 0);
+    C[0] = ((Value >> 10) & 0x1f) / 31.0f;
+    C[1] = ((Value >> 5) & 0x1f) / 31.0f;
+    C[2] = (Value & 0x1f) / 31.0f;
+    break;
+  }
+  case UR_IMAGE_CHANNEL_TYPE_INT_101010: {
+    const auto Value = load<uint32_t>(Ptr, 0);
+    C[0] = ((Value >> 20) & 0x3ff) / 1023.0f;
+    C[1] = ((Value >> 10) & 0x3ff) / 1023.0f;
+    C[2] = (Value & 0x3ff) / 1023.0f;
+    break;
+  }
+  default: {
+    size_t Channels = 4;
+    switch (Format.channelOrder) {
+    case UR_IMAGE_CHANNEL_ORDER_A:
+    case UR_IMAGE_CHANNEL_ORDER_R:
+    case UR_IMAGE_CHANNEL_ORDER_RX:
+    case UR_IMAGE_CHANNEL_ORDER_INTENSITY:
+    case UR_IMAGE_CHANNEL_ORDER_LUMINANCE:
+      Channels = 1;
+      break;
+    case UR_IMAGE_CHANNEL_ORDER_RG:
+    case UR_IMAGE_CHANNEL_ORDER_RA:
+    case UR_IMAGE_CHANNEL_ORDER_RGX:
+      Channels = 2;
+      break;
+    default:
+      break;
+    }
+    loadChannels(Ptr, Format.channelType, Channels, C);
+    break;
+  }
+  }
+
+  switch (Format.channelOrder) {
+  case UR_IMAGE_CHANNEL_ORDER_A:
+    Texel[0] = Texel[1] = Texel[2] = 0.0f;
+    Texel[3] = C[0];
+    return;
+  case UR_IMAGE_CHANNEL_ORDER_R:
+  case UR_IMAGE_CHANNEL_ORDER_RX:
+    Texel[0] = C[0];
+    Texel[1] = Texel[2] = 0.0f;
+    Texel[3] = 1.0f;
+    return;
+  case UR_IMAGE_CHANNEL_ORDER_RG:
+  case UR_IMAGE_CHANNEL_ORDER_RGX:
+    Texel[0] = C[0];
+    Texel[1] = C[1];
+    Texel[2] = 0.0f;
+    Texel[3] = 1.0f;
+    return;
+  case UR_IMAGE_CHANNEL_ORDER_RA:
+    Texel[0] = C[0];
+    Texel[1] = Texel[2] = 0.0f;
+    Texel[3] = C[1];
+    return;
+  case UR_IMAGE_CHANNEL_ORDER_RGB:
+  case UR_IMAGE_CHANNEL_ORDER_RGBX:
+    Texel[0] = C[0];
+    Texel[1] = C[1];
+    Texel[2] = C[2];
+    Texel[3] = 1.0f;
+    return;
+  case UR_IMAGE_CHANNEL_ORDER_SRGBA:
+    Texel[0] = srgbToLinear(C[0]);
+    Texel[1] = srgbToLinear(C[1]);
+    Texel[2] = srgbToLinear(C[2]);
+    Texel[3] = C[3];
+    return;
+  case UR_IMAGE_CHANNEL_ORDER_BGRA:
+    Texel[0] = C[2];
+    Texel[1] = C[1];
+    Texel[2] = C[0];
+    Texel[3] = C[3];
+    return;
+  case UR_IMAGE_CHANNEL_ORDER_ARGB:
+    Texel[0] = C[1];
+    Texel[1] = C[2];
+    Texel[2] = C[3];
+    Texel[3] = C[0];
+    return;
+  case UR_IMAGE_CHANNEL_ORDER_ABGR:
+    Texel[0] = C[3];
+    Texel[1] = C[2];
+    Texel[2] = C[1];
+    Texel[3] = C[0];
+    return;
+  case UR_IMAGE_CHANNEL_ORDER_INTENSITY:
+    Texel[0] = Texel[1] = Texel[2] = Texel[3] = C[0];
+    return;
+  case UR_IMAGE_CHANNEL_ORDER_LUMINANCE:
+    Texel[0] = Texel[1] = Texel[2] = C[0];
+    Texel[3] = 1.0f;
+    return;
+  default:
+    std::memcpy(Texel, C, sizeof(C));
+    return;
+  }
+}
+
+namespace {
+
+// Loaders for the most common formats, which don't need to look at the format
+// of each texel they read.
+void loadRGBAFloat(const _ur_image &, const char *Ptr, float Texel[4]) {
+  std::memcpy(Texel, Ptr, 4 * sizeof(float));
+}
+
+void loadRFloat(const _ur_image &, const char *Ptr, float Texel[4]) {
+  Texel[0] = load<float>(Ptr, 0);
+  Texel[1] = Texel[2] = 0.0f;
+  Texel[3] = 1.0f;
+}
+
+void loadRGBAUnorm8(const _ur_image &, const char *Ptr, float Texel[4]) {
+  for (size_t I = 0; I < 4; I++) {
+    Texel[I] = load<uint8_t>(Ptr, I) / 255.0f;
+  }
+}
+
+void loadBGRAUnorm8(const _ur_image &, const char *Ptr, float Texel[4]) {
+  Texel[0] = load<uint8_t>(Ptr, 2) / 255.0f;
+  Texel[1] = load<uint8_t>(Ptr, 1) / 255.0f;
+  Texel[2] = load<uint8_t>(Ptr, 0) / 255.0f;
+  Texel[3] = load<uint8_t>(Ptr, 3) / 255.0f;
+}
+
+} // namespace
+
+native_cpu::texel_loader_t
+native_cpu::getTexelLoader(const ur_image_format_t &Format) {
+  switch (Format.channelType) {
+  case UR_IMAGE_CHANNEL_TYPE_FLOAT:
+    if (Format.channelOrder == UR_IMAGE_CHANNEL_ORDER_RGBA) {
+      return loadRGBAFloat;
+    }
+    if (Format.channelOrder == UR_IMAGE_CHANNEL_ORDER_R) {
+      return loadRFloat;
+    }
+    break;
+  case UR_IMAGE_CHANNEL_TYPE_UNORM_INT8:
+    if (Format.channelOrder == UR_IMAGE_CHANNEL_ORDER_RGBA) {
+      return loadRGBAUnorm8;
+    }
+    if (Format.channelOrder == UR_IMAGE_CHANNEL_ORDER_BGRA) {
+      return loadBGRAUnorm8;
+    }
+    break;
+  default:
+    break;
+  }
+  return loadTexel;
+}
+
+namespace {
+
+bool hasAlpha(ur_image_channel_order_t Order) {
+  switch (Order) {
+  case UR_IMAGE_CHANNEL_ORDER_A:
+  case UR_IMAGE_CHANNEL_ORDER_RA:
+  case UR_IMAGE_CHANNEL_ORDER_RGBA:
+  case UR_IMAGE_CHANNEL_ORDER_BGRA:
+  case UR_IMAGE_CHANNEL_ORDER_ARGB:
+  case UR_IMAGE_CHANNEL_ORDER_ABGR:
+  case UR_IMAGE_CHANNEL_ORDER_INTENSITY:
+  case UR_IMAGE_CHANNEL_ORDER_SRGBA:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// The texels a coordinate filters between along one dimension. Out of range
+// indices are only left for the clamp addressing mode, where they read the
+// border colour.
+struct texel_span_t {
+  long First;
+  long Second;
+  // Weight of Second, zero with nearest filtering.
+  float Weight;
+};
+
+texel_span_t resolve(float Coord, size_t Size, bool Normalized,
+                     ur_sampler_addressing_mode_t Mode, bool Linear) {
+  const long Last = static_cast<long>(Size) - 1;
+  const float Extent = static_cast<float>(Size);
+  texel_span_t Span;
+
+  // The repeating modes are only defined for normalized coordinates.
+  if (Normalized && Mode == UR_SAMPLER_ADDRESSING_MODE_REPEAT) {
+    const float U = (Coord - std::floor(Coord)) * Extent;
+    if (!Linear) {
+      Span.First = std::min(static_cast<long>(std::floor(U)), Last);
+      Span.Second = Span.First;
+      Span.Weight = 0.0f;
+      return Span;
+    }
+    const float Base = std::floor(U - 0.5f);
+    Span.First = static_cast<long>(Base);
+    Span.Second = Span.First + 1;
+    Span.Weight = U - 0.5f - Base;
+    if (Span.First < 0)
+      Span.First += Size;
+    if (Span.Second > Last)
+      Span.Second -= Size;
+    return Span;
+  }
+  if (Normalized && Mode == UR_SAMPLER_ADDRESSING_MODE_MIRRORED_REPEAT) {
+    const float Mirrored =
+        std::fabs(Coord - 2.0f * std::rint(0.5f * Coord)) * Extent;
+    if (!Linear) {
+      Span.First = std::min(static_cast<long>(std::floor(Mirrored)), Last);
+      Span.Second = Span.First;
+      Span.Weight = 0.0f;
+      return Span;
+    }
+    const float Base = std::floor(Mirrored - 0.5f);
+    Span.First = std::max(static_cast<long>(Base), 0l);
+    Span.Second = std::min(static_cast<long>(Base) + 1, Last);
+    Span.Weight = Mirrored - 0.5f - Base;
+    return Span;
+  }
+
+  const float U = Normalized ? Coord * Extent : Coord;
+  if (Linear) {
+    const float Base = std::floor(U - 0.5f);
+    Span.First = static_cast<long>(Base);
+    Span.Second = Span.First + 1;
+    Span.Weight = U - 0.5f - Base;
+  } else {
+    Span.First = static_cast<long>(std::floor(U));
+    Span.Second = Span.First;
+    Span.Weight = 0.0f;
+  }
+  if (Mode != UR_SAMPLER_ADDRESSING_MODE_CLAMP) {
+    Span.First = std::clamp(Span.First, 0l, Last);
+    Span.Second = std::clamp(Span.Second, 0l, Last);
+  }
+  return Span;
+}
+
+// Whether both texels of Span are within an image dimension of Size texels.
+bool inside(const texel_span_t &Span, size_t Size) {
+  const long Extent = static_cast<long>(Size);
+  return Span.First >= 0 && Span.Second >= 0 && Span.First < Extent &&
+         Span.Second < Extent;
+}
+
+size_t imageDimensions(ur_mem_type_t Type) {
+  switch (Type) {
+  case UR_MEM_TYPE_IMAGE1D:
+  case UR_MEM_TYPE_IMAGE1D_ARRAY:
+    return 1;
+  case UR_MEM_TYPE_IMAGE2D:
+  case UR_MEM_TYPE_IMAGE2D_ARRAY:
+    return 2;
+  default:
+    return 3;
+  }
+}
+
+} // namespace
+
+ur_sampler_handle_t_::ur_sampler_handle_t_(ur_context_handle_t Context,
+                                           const ur_sampler_desc_t &Desc)
+    : Context(Context), NormalizedCoords(Desc.normalizedCoords),
+      AddressingMode(Desc.addressingMode), FilterMode(Desc.filterMode) {
+  KernelArg.Sample = [](const native_cpu::sampler_t *Sampler,
+                        const native_cpu::image_t *Image, const float *Coords,
+                        float Texel[4]) {
+    static_cast<const ur_sampler_handle_t_ *>(Sampler->Impl)
+        ->sample(*static_cast<const _ur_image *>(Image->Impl), Coords, Texel);
+  };
+  KernelArg.Impl = this;
+}
+
+void ur_sampler_handle_t_::sample(const _ur_image &Image, const float *Coords,
+                                  float Texel[4]) const {
+  const size_t Dims = imageDimensions(Image.Desc.type);
+  const bool Linear = FilterMode == UR_SAMPLER_FILTER_MODE_LINEAR;
+
+  texel_span_t Spans[3] = {{0, 0, 0.0f}, {0, 0, 0.0f}, {0, 0, 0.0f}};
+  for (size_t D = 0; D < Dims; D++) {
+    Spans[D] = resolve(Coords[D], Image.Extent[D], NormalizedCoords,
+                       AddressingMode, Linear);
+  }
+  // The layer of image arrays is rounded and clamped, never filtered.
+  if (Image.Desc.type == UR_MEM_TYPE_IMAGE1D_ARRAY ||
+      Image.Desc.type == UR_MEM_TYPE_IMAGE2D_ARRAY) {
+    const long Last = static_cast<long>(Image.Extent[Dims]) - 1;
+    const long Layer =
+        std::clamp(static_cast<long>(std::rint(Coords[Dims])), 0l, Last);
+    Spans[Dims] = {Layer, Layer, 0.0f};
+  }
+
+  const float Border[4] = {0.0f, 0.0f, 0.0f,
+                           hasAlpha(Image.Format.channelOrder) ? 0.0f : 1.0f};
+  auto Fetch = [&](long X, long Y, long Z, float Out[4]) {
+    if (X < 0 || Y < 0 || Z < 0 || X >= static_cast<long>(Image.Extent[0]) ||
+        Y >= static_cast<long>(Image.Extent[1]) ||
+        Z >= static_cast<long>(Image.Extent[2])) {
+      std::memcpy(Out, Border, sizeof(Border));
+      return;
+    }
+    Image.LoadTexel(Image, Image.texel(X, Y, Z), Out);
+  };
+
+  // Nearest filtering reads a single texel.
+  if (!Linear) {
+    Fetch(Spans[0].First, Spans[1].First, Spans[2].First, Texel);
+    return;
+  }
+
+  // Bilinear filtering away from the border of a 2D image, which is what
+  // most samples are, blends the four texels without checking each of them.
+  if (Dims == 2 && inside(Spans[0], Image.Extent[0]) &&
+      inside(Spans[1], Image.Extent[1])) {
+    const size_t Z = Spans[2].First;
+    float Texels[4][4];
+    Image.LoadTexel(Image, Image.texel(Spans[0].First, Spans[1].First, Z),
+                    Texels[0]);
+    Image.LoadTexel(Image, Image.texel(Spans[0].Second, Spans[1].First, Z),
+                    Texels[1]);
+    Image.LoadTexel(Image, Image.texel(Spans[0].First, Spans[1].Second, Z),
+                    Texels[2]);
+    Image.LoadTexel(Image, Image.texel(Spans[0].Second, Spans[1].Second, Z),
+                    Texels[3]);
+    const float WX = Spans[0].Weight;
+    const float WY = Spans[1].Weight;
+    for (size_t C = 0; C < 4; C++) {
+      const float Lower = (1.0f - WX) * Texels[0][C] + WX * Texels[1][C];
+      const float Upper = (1.0f - WX) * Texels[2][C] + WX * Texels[3][C];
+      Texel[C] = (1.0f - WY) * Lower + WY * Upper;
+    }
+    return;
+  }
+
+  // Linear filtering blends the 2, 4 or 8 texels around the coordinate,
+  // skipping the dimensions that aren't filtered.
+  std::fill(Texel, Texel + 4, 0.0f);
+  const size_t Corners = size_t(1) << Dims;
+  for (size_t Corner = 0; Corner < Corners; Corner++) {
+    long Index[3];
+    float Weight = 1.0f;
+    for (size_t D = 0; D < 3; D++) {
+      const bool Upper = D < Dims && (Corner >> D) & 1;
+      Index[D] = Upper ? Spans[D].Second : Spans[D].First;
+      if (D < Dims) {
+        Weight *= Upper ? Spans[D].Weight : 1.0f - Spans[D].Weight;
+      }
+    }
+    if (Weight == 0.0f) {
+      continue;
+    }
+    float Value[4];
+    Fetch(Index[0], Index[1], Index[2], Value);
+    for (size_t C = 0; C < 4; C++) {
+      Texel[C] += Weight * Value[C];
+    }
+  }
+}
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urSamplerCreate(ur_context_handle_t hContext, const ur_sampler_desc_t *pDesc,
-                ur_sampler_handle_t *phSampler) {
-  std::ignore = hContext;
-  std::ignore = pDesc;
-  std::ignore = phSampler;
+                ur_sampler_handle_t *phSampler) try {
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pDesc && phSampler, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pDesc->addressingMode <= UR_SAMPLER_ADDRESSING_MODE_MIRRORED_REPEAT,
+            UR_RESULT_ERROR_INVALID_ENUMERATION);
+  UR_ASSERT(pDesc->filterMode <= UR_SAMPLER_FILTER_MODE_LINEAR,
+            UR_RESULT_ERROR_INVALID_ENUMERATION);
 
-  DIE_NO_IMPLEMENTATION;
+  *phSampler = new ur_sampler_handle_t_(hContext, *pDesc);
+  return UR_RESULT_SUCCESS;
+} catch (...) {
+  return exceptionToResult(std::current_exception());
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urSamplerRetain(ur_sampler_handle_t hSampler) {
-  std::ignore = hSampler;
+  UR_ASSERT(hSampler, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
 
-  DIE_NO_IMPLEMENTATION;
+  hSampler->incrementReferenceCount();
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urSamplerRelease(ur_sampler_handle_t hSampler) {
-  std::ignore = hSampler;
+  UR_ASSERT(hSampler, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
 
-  DIE_NO_IMPLEMENTATION;
+  decrementOrDelete(hSampler);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urSamplerGetInfo(ur_sampler_handle_t hSampler, ur_sampler_info_t propName,
                  size_t propSize, void *pPropValue, size_t *pPropSizeRet) {
-  std::ignore = hSampler;
-  std::ignore = propName;
-  std::ignore = propSize;
-  std::ignore = pPropValue;
-  std::ignore = pPropSizeRet;
+  UR_ASSERT(hSampler, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
 
-  DIE_NO_IMPLEMENTATION;
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+  switch (propName) {
+  case UR_SAMPLER_INFO_REFERENCE_COUNT:
+    return ReturnValue(hSampler->getReferenceCount());
+  case UR_SAMPLER_INFO_CONTEXT:
+    return ReturnValue(hSampler->Context);
+  case UR_SAMPLER_INFO_NORMALIZED_COORDS:
+    return ReturnValue(static_cast<ur_bool_t>(hSampler->NormalizedCoords));
+  case UR_SAMPLER_INFO_ADDRESSING_MODE:
+    return ReturnValue(hSampler->AddressingMode);
+  case UR_SAMPLER_INFO_FILTER_MODE:
+    return ReturnValue(hSampler->FilterMode);
+  default:
+    return UR_RESULT_ERROR_INVALID_ENUMERATION;
+  }
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urSamplerGetNativeHandle(
     ur_sampler_handle_t hSampler, ur_native_handle_t *phNativeSampler) {
-  std::ignore = hSampler;
-  std::ignore = phNativeSampler;
+  UR_ASSERT(hSampler, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(phNativeSampler, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
-  DIE_NO_IMPLEMENTATION;
+  // Samplers are plain host objects, there is nothing native to share.
+  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urSamplerCreateWithNativeHandle(
@@ -61,9 +546,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urSamplerCreateWithNativeHandle(
     const ur_sampler_native_properties_t *pProperties,
     ur_sampler_handle_t *phSampler) {
   std::ignore = hNativeSampler;
-  std::ignore = hContext;
   std::ignore = pProperties;
-  std::ignore = phSampler;
 
-  DIE_NO_IMPLEMENTATION;
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(phSampler, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+
+  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
 }
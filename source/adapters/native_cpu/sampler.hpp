@@ -0,0 +1,51 @@
+//===--------- sampler.hpp - NATIVE CPU Adapter ---------------------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <ur_api.h>
+
+#include "common.hpp"
+#include "nativecpu_state.hpp"
+
+struct _ur_image;
+
+namespace native_cpu {
+
+// Reads the texel of Image at Ptr and converts it to floats in RGBA order.
+void loadTexel(const _ur_image &Image, const char *Ptr, float Texel[4]);
+
+using texel_loader_t = void (*)(const _ur_image &Image, const char *Ptr,
+                                float Texel[4]);
+
+// Returns a loader that does what loadTexel does for images of Format,
+// specialized for the most common formats so that reading a texel doesn't
+// go through the conversion of every channel type and order.
+texel_loader_t getTexelLoader(const ur_image_format_t &Format);
+
+} // namespace native_cpu
+
+struct ur_sampler_handle_t_ : RefCounted {
+  ur_sampler_handle_t_(ur_context_handle_t Context,
+                       const ur_sampler_desc_t &Desc);
+
+  // Samples Image at Coords, which holds as many coordinates as the image has
+  // dimensions followed by the layer for image arrays, and writes the texel
+  // converted to floats in RGBA order to Texel.
+  void sample(const _ur_image &Image, const float *Coords,
+              float Texel[4]) const;
+
+  const ur_context_handle_t Context;
+  const bool NormalizedCoords;
+  const ur_sampler_addressing_mode_t AddressingMode;
+  const ur_sampler_filter_mode_t FilterMode;
+  // What kernels are given for the sampler.
+  native_cpu::sampler_t KernelArg;
+};
@@ -9,12 +9,14 @@
 #pragma once
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdlib>
 #include <forward_list>
 #include <functional>
 #include <future>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <numeric>
 #include <queue>
@@ -22,22 +24,134 @@
 #include <thread>
 #include <vector>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace native_cpu {
 
 using worker_task_t = std::function<void(size_t)>;
 
+// The scheduling lanes of the threadpool. Jobs only get workers that the jobs
+// of the lanes before theirs can't use.
+enum class priority_t { high, normal, low };
+
+// How host threads wait for the commands they depend on:
+// - busy_poll keeps polling, which notices completion soonest but takes a
+//   whole core for as long as the wait lasts.
+// - spin_then_block polls for a short while and then sleeps until it is
+//   woken, which keeps short waits fast without burning a core on long ones.
+// - block sleeps straight away, which uses the least CPU time but adds the
+//   cost of a wake-up to every wait.
+enum class wait_policy_t { busy_poll, spin_then_block, block };
+
+// The policy of queues that didn't ask for low-power events, set for the
+// whole process with UR_NATIVE_CPU_WAIT_POLICY=busy|spin|block. Spinning then
+// blocking is the default, as most waits are for small kernels and copies
+// that finish within the spin, and on longer waits it gives the core back to
+// the workers, which share the host's cores with the waiting thread.
+inline wait_policy_t get_default_wait_policy() {
+  const char *envVar = std::getenv("UR_NATIVE_CPU_WAIT_POLICY");
+  if (!envVar)
+    return wait_policy_t::spin_then_block;
+  const std::string policy(envVar);
+  if (policy == "busy")
+    return wait_policy_t::busy_poll;
+  if (policy == "block")
+    return wait_policy_t::block;
+  return wait_policy_t::spin_then_block;
+}
+
+// Waits until future is ready. std::future::wait blocks on a futex on Linux.
+inline void wait_ready(const std::shared_future<void> &future,
+                       wait_policy_t policy) {
+  // Long enough to cover the completion of a small kernel, short enough not
+  // to matter next to the waits that end up blocking.
+  constexpr auto spinLimit = std::chrono::microseconds(50);
+  if (policy != wait_policy_t::block) {
+    const auto start = std::chrono::steady_clock::now();
+    while (future.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready) {
+      if (policy == wait_policy_t::spin_then_block &&
+          std::chrono::steady_clock::now() - start >= spinLimit)
+        break;
+      std::this_thread::yield();
+    }
+  }
+  future.wait();
+}
+
+// A group of tasks, such as those of a kernel launch, executed by a share of
+// the workers of a threadpool.
+struct job_t {
+  job_t(std::vector<worker_task_t> &&tasks, size_t work,
+        priority_t priority = priority_t::normal, bool cooperative = false)
+      : tasks(std::move(tasks)), work(std::max<size_t>(work, 1)),
+        priority(priority), cooperative(cooperative),
+        remaining(this->tasks.size()), future(done.get_future().share()) {
+    if (this->tasks.empty())
+      done.set_value();
+  }
+
+  // Runs the given task and completes the job if it was the last one.
+  void run(size_t index, size_t threadId) {
+    tasks[index](threadId);
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      done.set_value();
+  }
+
+  std::vector<worker_task_t> tasks;
+  // An estimate of the cost of all the tasks, only compared between jobs.
+  const size_t work;
+  const priority_t priority;
+  // Cooperative jobs run all their tasks at the same time, each on a worker
+  // of its own, so the tasks may wait for each other.
+  const bool cooperative;
+  // The next task to hand out, whether the job was given its workers if it
+  // is cooperative, and since when the job has been left without workers if
+  // it isn't. Guarded by the threadpool.
+  size_t next = 0;
+  bool admitted = false;
+  bool starving = false;
+  std::chrono::steady_clock::time_point starvingSince;
+  std::atomic<size_t> remaining;
+  std::promise<void> done;
+  // Ready once all the tasks have completed.
+  std::shared_future<void> future;
+};
+
+using job_ptr_t = std::shared_ptr<job_t>;
+
 namespace detail {
 
+// Restricts the calling thread to the given CPU. This is best effort, the
+// thread keeps running wherever the OS puts it if it fails.
+inline void pin_current_thread(int cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)cpu;
+#endif
+}
+
 class worker_thread {
 public:
-  // Initializes state, but does not start the worker thread
-  worker_thread(size_t threadId) noexcept
+  // Initializes state, but does not start the worker thread. If cpu isn't
+  // negative the worker only runs on that CPU.
+  worker_thread(size_t threadId, int cpu = -1) noexcept
       : m_threadId(threadId), m_isRunning(false), m_numTasks(0) {
     std::lock_guard<std::mutex> lock(m_workMutex);
     if (this->is_running()) {
       return;
     }
-    m_worker = std::thread([this]() {
+    m_worker = std::thread([this, cpu]() {
+      if (cpu >= 0) {
+        pin_current_thread(cpu);
+      }
       while (true) {
         std::unique_lock<std::mutex> lock(m_workMutex);
         // Wait until there's work available
@@ -97,6 +211,10 @@ public:
     return m_isRunning.load(std::memory_order_acquire);
   }
 
+  bool is_current_thread() const noexcept {
+    return m_worker.get_id() == std::this_thread::get_id();
+  }
+
 private:
   // Unique ID identifying the thread in the threadpool
   const size_t m_threadId;
@@ -120,10 +238,19 @@ private:
 // parameters and futures.
 class simple_thread_pool {
 public:
-  simple_thread_pool() noexcept
-      : m_isRunning(false), m_numThreads(get_num_threads()) {
+  // Starts one worker pinned to each of the given CPUs, or as many unpinned
+  // workers as the host has threads if there are none.
+  simple_thread_pool(const std::vector<int> &cpus) noexcept
+      : m_isRunning(false),
+        m_numThreads(cpus.empty() ? get_num_threads() : cpus.size()),
+        m_isPinned(!cpus.empty()),
+        m_sharesEnabled(!std::getenv("UR_NATIVE_CPU_DISABLE_WORKER_SHARES")),
+        m_starvationLimit(get_starvation_limit()),
+        m_assignment(m_numThreads), m_hasRunner(m_numThreads, false),
+        m_inCooperative(m_numThreads, false), m_workerById(m_numThreads) {
     for (size_t i = 0; i < m_numThreads; i++) {
-      m_workers.emplace_front(i);
+      m_workers.emplace_front(i, cpus.empty() ? -1 : cpus[i]);
+      m_workerById[i] = &m_workers.front();
     }
     m_isRunning.store(true, std::memory_order_release);
   }
@@ -140,12 +267,51 @@ public:
     this->best_worker().schedule(task);
   }
 
+  // Schedules the tasks of the jobs. Unless shares are disabled, every job
+  // active in the pool gets its own subset of the workers, in proportion to
+  // the work it has left, so that concurrent jobs run side by side instead of
+  // interleaving their tasks on every worker. Jobs of higher priority are
+  // served first, and take workers from those of lower priority as soon as
+  // they finish their current task. The shares are rebalanced whenever jobs
+  // are added or run out of tasks, and when a starving job is due to be
+  // promoted. Priorities are ignored if shares are disabled.
+  //
+  // Cooperative jobs come before any other, and only start once they can
+  // have as many workers as they have tasks, which they keep until all their
+  // tasks have started. They must not have more tasks than the pool has
+  // workers.
+  void schedule_jobs(std::vector<job_ptr_t> &&jobs) {
+    std::lock_guard<std::mutex> lock(m_jobsMutex);
+    if (!m_sharesEnabled) {
+      for (auto &job : jobs) {
+        for (size_t i = 0; i < job->tasks.size(); i++) {
+          auto task = [job, i](size_t threadId) { job->run(i, threadId); };
+          // Workers run their tasks in order, and the tasks of cooperative
+          // jobs are queued on the same workers in the same order, under
+          // the lock, so each job gets all its workers eventually.
+          if (job->cooperative)
+            m_workerById[i]->schedule(task);
+          else
+            schedule(task);
+        }
+      }
+      return;
+    }
+    for (auto &job : jobs) {
+      if (!job->tasks.empty())
+        m_jobs.push_back(std::move(job));
+    }
+    rebalance();
+  }
+
   inline bool is_running() const noexcept {
     return m_isRunning.load(std::memory_order_acquire);
   }
 
   inline size_t num_threads() const noexcept { return m_numThreads; }
 
+  inline bool is_pinned() const noexcept { return m_isPinned; }
+
   inline size_t num_pending_tasks() const noexcept {
     return std::accumulate(std::begin(m_workers), std::end(m_workers),
                            size_t(0),
@@ -154,6 +320,55 @@ public:
                            });
   }
 
+  // Runs task(i) for every i below the number of workers and returns once all
+  // have run. Each i is handed to worker i if it has nothing to do, and the
+  // calling thread runs those of busy workers itself, as well as those whose
+  // worker was given other work before getting to them, so that this never
+  // waits behind long-running tasks such as persistent kernels. Workers
+  // calling this run all of them themselves.
+  void run_on_idle_workers(const worker_task_t &task) {
+    if (std::any_of(
+            m_workers.begin(), m_workers.end(),
+            [](const worker_thread &w) { return w.is_current_thread(); })) {
+      for (size_t i = 0; i < m_numThreads; i++)
+        task(i);
+      return;
+    }
+    // Shared with the tasks handed to workers, which may only run after this
+    // has returned, and then find theirs already claimed.
+    struct state_t {
+      explicit state_t(size_t n) : claimed(n), remaining(n) {}
+      std::vector<std::atomic<bool>> claimed;
+      std::atomic<size_t> remaining;
+    };
+    auto state = std::make_shared<state_t>(m_numThreads);
+    auto run = [](state_t &state, const worker_task_t &task, size_t i) {
+      if (!state.claimed[i].exchange(true)) {
+        task(i);
+        --state.remaining;
+      }
+    };
+    std::vector<bool> handedOut(m_numThreads, false);
+    for (size_t i = 0; i < m_numThreads; i++) {
+      if (m_workerById[i]->num_pending_tasks() == 0) {
+        handedOut[i] = true;
+        m_workerById[i]->schedule([=](size_t) { run(*state, task, i); });
+      }
+    }
+    for (size_t i = 0; i < m_numThreads; i++) {
+      if (!handedOut[i])
+        run(*state, task, i);
+    }
+    // A worker with another task besides ours is running that one first.
+    while (state->remaining > 0) {
+      for (size_t i = 0; i < m_numThreads; i++) {
+        if (handedOut[i] && m_workerById[i]->num_pending_tasks() > 1)
+          run(*state, task, i);
+      }
+      std::this_thread::yield();
+    }
+  }
+
   void wait_for_all_pending_tasks() {
     while (num_pending_tasks() > 0) {
       std::this_thread::yield();
@@ -174,6 +389,201 @@ protected:
   }
 
 private:
+  // Runs the tasks of the job the worker is assigned to, and of those it gets
+  // reassigned to, until it has none.
+  void run_jobs(size_t threadId) {
+    std::unique_lock<std::mutex> lock(m_jobsMutex);
+    while (job_ptr_t job = m_assignment[threadId]) {
+      if (job->next == job->tasks.size()) {
+        rebalance();
+        continue;
+      }
+      const size_t index = job->next++;
+      m_inCooperative[threadId] = job->cooperative;
+      lock.unlock();
+      job->run(index, threadId);
+      lock.lock();
+      if (m_inCooperative[threadId]) {
+        // The worker may have been left out of the shares while it ran the
+        // task.
+        m_inCooperative[threadId] = false;
+        rebalance();
+      } else if (m_nextPromotion != time_point_t::max() &&
+                 std::chrono::steady_clock::now() >= m_nextPromotion) {
+        rebalance();
+      }
+    }
+    m_hasRunner[threadId] = false;
+  }
+
+  // Drops the jobs with no task left to hand out and shares the workers
+  // between the others. Must be called with m_jobsMutex held.
+  void rebalance() {
+    m_jobs.erase(std::remove_if(m_jobs.begin(), m_jobs.end(),
+                                [](const job_ptr_t &job) {
+                                  return job->next == job->tasks.size();
+                                }),
+                 m_jobs.end());
+
+    // Workers running a task of a cooperative job can't be reassigned until
+    // it completes, and cooperative jobs keep the workers they were given
+    // until all their tasks have started.
+    std::vector<job_ptr_t> assignment(m_numThreads);
+    std::vector<bool> pinned(m_inCooperative);
+    for (size_t w = 0; w < m_numThreads; w++) {
+      if (m_assignment[w] && m_assignment[w]->cooperative &&
+          m_assignment[w]->admitted &&
+          m_assignment[w]->next < m_assignment[w]->tasks.size()) {
+        assignment[w] = m_assignment[w];
+        pinned[w] = true;
+      }
+    }
+    // Cooperative jobs start in order, each once there are enough workers
+    // left for all its tasks. Idle workers are taken first.
+    size_t free = std::count(pinned.begin(), pinned.end(), false);
+    for (auto &job : m_jobs) {
+      if (!job->cooperative || job->admitted)
+        continue;
+      if (job->tasks.size() > free)
+        break;
+      size_t needed = job->tasks.size();
+      for (bool idleOnly : {true, false}) {
+        for (size_t w = 0; w < m_numThreads && needed; w++) {
+          if (!pinned[w] && (!idleOnly || !m_assignment[w])) {
+            assignment[w] = job;
+            pinned[w] = true;
+            needed--;
+          }
+        }
+      }
+      free -= job->tasks.size();
+      job->admitted = true;
+    }
+
+    // Jobs left without workers for longer than the starvation limit are
+    // served with the high priority jobs.
+    const auto now = std::chrono::steady_clock::now();
+    auto laneOf = [&](const job_t &job) {
+      if (job.starving && m_starvationLimit.count() &&
+          now - job.starvingSince >= m_starvationLimit)
+        return priority_t::high;
+      return job.priority;
+    };
+    const size_t numJobs = m_jobs.size();
+    std::vector<size_t> order;
+    for (size_t j = 0; j < numJobs; j++) {
+      if (!m_jobs[j]->cooperative)
+        order.push_back(j);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return laneOf(*m_jobs[a]) < laneOf(*m_jobs[b]);
+    });
+
+    // Lane by lane, every job gets at least one of the remaining workers,
+    // oldest first, and never more than it has tasks left. The other workers
+    // are handed out in proportion to the work left in each job of the lane,
+    // and only those that the lane can't use are left for the next one.
+    std::vector<size_t> shares(numJobs, 0);
+    std::vector<double> ideal(numJobs, 0.0);
+    for (size_t begin = 0, end = 0; begin < order.size() && free;
+         begin = end) {
+      const priority_t lane = laneOf(*m_jobs[order[begin]]);
+      double totalWork = 0.0;
+      for (end = begin;
+           end < order.size() && laneOf(*m_jobs[order[end]]) == lane; end++) {
+        const auto &job = *m_jobs[order[end]];
+        ideal[order[end]] = static_cast<double>(job.work) *
+                            static_cast<double>(job.tasks.size() - job.next) /
+                            static_cast<double>(job.tasks.size());
+        totalWork += ideal[order[end]];
+      }
+      const double laneWorkers = static_cast<double>(free);
+      for (size_t k = begin; k < end; k++) {
+        ideal[order[k]] *= laneWorkers / totalWork;
+        if (free) {
+          shares[order[k]] = 1;
+          free--;
+        }
+      }
+      while (free) {
+        // Give the next worker to the job furthest below its ideal share.
+        size_t best = numJobs;
+        for (size_t k = begin; k < end; k++) {
+          const size_t j = order[k];
+          const auto &job = *m_jobs[j];
+          if (shares[j] == 0 || shares[j] >= job.tasks.size() - job.next)
+            continue;
+          if (best == numJobs ||
+              ideal[j] - shares[j] > ideal[best] - shares[best])
+            best = j;
+        }
+        if (best == numJobs)
+          break;
+        shares[best]++;
+        free--;
+      }
+    }
+
+    // Keep track of the jobs left without workers, and of when the first of
+    // them is due to be promoted.
+    m_nextPromotion = time_point_t::max();
+    for (size_t j : order) {
+      auto &job = *m_jobs[j];
+      if (shares[j]) {
+        job.starving = false;
+        continue;
+      }
+      if (!job.starving) {
+        job.starving = true;
+        job.starvingSince = now;
+      }
+      if (m_starvationLimit.count())
+        m_nextPromotion =
+            std::min(m_nextPromotion, job.starvingSince + m_starvationLimit);
+    }
+
+    // Workers stay on their job if it keeps enough of them, which keeps the
+    // data of the job in their caches. The others are reassigned.
+    std::vector<size_t> kept(numJobs, 0);
+    for (size_t w = 0; w < m_numThreads; w++) {
+      if (pinned[w])
+        continue;
+      for (size_t j : order) {
+        if (m_assignment[w] == m_jobs[j] && kept[j] < shares[j]) {
+          assignment[w] = m_jobs[j];
+          kept[j]++;
+          break;
+        }
+      }
+    }
+    size_t w = 0;
+    for (size_t j : order) {
+      for (; kept[j] < shares[j]; kept[j]++) {
+        while (pinned[w] || assignment[w])
+          w++;
+        assignment[w] = m_jobs[j];
+      }
+    }
+    m_assignment.swap(assignment);
+
+    for (size_t i = 0; i < m_numThreads; i++) {
+      if (m_assignment[i] && !m_hasRunner[i]) {
+        m_hasRunner[i] = true;
+        m_workerById[i]->schedule(
+            [this](size_t threadId) { run_jobs(threadId); });
+      }
+    }
+  }
+
+  // A job may be left without workers by jobs of higher priority for at most
+  // this long, in milliseconds, before it is served with them. Zero lets jobs
+  // starve for as long as there is work of higher priority.
+  static std::chrono::milliseconds get_starvation_limit() {
+    if (const char *envVar = std::getenv("UR_NATIVE_CPU_STARVATION_LIMIT_MS"))
+      return std::chrono::milliseconds(std::stoul(envVar));
+    return std::chrono::milliseconds(100);
+  }
+
   static size_t get_num_threads() {
     size_t numThreads;
     char *envVar = std::getenv("SYCL_NATIVE_CPU_HOST_THREADS");
@@ -190,6 +600,35 @@ private:
   std::atomic<bool> m_isRunning;
 
   const size_t m_numThreads;
+
+  // Whether each worker is pinned to a CPU of its own.
+  const bool m_isPinned;
+
+  const bool m_sharesEnabled;
+
+  const std::chrono::milliseconds m_starvationLimit;
+
+  using time_point_t = std::chrono::steady_clock::time_point;
+
+  // Guards the members below.
+  std::mutex m_jobsMutex;
+
+  // The jobs with tasks left to hand out, oldest first.
+  std::vector<job_ptr_t> m_jobs;
+
+  // The job each worker is running tasks of, if any.
+  std::vector<job_ptr_t> m_assignment;
+
+  // Whether run_jobs is scheduled or running on each worker.
+  std::vector<bool> m_hasRunner;
+
+  // Whether each worker is running a task of a cooperative job.
+  std::vector<bool> m_inCooperative;
+
+  // When the next starving job is due to be promoted, if any.
+  time_point_t m_nextPromotion = time_point_t::max();
+
+  std::vector<worker_thread *> m_workerById;
 };
 } // namespace detail
 
@@ -199,7 +638,18 @@ template <typename ThreadPoolT> class threadpool_interface {
 public:
   size_t num_threads() const noexcept { return threadpool.num_threads(); }
 
-  threadpool_interface() : threadpool() {}
+  bool is_pinned() const noexcept { return threadpool.is_pinned(); }
+
+  threadpool_interface(const std::vector<int> &cpus = {})
+      : threadpool(cpus) {}
+
+  void schedule_jobs(std::vector<job_ptr_t> &&jobs) {
+    threadpool.schedule_jobs(std::move(jobs));
+  }
+
+  void run_on_idle_workers(const worker_task_t &task) {
+    threadpool.run_on_idle_workers(task);
+  }
 
   auto schedule_task(worker_task_t &&task) {
     auto workerTask = std::make_shared<std::packaged_task<void(size_t)>>(
@@ -0,0 +1,367 @@
+//===--------- topology.cpp - Native CPU Adapter --------------------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "topology.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace {
+
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) ||          \
+    defined(__x86_64__) || defined(__i386__)
+#define NATIVE_CPU_HAS_CPUID 1
+
+// Returns false if the leaf isn't supported by the CPU.
+bool cpuid(uint32_t Leaf, uint32_t SubLeaf, uint32_t Regs[4]) {
+#if defined(_MSC_VER)
+  int Info[4];
+  __cpuid(Info, static_cast<int>(Leaf & 0x80000000u));
+  if (static_cast<uint32_t>(Info[0]) < Leaf)
+    return false;
+  __cpuidex(Info, static_cast<int>(Leaf), static_cast<int>(SubLeaf));
+  for (int I = 0; I < 4; I++)
+    Regs[I] = static_cast<uint32_t>(Info[I]);
+  return true;
+#else
+  unsigned Eax, Ebx, Ecx, Edx;
+  if (!__get_cpuid_count(Leaf, SubLeaf, &Eax, &Ebx, &Ecx, &Edx))
+    return false;
+  Regs[0] = Eax;
+  Regs[1] = Ebx;
+  Regs[2] = Ecx;
+  Regs[3] = Edx;
+  return true;
+#endif
+}
+
+// Returns the register state the OS saves on context switches, XCR0.
+uint64_t xgetbv() {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t Lo, Hi;
+  __asm__ volatile("xgetbv" : "=a"(Lo), "=d"(Hi) : "c"(0));
+  return (static_cast<uint64_t>(Hi) << 32) | Lo;
+#endif
+}
+#endif
+
+native_cpu::simd_widths_t detectSimdWidths() {
+  native_cpu::simd_widths_t Simd;
+#ifdef NATIVE_CPU_HAS_CPUID
+  uint32_t Leaf1[4], Leaf7[4] = {};
+  if (!cpuid(1, 0, Leaf1))
+    return Simd;
+  cpuid(7, 0, Leaf7);
+  // The AVX registers may only be used if the OS saves them.
+  const bool OSXSave = (Leaf1[2] >> 27) & 1;
+  const uint64_t XCR0 = OSXSave ? xgetbv() : 0;
+  const bool AVXState = (XCR0 & 0x6) == 0x6;
+  const bool AVX512State = AVXState && (XCR0 & 0xe0) == 0xe0;
+
+  const bool AVX = AVXState && ((Leaf1[2] >> 28) & 1);
+  const bool AVX2 = AVX && ((Leaf7[1] >> 5) & 1);
+  const bool AVX512F = AVX512State && ((Leaf7[1] >> 16) & 1);
+  const bool AVX512BW = AVX512F && ((Leaf7[1] >> 30) & 1);
+
+  if (AVX512F) {
+    Simd.Float = Simd.Int = 64;
+  } else if (AVX) {
+    Simd.Float = 32;
+    Simd.Int = AVX2 ? 32 : 16;
+  }
+  Simd.Byte = AVX512BW ? 64 : AVX2 ? 32 : 16;
+  Simd.NativeHalf = AVX512F && ((Leaf7[3] >> 23) & 1);
+#endif
+  // Elsewhere assume 128 bit vectors, which is what NEON and the SIMD
+  // extensions of the other architectures we run on provide.
+  return Simd;
+}
+
+#ifdef NATIVE_CPU_HAS_CPUID
+// Reads the deterministic cache parameters of CPUID leaf 4, or of leaf
+// 0x8000001D on AMD, for when sysfs isn't available.
+std::vector<native_cpu::cache_t> detectCpuidCaches() {
+  std::vector<native_cpu::cache_t> Caches;
+  for (uint32_t Leaf : {4u, 0x8000001du}) {
+    uint32_t Regs[4];
+    for (uint32_t Index = 0; cpuid(Leaf, Index, Regs); Index++) {
+      const uint32_t Type = Regs[0] & 0x1f;
+      if (Type == 0)
+        break;
+      // Skip instruction caches.
+      if (Type == 2)
+        continue;
+      const uint64_t Ways = ((Regs[1] >> 22) & 0x3ff) + 1;
+      const uint64_t Partitions = ((Regs[1] >> 12) & 0x3ff) + 1;
+      const uint32_t LineSize = (Regs[1] & 0xfff) + 1;
+      const uint64_t Sets = uint64_t{Regs[2]} + 1;
+      Caches.push_back({(Regs[0] >> 5) & 0x7,
+                        Ways * Partitions * LineSize * Sets, LineSize});
+    }
+    if (!Caches.empty())
+      break;
+  }
+  return Caches;
+}
+#endif
+
+#ifdef __linux__
+// Parses a Linux CPU or node list, e.g. "0-3,8,10-11".
+std::vector<int> parseCpuList(const std::string &List) {
+  std::vector<int> Ids;
+  std::stringstream Stream(List);
+  std::string Range;
+  while (std::getline(Stream, Range, ',')) {
+    int First = 0, Last = 0;
+    const int Matched = std::sscanf(Range.c_str(), "%d-%d", &First, &Last);
+    if (Matched < 1)
+      continue;
+    if (Matched == 1)
+      Last = First;
+    for (int Id = First; Id <= Last; Id++)
+      Ids.push_back(Id);
+  }
+  return Ids;
+}
+
+std::string readLine(const std::string &Path) {
+  std::ifstream File(Path);
+  std::string Line;
+  std::getline(File, Line);
+  return Line;
+}
+
+std::vector<int> readCpuList(const std::string &Path) {
+  return parseCpuList(readLine(Path));
+}
+
+// Returns the value of a "<Key>: <value> kB" line of a meminfo file, in
+// bytes, or zero if there is no such line.
+uint64_t readMeminfo(const std::string &Path, const std::string &Key) {
+  std::ifstream File(Path);
+  std::string Line;
+  while (std::getline(File, Line)) {
+    const size_t Pos = Line.find(Key + ":");
+    if (Pos == std::string::npos)
+      continue;
+    return std::strtoull(Line.c_str() + Pos + Key.size() + 1, nullptr, 10) *
+           1024;
+  }
+  return 0;
+}
+
+std::string nodePath(int Node) {
+  return "/sys/devices/system/node/node" + std::to_string(Node);
+}
+
+// Sizes in sysfs are given as e.g. "48K" or "2M".
+uint64_t parseCacheSize(const std::string &Size) {
+  char *End = nullptr;
+  uint64_t Value = std::strtoull(Size.c_str(), &End, 10);
+  switch (*End) {
+  case 'G':
+    Value *= 1024;
+    [[fallthrough]];
+  case 'M':
+    Value *= 1024;
+    [[fallthrough]];
+  case 'K':
+    Value *= 1024;
+    break;
+  default:
+    break;
+  }
+  return Value;
+}
+
+std::vector<native_cpu::cache_t> detectSysfsCaches(int Cpu) {
+  std::vector<native_cpu::cache_t> Caches;
+  const std::string Dir =
+      "/sys/devices/system/cpu/cpu" + std::to_string(Cpu) + "/cache/index";
+  for (int Index = 0;; Index++) {
+    const std::string Type = readLine(Dir + std::to_string(Index) + "/type");
+    if (Type.empty())
+      break;
+    if (Type == "Instruction")
+      continue;
+    const std::string Prefix = Dir + std::to_string(Index) + "/";
+    native_cpu::cache_t Cache;
+    Cache.Level = std::strtoul(readLine(Prefix + "level").c_str(), nullptr, 10);
+    Cache.Size = parseCacheSize(readLine(Prefix + "size"));
+    Cache.LineSize = std::strtoul(
+        readLine(Prefix + "coherency_line_size").c_str(), nullptr, 10);
+    if (Cache.Level && Cache.Size)
+      Caches.push_back(Cache);
+  }
+  return Caches;
+}
+#endif
+
+std::vector<int> detectAvailableCpus() {
+  std::vector<int> Cpus;
+#ifdef __linux__
+  cpu_set_t Set;
+  if (sched_getaffinity(0, sizeof(Set), &Set) == 0) {
+    for (int Cpu = 0; Cpu < CPU_SETSIZE; Cpu++) {
+      if (CPU_ISSET(Cpu, &Set))
+        Cpus.push_back(Cpu);
+    }
+  }
+#endif
+  if (Cpus.empty()) {
+    const int Count = std::max(1u, std::thread::hardware_concurrency());
+    for (int Cpu = 0; Cpu < Count; Cpu++)
+      Cpus.push_back(Cpu);
+  }
+  return Cpus;
+}
+
+} // namespace
+
+native_cpu::topology::topology() {
+  Cpus = detectAvailableCpus();
+  Simd = detectSimdWidths();
+
+#ifdef __linux__
+  for (int Node : readCpuList("/sys/devices/system/node/online")) {
+    NumaNodes.push_back({Node, readCpuList(nodePath(Node) + "/cpulist"),
+                         readMeminfo(nodePath(Node) + "/meminfo",
+                                     "Node " + std::to_string(Node) +
+                                         " MemTotal")});
+  }
+
+  // Rank every CPU by its NUMA node and by its position among the hardware
+  // threads of its core, so that compute units are spread over the physical
+  // cores before SMT siblings are used.
+  auto Rank = [&](int Cpu) {
+    size_t NodeIndex = 0;
+    while (NodeIndex < NumaNodes.size() &&
+           std::find(NumaNodes[NodeIndex].Cpus.begin(),
+                     NumaNodes[NodeIndex].Cpus.end(),
+                     Cpu) == NumaNodes[NodeIndex].Cpus.end())
+      NodeIndex++;
+    const std::vector<int> Siblings =
+        readCpuList("/sys/devices/system/cpu/cpu" + std::to_string(Cpu) +
+                    "/topology/thread_siblings_list");
+    const size_t Thread =
+        std::find(Siblings.begin(), Siblings.end(), Cpu) - Siblings.begin();
+    return std::make_pair(NodeIndex, Siblings.empty() ? 0 : Thread);
+  };
+  std::vector<std::pair<std::pair<size_t, size_t>, int>> Ranked;
+  for (int Cpu : Cpus)
+    Ranked.push_back({Rank(Cpu), Cpu});
+  std::sort(Ranked.begin(), Ranked.end());
+  for (size_t I = 0; I < Ranked.size(); I++)
+    Cpus[I] = Ranked[I].second;
+
+  Caches = detectSysfsCaches(Cpus.front());
+#endif
+#ifdef NATIVE_CPU_HAS_CPUID
+  if (Caches.empty())
+    Caches = detectCpuidCaches();
+#endif
+  std::stable_sort(
+      Caches.begin(), Caches.end(),
+      [](const cache_t &A, const cache_t &B) { return A.Level < B.Level; });
+
+  logger::debug("native_cpu: {} CPUs, {} NUMA nodes, L1d {} bytes, last "
+                "level cache {} bytes, {} byte SIMD",
+                Cpus.size(), NumaNodes.size(), getL1DataCacheSize(),
+                getLastLevelCacheSize(), Simd.Float);
+}
+
+uint64_t native_cpu::topology::getL1DataCacheSize() const {
+  return !Caches.empty() && Caches.front().Level == 1 ? Caches.front().Size
+                                                      : 0;
+}
+
+uint64_t native_cpu::topology::getLastLevelCacheSize() const {
+  return Caches.empty() ? 0 : Caches.back().Size;
+}
+
+uint32_t native_cpu::topology::getCachelineSize() const {
+  return Caches.empty() || !Caches.front().LineSize ? 64
+                                                    : Caches.front().LineSize;
+}
+
+std::vector<int>
+native_cpu::topology::getNodesOf(const std::vector<int> &CpuSet) const {
+  std::vector<int> Nodes;
+  for (const auto &Node : NumaNodes) {
+    if (std::any_of(CpuSet.begin(), CpuSet.end(), [&](int Cpu) {
+          return std::find(Node.Cpus.begin(), Node.Cpus.end(), Cpu) !=
+                 Node.Cpus.end();
+        }))
+      Nodes.push_back(Node.Id);
+  }
+  return Nodes;
+}
+
+uint64_t native_cpu::topology::getMemSize(const std::vector<int> &Nodes) const {
+  uint64_t Size = 0;
+  for (const auto &Node : NumaNodes) {
+    if (std::find(Nodes.begin(), Nodes.end(), Node.Id) == Nodes.end())
+      continue;
+    if (!Node.MemSize)
+      return 0;
+    Size += Node.MemSize;
+  }
+  return Size;
+}
+
+uint64_t
+native_cpu::topology::getFreeMemory(const std::vector<int> &Nodes) const {
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+  std::ignore = Nodes;
+  MEMORYSTATUSEX Status;
+  Status.dwLength = sizeof(Status);
+  return GlobalMemoryStatusEx(&Status)
+             ? static_cast<uint64_t>(Status.ullAvailPhys)
+             : 0;
+#elif defined(__linux__)
+  if (Nodes.empty())
+    return readMeminfo("/proc/meminfo", "MemAvailable");
+  // The nodes don't report the reclaimable memory, only what is unused.
+  uint64_t Free = 0;
+  for (int Node : Nodes) {
+    Free += readMeminfo(nodePath(Node) + "/meminfo",
+                        "Node " + std::to_string(Node) + " MemFree");
+  }
+  return Free;
+#else
+  std::ignore = Nodes;
+  return 0;
+#endif
+}
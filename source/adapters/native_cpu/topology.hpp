@@ -0,0 +1,78 @@
+//===--------- topology.hpp - Native CPU Adapter --------------------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace native_cpu {
+
+struct cache_t {
+  // 1 for the caches closest to the cores.
+  uint32_t Level;
+  uint64_t Size;
+  uint32_t LineSize;
+};
+
+struct numa_node_t {
+  int Id;
+  std::vector<int> Cpus;
+  // Zero if unknown.
+  uint64_t MemSize;
+};
+
+// Widths in bytes of the widest SIMD registers the OS lets us use.
+struct simd_widths_t {
+  uint32_t Float = 16;
+  // For 32 and 64 bit integers.
+  uint32_t Int = 16;
+  // For 8 and 16 bit integers.
+  uint32_t Byte = 16;
+  bool NativeHalf = false;
+};
+
+// The hardware the adapter runs on. It is read once, when the platform is
+// created, from /sys/devices/system on Linux and from CPUID on x86.
+class topology {
+public:
+  topology();
+
+  // The CPUs the process may run on, in the order compute units should be
+  // placed on them: grouped by NUMA node, and within a node with the first
+  // hardware thread of every core ahead of their SMT siblings.
+  const std::vector<int> &getCpus() const { return Cpus; }
+  // Empty if the NUMA layout can't be determined.
+  const std::vector<numa_node_t> &getNumaNodes() const { return NumaNodes; }
+  // The data and unified caches of the first CPU, ordered by level.
+  const std::vector<cache_t> &getCaches() const { return Caches; }
+  const simd_widths_t &getSimdWidths() const { return Simd; }
+
+  // Zero if there is no such cache.
+  uint64_t getL1DataCacheSize() const;
+  uint64_t getLastLevelCacheSize() const;
+  uint32_t getCachelineSize() const;
+
+  // Returns the ids of the NUMA nodes holding any of the given CPUs.
+  std::vector<int> getNodesOf(const std::vector<int> &CpuSet) const;
+  // Returns the memory of the given NUMA nodes, or zero if it is unknown.
+  uint64_t getMemSize(const std::vector<int> &Nodes) const;
+  // Returns the memory currently available, either on the given NUMA nodes
+  // or, if there are none, on the whole system. Zero if it is unknown.
+  uint64_t getFreeMemory(const std::vector<int> &Nodes) const;
+
+private:
+  std::vector<int> Cpus;
+  std::vector<numa_node_t> NumaNodes;
+  std::vector<cache_t> Caches;
+  simd_widths_t Simd;
+};
+
+} // namespace native_cpu
@@ -13,16 +13,288 @@
 
 #include "common.hpp"
 #include "context.hpp"
+#include "usm.hpp"
+#include <cstddef>
 #include <cstdlib>
+#include <string>
+
+#ifdef __linux__
+#include <fstream>
+#include <limits>
+#include <sys/mman.h>
+#endif
 
 namespace umf {
-ur_result_t getProviderNativeError(const char *, int32_t) {
-  return UR_RESULT_ERROR_UNKNOWN;
+ur_result_t getProviderNativeError(const char *, int32_t nativeError) {
+  // USMMemoryProvider reports ur_result_t values as its native errors.
+  return static_cast<ur_result_t>(nativeError);
 }
 } // namespace umf
 
+namespace native_cpu {
+
+std::optional<usm::DisjointPoolAllConfigs> initializeDisjointPoolConfig() {
+  const char *Disable = std::getenv("UR_NATIVE_CPU_DISABLE_USM_ALLOCATOR");
+  if (Disable != nullptr && Disable != std::string("")) {
+    return std::nullopt;
+  }
+
+  int PoolTrace = 0;
+  if (const char *TraceVal = std::getenv("UR_NATIVE_CPU_USM_ALLOCATOR_TRACE")) {
+    PoolTrace = std::atoi(TraceVal);
+  }
+
+  const char *ConfigVal = std::getenv("UR_NATIVE_CPU_USM_ALLOCATOR");
+  if (ConfigVal != nullptr) {
+    return usm::parseDisjointPoolConfig(ConfigVal, PoolTrace);
+  }
+
+  // The defaults are tuned for GPUs, where device and shared memory have
+  // different costs than host memory. Here all of them are host memory, so
+  // pool them all like host memory.
+  usm::DisjointPoolAllConfigs Configs(PoolTrace);
+  const auto &HostConfig = Configs.Configs[usm::DisjointPoolMemType::Host];
+  for (auto &Config : Configs.Configs) {
+    Config.MaxPoolableSize = HostConfig.MaxPoolableSize;
+    Config.Capacity = HostConfig.Capacity;
+    Config.SlabMinSize = HostConfig.SlabMinSize;
+    Config.MinBucketSize = HostConfig.MinBucketSize;
+  }
+  return Configs;
+}
+
+size_t getHugePageThreshold() {
+  if (const char *Threshold =
+          std::getenv("UR_NATIVE_CPU_USM_HUGE_PAGE_THRESHOLD")) {
+    return std::strtoull(Threshold, nullptr, 0);
+  }
+  // Below this the TLB reach of regular pages is usually enough, and the
+  // rounding up to a whole huge page would waste too much memory.
+  return size_t{32} << 20;
+}
+
+#ifdef __linux__
+// Returns the size of the default huge pages, which is also the size
+// transparent huge pages are made of.
+static size_t getHugePageSize() {
+  static const size_t HugePageSize = [] {
+    std::ifstream Meminfo("/proc/meminfo");
+    std::string Key;
+    size_t Value;
+    while (Meminfo >> Key >> Value) {
+      if (Key == "Hugepagesize:") {
+        return Value << 10;
+      }
+      Meminfo.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    return size_t{2} << 20;
+  }();
+  return HugePageSize;
+}
+
+void *USMMemoryProvider::mapHuge(size_t Size, size_t Align) {
+  const size_t HugePageSize = getHugePageSize();
+  const size_t Length = (Size + HugePageSize - 1) & ~(HugePageSize - 1);
+  void *Ptr = MAP_FAILED;
+  size_t PageSize = HugePageSize;
+
+#ifdef MAP_HUGETLB
+  // Explicit huge pages are only available if the administrator reserved
+  // some, but they are guaranteed when they are.
+  if (Align <= HugePageSize) {
+    Ptr = mmap(nullptr, Length, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  }
+#endif
+
+  if (Ptr == MAP_FAILED) {
+    // Otherwise ask for transparent huge pages. Those can only back the
+    // aligned huge pages of the mapping, so over-allocate and trim it to an
+    // aligned start.
+    const size_t Alignment = std::max(Align, HugePageSize);
+    const size_t MapLength = Length + Alignment;
+    void *Map = mmap(nullptr, MapLength, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (Map == MAP_FAILED) {
+      return nullptr;
+    }
+    const uintptr_t MapStart = reinterpret_cast<uintptr_t>(Map);
+    const uintptr_t Start = (MapStart + Alignment - 1) & ~(Alignment - 1);
+    if (Start != MapStart) {
+      munmap(Map, Start - MapStart);
+    }
+    if (Start + Length != MapStart + MapLength) {
+      munmap(reinterpret_cast<void *>(Start + Length),
+             MapStart + MapLength - (Start + Length));
+    }
+    Ptr = reinterpret_cast<void *>(Start);
+#ifdef MADV_HUGEPAGE
+    // This fails if transparent huge pages are disabled.
+    if (madvise(Ptr, Length, MADV_HUGEPAGE) != 0) {
+      PageSize = get_page_size();
+    }
+#else
+    PageSize = get_page_size();
+#endif
+  }
+
+  logger::debug("native_cpu: mapped {} bytes at {} with {} byte pages",
+                Length, Ptr, PageSize);
+  std::lock_guard<std::mutex> Lock(MappingsMutex);
+  Mappings.emplace(Ptr, mapping_t{Length, PageSize});
+  return Ptr;
+}
+#else
+void *USMMemoryProvider::mapHuge(size_t, size_t) { return nullptr; }
+#endif
+
+umf_result_t USMMemoryProvider::alloc(size_t Size, size_t Align, void **Ptr) {
+  Align = std::max<size_t>(Align, alignof(std::max_align_t));
+  if (HugePageThreshold != 0 && Size >= HugePageThreshold) {
+    if ((*Ptr = mapHuge(Size, Align))) {
+      return UMF_RESULT_SUCCESS;
+    }
+  }
+  // aligned_alloc requires the size to be a multiple of the alignment.
+  Size = (Size + Align - 1) & ~(Align - 1);
+  *Ptr = aligned_malloc(Align, Size);
+  if (*Ptr == nullptr) {
+    getLastStatusRef() = UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+    return UMF_RESULT_ERROR_MEMORY_PROVIDER_SPECIFIC;
+  }
+  return UMF_RESULT_SUCCESS;
+}
+
+umf_result_t USMMemoryProvider::free(void *Ptr, size_t Size) {
+  // The size is zero if the pool doesn't track it.
+  if (HugePageThreshold != 0 && (Size == 0 || Size >= HugePageThreshold)) {
+    std::unique_lock<std::mutex> Lock(MappingsMutex);
+    auto It = Mappings.find(Ptr);
+    if (It != Mappings.end()) {
+      const size_t Length = It->second.Length;
+      Mappings.erase(It);
+      Lock.unlock();
+#ifdef __linux__
+      munmap(Ptr, Length);
+#endif
+      return UMF_RESULT_SUCCESS;
+    }
+  }
+  aligned_free(Ptr);
+  return UMF_RESULT_SUCCESS;
+}
+
+void USMMemoryProvider::get_last_native_error(const char **ErrMsg,
+                                              int32_t *ErrCode) {
+  *ErrMsg = nullptr;
+  *ErrCode = static_cast<int32_t>(getLastStatusRef());
+}
+
+umf_result_t USMMemoryProvider::get_recommended_page_size(size_t,
+                                                          size_t *PageSize) {
+  *PageSize = get_page_size();
+  return UMF_RESULT_SUCCESS;
+}
+
+umf_result_t USMMemoryProvider::get_min_page_size(void *Ptr,
+                                                  size_t *PageSize) {
+  *PageSize = get_page_size();
+  if (Ptr) {
+    std::lock_guard<std::mutex> Lock(MappingsMutex);
+    auto It = Mappings.find(Ptr);
+    if (It != Mappings.end()) {
+      *PageSize = It->second.PageSize;
+    }
+  }
+  return UMF_RESULT_SUCCESS;
+}
+
+} // namespace native_cpu
+
+static usm::DisjointPoolMemType
+descToDisjoinPoolMemType(const usm::pool_descriptor &desc) {
+  switch (desc.type) {
+  case UR_USM_TYPE_HOST:
+    return usm::DisjointPoolMemType::Host;
+  case UR_USM_TYPE_DEVICE:
+    return usm::DisjointPoolMemType::Device;
+  case UR_USM_TYPE_SHARED:
+    return desc.deviceReadOnly ? usm::DisjointPoolMemType::SharedReadOnly
+                               : usm::DisjointPoolMemType::Shared;
+  default:
+    assert(0 && "Invalid pool descriptor type!");
+    // Added to suppress 'not all control paths return a value' warning.
+    return usm::DisjointPoolMemType::All;
+  }
+}
+
+static umf::provider_unique_handle_t makeProvider(size_t hugePageThreshold) {
+  auto [ret, provider] =
+      umf::memoryProviderMakeUnique<native_cpu::USMMemoryProvider>(
+          hugePageThreshold);
+  if (ret != UMF_RESULT_SUCCESS) {
+    throw umf::umf2urResult(ret);
+  }
+  return std::move(provider);
+}
+
+ur_usm_pool_handle_t_::ur_usm_pool_handle_t_(ur_context_handle_t hContext,
+                                             ur_usm_pool_desc_t *pPoolDesc)
+    : hContext(hContext),
+      zeroInit(pPoolDesc &&
+               (pPoolDesc->flags & UR_USM_POOL_FLAG_ZERO_INITIALIZE_BLOCK)),
+      disjointPoolConfigs(native_cpu::initializeDisjointPoolConfig()) {
+  if (disjointPoolConfigs.has_value()) {
+    if (auto limits = find_stype_node<ur_usm_pool_limits_desc_t>(pPoolDesc)) {
+      for (auto &config : disjointPoolConfigs.value().Configs) {
+        config.MaxPoolableSize = limits->maxPoolableSize;
+        config.SlabMinSize = limits->minDriverAllocSize;
+      }
+    }
+  } else {
+    // If pooling is disabled, do nothing.
+    logger::info("USM pooling is disabled. Skiping pool limits adjustment.");
+  }
+
+  // All memory types are host memory shared by every sub-device, so there is
+  // one pool per memory type rather than the per sub-device pools
+  // pool_descriptor::create would ask for.
+  std::vector<usm::pool_descriptor> descriptors;
+  descriptors.push_back({this, hContext, nullptr, UR_USM_TYPE_HOST, false});
+  descriptors.push_back(
+      {this, hContext, hContext->_device, UR_USM_TYPE_DEVICE, false});
+  descriptors.push_back(
+      {this, hContext, hContext->_device, UR_USM_TYPE_SHARED, false});
+  descriptors.push_back(
+      {this, hContext, hContext->_device, UR_USM_TYPE_SHARED, true});
+
+  const size_t hugePageThreshold = native_cpu::getHugePageThreshold();
+  for (auto &desc : descriptors) {
+    auto provider = makeProvider(hugePageThreshold);
+    if (disjointPoolConfigs.has_value()) {
+      auto &poolConfig =
+          disjointPoolConfigs.value().Configs[descToDisjoinPoolMemType(desc)];
+      poolManager.addPool(
+          desc, usm::makeDisjointPool(std::move(provider), poolConfig));
+    } else {
+      poolManager.addPool(desc, usm::makeProxyPool(std::move(provider)));
+    }
+  }
+}
+
+umf_memory_pool_handle_t
+ur_usm_pool_handle_t_::getUMFPool(ur_usm_type_t type, bool deviceReadOnly) {
+  ur_device_handle_t hDevice =
+      type == UR_USM_TYPE_HOST ? nullptr : hContext->_device;
+  auto pool = poolManager.getPool(usm::pool_descriptor{
+      this, hContext, hDevice, type,
+      type == UR_USM_TYPE_SHARED && deviceReadOnly});
+  return pool.value_or(nullptr);
+}
+
 static ur_result_t alloc_helper(ur_context_handle_t hContext,
-                                const ur_usm_desc_t *pUSMDesc, size_t size,
+                                const ur_usm_desc_t *pUSMDesc,
+                                ur_usm_pool_handle_t pool, size_t size,
                                 void **ppMem, ur_usm_type_t type) {
   auto alignment = (pUSMDesc && pUSMDesc->align) ? pUSMDesc->align : 1u;
   UR_ASSERT(isPowerOf2(alignment), UR_RESULT_ERROR_UNSUPPORTED_ALIGNMENT);
@@ -30,7 +302,12 @@ static ur_result_t alloc_helper(ur_context_handle_t hContext,
   // TODO: Check Max size when UR_DEVICE_INFO_MAX_MEM_ALLOC_SIZE is implemented
   UR_ASSERT(size > 0, UR_RESULT_ERROR_INVALID_USM_SIZE);
 
-  auto *ptr = hContext->add_alloc(alignment, type, size, nullptr);
+  bool deviceReadOnly = false;
+  if (auto devDesc = find_stype_node<ur_usm_device_desc_t>(pUSMDesc)) {
+    deviceReadOnly = devDesc->flags & UR_USM_DEVICE_MEM_FLAG_DEVICE_READ_ONLY;
+  }
+
+  auto *ptr = hContext->add_alloc(alignment, type, size, pool, deviceReadOnly);
   UR_ASSERT(ptr != nullptr, UR_RESULT_ERROR_OUT_OF_RESOURCES);
   *ppMem = ptr;
 
@@ -40,9 +317,7 @@ static ur_result_t alloc_helper(ur_context_handle_t hContext,
 UR_APIEXPORT ur_result_t UR_APICALL
 urUSMHostAlloc(ur_context_handle_t hContext, const ur_usm_desc_t *pUSMDesc,
                ur_usm_pool_handle_t pool, size_t size, void **ppMem) {
-  std::ignore = pool;
-
-  return alloc_helper(hContext, pUSMDesc, size, ppMem, UR_USM_TYPE_HOST);
+  return alloc_helper(hContext, pUSMDesc, pool, size, ppMem, UR_USM_TYPE_HOST);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
@@ -50,9 +325,9 @@ urUSMDeviceAlloc(ur_context_handle_t hContext, ur_device_handle_t hDevice,
                  const ur_usm_desc_t *pUSMDesc, ur_usm_pool_handle_t pool,
                  size_t size, void **ppMem) {
   std::ignore = hDevice;
-  std::ignore = pool;
 
-  return alloc_helper(hContext, pUSMDesc, size, ppMem, UR_USM_TYPE_DEVICE);
+  return alloc_helper(hContext, pUSMDesc, pool, size, ppMem,
+                      UR_USM_TYPE_DEVICE);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
@@ -60,9 +335,9 @@ urUSMSharedAlloc(ur_context_handle_t hContext, ur_device_handle_t hDevice,
                  const ur_usm_desc_t *pUSMDesc, ur_usm_pool_handle_t pool,
                  size_t size, void **ppMem) {
   std::ignore = hDevice;
-  std::ignore = pool;
 
-  return alloc_helper(hContext, pUSMDesc, size, ppMem, UR_USM_TYPE_SHARED);
+  return alloc_helper(hContext, pUSMDesc, pool, size, ppMem,
+                      UR_USM_TYPE_SHARED);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urUSMFree(ur_context_handle_t hContext,
@@ -83,16 +358,15 @@ urUSMGetMemAllocInfo(ur_context_handle_t hContext, const void *pMem,
 
   UR_ASSERT(pMem != nullptr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
   UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
-  if (propName == UR_USM_ALLOC_INFO_BASE_PTR) {
-    // TODO: logic to compute base ptr given ptr
-    DIE_NO_IMPLEMENTATION;
-  }
 
+  // pMem may point anywhere into the allocation.
   const native_cpu::usm_alloc_info &alloc_info =
       hContext->get_alloc_info_entry(pMem);
   switch (propName) {
   case UR_USM_ALLOC_INFO_TYPE:
     return ReturnValue(alloc_info.type);
+  case UR_USM_ALLOC_INFO_BASE_PTR:
+    return ReturnValue(alloc_info.base_ptr);
   case UR_USM_ALLOC_INFO_SIZE:
     return ReturnValue(alloc_info.size);
   case UR_USM_ALLOC_INFO_DEVICE:
@@ -107,51 +381,67 @@ urUSMGetMemAllocInfo(ur_context_handle_t hContext, const void *pMem,
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urUSMPoolCreate(ur_context_handle_t hContext, ur_usm_pool_desc_t *pPoolDesc,
-                ur_usm_pool_handle_t *ppPool) {
-  std::ignore = hContext;
-  std::ignore = pPoolDesc;
-  std::ignore = ppPool;
+                ur_usm_pool_handle_t *ppPool) try {
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pPoolDesc && ppPool, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
-  DIE_NO_IMPLEMENTATION;
+  *ppPool = new ur_usm_pool_handle_t_(hContext, pPoolDesc);
+  return UR_RESULT_SUCCESS;
+} catch (umf_result_t e) {
+  return umf::umf2urResult(e);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urUSMPoolRetain(ur_usm_pool_handle_t pPool) {
-  std::ignore = pPool;
+  UR_ASSERT(pPool, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
 
-  DIE_NO_IMPLEMENTATION;
+  pPool->incrementReferenceCount();
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urUSMPoolRelease(ur_usm_pool_handle_t pPool) {
-  std::ignore = pPool;
+  UR_ASSERT(pPool, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
 
-  DIE_NO_IMPLEMENTATION;
+  decrementOrDelete(pPool);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urUSMPoolGetInfo(ur_usm_pool_handle_t hPool, ur_usm_pool_info_t propName,
                  size_t propSize, void *pPropValue, size_t *pPropSizeRet) {
-  std::ignore = hPool;
-  std::ignore = propName;
-  std::ignore = propSize;
-  std::ignore = pPropValue;
-  std::ignore = pPropSizeRet;
+  UR_ASSERT(hPool, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
 
-  DIE_NO_IMPLEMENTATION;
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+  switch (propName) {
+  case UR_USM_POOL_INFO_REFERENCE_COUNT:
+    return ReturnValue(hPool->getReferenceCount());
+  case UR_USM_POOL_INFO_CONTEXT:
+    return ReturnValue(hPool->getContext());
+  default:
+    return UR_RESULT_ERROR_INVALID_ENUMERATION;
+  }
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urUSMImportExp(ur_context_handle_t Context,
-                                                   void *HostPtr, size_t Size) {
-  std::ignore = Context;
-  std::ignore = HostPtr;
-  std::ignore = Size;
-  DIE_NO_IMPLEMENTATION;
+                                                   void *HostPtr,
+                                                   size_t Size) try {
+  UR_ASSERT(Context, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(HostPtr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(Size > 0, UR_RESULT_ERROR_INVALID_SIZE);
+
+  // Device and host memory are the same, so the memory can be used in place.
+  return Context->import_alloc(HostPtr, Size);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urUSMReleaseExp(ur_context_handle_t Context,
                                                     void *HostPtr) {
-  std::ignore = Context;
-  std::ignore = HostPtr;
-  DIE_NO_IMPLEMENTATION;
+  UR_ASSERT(Context, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(HostPtr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+
+  return Context->release_import(HostPtr);
 }
@@ -0,0 +1,109 @@
+//===------------- usm.hpp - NATIVE CPU Adapter ---------------------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <ur_api.h>
+
+#include "common.hpp"
+
+#include <umf_helpers.hpp>
+#include <umf_pools/disjoint_pool_config_parser.hpp>
+#include <ur_pool_manager.hpp>
+
+namespace native_cpu {
+
+// Returns the disjoint pool configuration selected through the
+// UR_NATIVE_CPU_USM_ALLOCATOR environment variable, or std::nullopt if
+// pooling has been disabled.
+std::optional<usm::DisjointPoolAllConfigs> initializeDisjointPoolConfig();
+
+// Returns the size from which allocations are backed by huge pages, selected
+// through the UR_NATIVE_CPU_USM_HUGE_PAGE_THRESHOLD environment variable. Zero
+// means huge pages are disabled.
+size_t getHugePageThreshold();
+
+// UMF memory provider handing out host memory. Host, device and shared USM
+// allocations are all backed by it, they only differ in the pool serving
+// them.
+//
+// Allocations of at least the huge page threshold are mapped directly and
+// backed by huge pages where the system allows it, which saves TLB misses on
+// random accesses to large arrays.
+class USMMemoryProvider {
+  ur_result_t &getLastStatusRef() {
+    static thread_local ur_result_t LastStatus = UR_RESULT_SUCCESS;
+    return LastStatus;
+  }
+
+  struct mapping_t {
+    size_t Length;
+    size_t PageSize;
+  };
+
+  // Returns nullptr if huge pages can't be used, in which case the
+  // allocation falls back to the regular path.
+  void *mapHuge(size_t Size, size_t Align);
+
+  size_t HugePageThreshold = 0;
+  // The mappings made by mapHuge, indexed by their start address.
+  std::mutex MappingsMutex;
+  std::unordered_map<void *, mapping_t> Mappings;
+
+public:
+  umf_result_t initialize(size_t Threshold) {
+    HugePageThreshold = Threshold;
+    return UMF_RESULT_SUCCESS;
+  }
+  umf_result_t alloc(size_t Size, size_t Align, void **Ptr);
+  umf_result_t free(void *Ptr, size_t Size);
+  void get_last_native_error(const char **ErrMsg, int32_t *ErrCode);
+  umf_result_t get_recommended_page_size(size_t, size_t *PageSize);
+  umf_result_t get_min_page_size(void *, size_t *PageSize);
+  const char *get_name() { return "NativeCPU"; }
+  umf_result_t purge_lazy(void *, size_t) {
+    return UMF_RESULT_ERROR_NOT_SUPPORTED;
+  }
+  umf_result_t purge_force(void *, size_t) {
+    return UMF_RESULT_ERROR_NOT_SUPPORTED;
+  }
+  umf_result_t allocation_merge(void *, void *, size_t) {
+    return UMF_RESULT_ERROR_UNKNOWN;
+  }
+  umf_result_t allocation_split(void *, size_t, size_t) {
+    return UMF_RESULT_ERROR_UNKNOWN;
+  }
+};
+
+} // namespace native_cpu
+
+struct ur_usm_pool_handle_t_ : RefCounted {
+  // Throws a ur_result_t or umf_result_t if the pools can't be created.
+  ur_usm_pool_handle_t_(ur_context_handle_t hContext,
+                        ur_usm_pool_desc_t *pPoolDesc);
+
+  ur_context_handle_t getContext() const { return hContext; }
+
+  // Returns the UMF pool serving allocations of the given type.
+  umf_memory_pool_handle_t getUMFPool(ur_usm_type_t type, bool deviceReadOnly);
+
+  bool zeroInitialize() const { return zeroInit; }
+
+private:
+  ur_context_handle_t hContext;
+  bool zeroInit;
+  // The pools may refer to the shared limits owned by the configuration, so it
+  // must outlive them.
+  std::optional<usm::DisjointPoolAllConfigs> disjointPoolConfigs;
+  usm::pool_manager<usm::pool_descriptor> poolManager;
+};
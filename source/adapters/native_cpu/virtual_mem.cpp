@@ -12,43 +12,195 @@
 #include "context.hpp"
 #include "physical_mem.hpp"
 
+#ifdef __linux__
+#include <cerrno>
+#include <sys/mman.h>
+
+// Reserved ranges are inaccessible anonymous mappings that don't count
+// towards the commit limit. Mapping physical memory replaces part of them,
+// unmapping it puts the reservation back so the addresses stay reserved.
+static constexpr int ReservedFlags =
+    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+
+static int accessFlagsToProt(ur_virtual_mem_access_flags_t flags) {
+  if (flags & UR_VIRTUAL_MEM_ACCESS_FLAG_READ_WRITE)
+    return PROT_READ | PROT_WRITE;
+  if (flags & UR_VIRTUAL_MEM_ACCESS_FLAG_READ_ONLY)
+    return PROT_READ;
+  return PROT_NONE;
+}
+
+static ur_result_t errnoToResult(int error) {
+  switch (error) {
+  case ENOMEM:
+    return UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+  case EINVAL:
+    return UR_RESULT_ERROR_INVALID_VALUE;
+  default:
+    return UR_RESULT_ERROR_OUT_OF_RESOURCES;
+  }
+}
+#endif
+
 UR_APIEXPORT ur_result_t UR_APICALL urVirtualMemGranularityGetInfo(
-    ur_context_handle_t, ur_device_handle_t, ur_virtual_mem_granularity_info_t,
-    size_t, void *, size_t *) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_context_handle_t hContext, ur_device_handle_t hDevice,
+    ur_virtual_mem_granularity_info_t propName, size_t propSize,
+    void *pPropValue, size_t *pPropSizeRet) {
+  std::ignore = hDevice;
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+  switch (propName) {
+  case UR_VIRTUAL_MEM_GRANULARITY_INFO_MINIMUM:
+  case UR_VIRTUAL_MEM_GRANULARITY_INFO_RECOMMENDED:
+    // Anything page aligned can be mapped, and there is no cost to mapping
+    // at a finer grain than on GPUs.
+    return ReturnValue(native_cpu::get_page_size());
+  default:
+    return UR_RESULT_ERROR_INVALID_ENUMERATION;
+  }
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urVirtualMemReserve(ur_context_handle_t,
-                                                        const void *, size_t,
-                                                        void **) {
+UR_APIEXPORT ur_result_t UR_APICALL
+urVirtualMemReserve(ur_context_handle_t hContext, const void *pStart,
+                    size_t size, void **ppStart) {
+#ifdef __linux__
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(ppStart, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  // The start address is only a hint.
+  void *ptr =
+      mmap(const_cast<void *>(pStart), size, PROT_NONE, ReservedFlags, -1, 0);
+  if (ptr == MAP_FAILED)
+    return errnoToResult(errno);
+  hContext->virtualMemRanges.reserve(ptr, size);
+  *ppStart = ptr;
+  return UR_RESULT_SUCCESS;
+#else
+  std::ignore = hContext;
+  std::ignore = pStart;
+  std::ignore = size;
+  std::ignore = ppStart;
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+#endif
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urVirtualMemFree(ur_context_handle_t,
-                                                     const void *, size_t) {
+UR_APIEXPORT ur_result_t UR_APICALL urVirtualMemFree(
+    ur_context_handle_t hContext, const void *pStart, size_t size) {
+#ifdef __linux__
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pStart, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  // Anything else could be memory the adapter or the application is using.
+  UR_ASSERT(hContext->virtualMemRanges.is_reserved(pStart, size),
+            UR_RESULT_ERROR_INVALID_VALUE);
+  if (munmap(const_cast<void *>(pStart), size) != 0)
+    return errnoToResult(errno);
+  hContext->virtualMemRanges.release(pStart, size);
+  return UR_RESULT_SUCCESS;
+#else
+  std::ignore = hContext;
+  std::ignore = pStart;
+  std::ignore = size;
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+#endif
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urVirtualMemSetAccess(
-    ur_context_handle_t, const void *, size_t, ur_virtual_mem_access_flags_t) {
+UR_APIEXPORT ur_result_t UR_APICALL
+urVirtualMemSetAccess(ur_context_handle_t hContext, const void *pStart,
+                      size_t size, ur_virtual_mem_access_flags_t flags) {
+#ifdef __linux__
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pStart, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(!(flags & UR_VIRTUAL_MEM_ACCESS_FLAGS_MASK),
+            UR_RESULT_ERROR_INVALID_ENUMERATION);
+  // Changing the protection of an unmapped part of a reservation would make
+  // it usable as private anonymous memory.
+  UR_ASSERT(hContext->virtualMemRanges.is_mapped(pStart, size),
+            UR_RESULT_ERROR_INVALID_VALUE);
+  const int prot = accessFlagsToProt(flags);
+  if (mprotect(const_cast<void *>(pStart), size, prot) != 0)
+    return errnoToResult(errno);
+  hContext->virtualMemRanges.assign(pStart, size, flags);
+  return UR_RESULT_SUCCESS;
+#else
+  std::ignore = hContext;
+  std::ignore = pStart;
+  std::ignore = size;
+  std::ignore = flags;
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+#endif
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urVirtualMemMap(
-    ur_context_handle_t, const void *, size_t, ur_physical_mem_handle_t, size_t,
-    ur_virtual_mem_access_flags_t) {
+UR_APIEXPORT ur_result_t UR_APICALL
+urVirtualMemMap(ur_context_handle_t hContext, const void *pStart, size_t size,
+                ur_physical_mem_handle_t hPhysicalMem, size_t offset,
+                ur_virtual_mem_access_flags_t flags) {
+#ifdef __linux__
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(hPhysicalMem, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pStart, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(!(flags & UR_VIRTUAL_MEM_ACCESS_FLAGS_MASK),
+            UR_RESULT_ERROR_INVALID_ENUMERATION);
+  UR_ASSERT(offset <= hPhysicalMem->getSize() &&
+                size <= hPhysicalMem->getSize() - offset,
+            UR_RESULT_ERROR_INVALID_SIZE);
+  // MAP_FIXED would replace whatever is mapped at pStart.
+  UR_ASSERT(hContext->virtualMemRanges.is_reserved(pStart, size),
+            UR_RESULT_ERROR_INVALID_VALUE);
+  // Shared mappings of the same file see each other's writes, which is what
+  // lets several virtual ranges alias one physical allocation.
+  void *ptr = mmap(const_cast<void *>(pStart), size, accessFlagsToProt(flags),
+                   MAP_SHARED | MAP_FIXED, hPhysicalMem->getFd(),
+                   static_cast<off_t>(offset));
+  if (ptr == MAP_FAILED)
+    return errnoToResult(errno);
+  hContext->virtualMemRanges.assign(pStart, size, flags);
+  return UR_RESULT_SUCCESS;
+#else
+  std::ignore = hContext;
+  std::ignore = pStart;
+  std::ignore = size;
+  std::ignore = hPhysicalMem;
+  std::ignore = offset;
+  std::ignore = flags;
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+#endif
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urVirtualMemUnmap(ur_context_handle_t,
-                                                      const void *, size_t) {
+UR_APIEXPORT ur_result_t UR_APICALL urVirtualMemUnmap(
+    ur_context_handle_t hContext, const void *pStart, size_t size) {
+#ifdef __linux__
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pStart, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(hContext->virtualMemRanges.is_reserved(pStart, size),
+            UR_RESULT_ERROR_INVALID_VALUE);
+  void *ptr = mmap(const_cast<void *>(pStart), size, PROT_NONE,
+                   ReservedFlags | MAP_FIXED, -1, 0);
+  if (ptr == MAP_FAILED)
+    return errnoToResult(errno);
+  hContext->virtualMemRanges.assign(pStart, size, std::nullopt);
+  return UR_RESULT_SUCCESS;
+#else
+  std::ignore = hContext;
+  std::ignore = pStart;
+  std::ignore = size;
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+#endif
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urVirtualMemGetInfo(ur_context_handle_t,
-                                                        const void *, size_t,
-                                                        ur_virtual_mem_info_t,
-                                                        size_t, void *,
-                                                        size_t *) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+UR_APIEXPORT ur_result_t UR_APICALL urVirtualMemGetInfo(
+    ur_context_handle_t hContext, const void *pStart, size_t size,
+    ur_virtual_mem_info_t propName, size_t propSize, void *pPropValue,
+    size_t *pPropSizeRet) {
+  std::ignore = size;
+  UR_ASSERT(hContext, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pStart, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+  switch (propName) {
+  case UR_VIRTUAL_MEM_INFO_ACCESS_MODE: {
+    // Ranges that aren't mapped have no access.
+    auto flags = hContext->virtualMemRanges.find(pStart);
+    return ReturnValue(flags.value_or(ur_virtual_mem_access_flags_t{0}));
+  }
+  default:
+    return UR_RESULT_ERROR_INVALID_ENUMERATION;
+  }
 }
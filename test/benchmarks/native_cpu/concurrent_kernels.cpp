@@ -0,0 +1,88 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Measures the throughput of independent kernels launched on an out-of-order
+// queue, from one up to --max-kernels at a time. Concurrent launches are
+// given disjoint shares of the device's workers, run with
+// UR_NATIVE_CPU_DISABLE_WORKER_SHARES=1 to compare against all the workers
+// picking tasks from every launch.
+//
+// Usage: bench-native-cpu-concurrent-kernels [--max-kernels N] [--groups N]
+//                                            [--block N] [--passes N]
+//                                            [--iterations N]
+
+#include <cstdint>
+
+#include "helpers.hpp"
+
+int main(int argc, char **argv) {
+  const size_t MaxKernels = bench::get_arg(argc, argv, "--max-kernels", 8);
+  const uint64_t Groups = bench::get_arg(argc, argv, "--groups", 64);
+  const uint64_t Block = bench::get_arg(argc, argv, "--block", 4096);
+  const uint64_t Passes = bench::get_arg(argc, argv, "--passes", 16);
+  const size_t Iterations = bench::get_arg(argc, argv, "--iterations", 20);
+  const size_t LocalSize = 4;
+
+  bench::environment Env;
+
+  ur_program_handle_t Program = bench::create_program(Env);
+
+  ur_queue_properties_t Properties{
+      UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+      UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE};
+  ur_queue_handle_t Queue = nullptr;
+  BENCH_CHECK(urQueueCreate(Env.context, Env.device, &Properties, &Queue));
+
+  // Every kernel works on its own buffer, so none of them depend on another.
+  std::vector<ur_kernel_handle_t> Kernels(MaxKernels);
+  std::vector<float *> Buffers(MaxKernels);
+  for (size_t K = 0; K < MaxKernels; K++) {
+    BENCH_CHECK(urUSMDeviceAlloc(Env.context, Env.device, nullptr, nullptr,
+                                 Groups * Block * sizeof(float),
+                                 reinterpret_cast<void **>(&Buffers[K])));
+    for (uint64_t I = 0; I < Groups * Block; I++) {
+      Buffers[K][I] = 1.0f;
+    }
+    BENCH_CHECK(urKernelCreate(Program, "scale", &Kernels[K]));
+    BENCH_CHECK(urKernelSetArgPointer(Kernels[K], 0, nullptr, Buffers[K]));
+    BENCH_CHECK(
+        urKernelSetArgValue(Kernels[K], 1, sizeof(Block), nullptr, &Block));
+    BENCH_CHECK(
+        urKernelSetArgValue(Kernels[K], 2, sizeof(Passes), nullptr, &Passes));
+  }
+
+  const size_t GlobalOffset = 0;
+  const size_t GlobalSize = Groups * LocalSize;
+  auto launch = [&](size_t Count) {
+    for (size_t K = 0; K < Count; K++) {
+      BENCH_CHECK(urEnqueueKernelLaunch(Queue, Kernels[K], 1, &GlobalOffset,
+                                        &GlobalSize, &LocalSize, 0, nullptr,
+                                        nullptr));
+    }
+    BENCH_CHECK(urQueueFinish(Queue));
+  };
+
+  std::printf("%10s %14s %14s\n", "kernels", "ms/batch", "kernels/s");
+  for (size_t Count = 1; Count <= MaxKernels; Count++) {
+    // Warm up the launch plan caches and the workers.
+    launch(Count);
+    const auto Start = std::chrono::steady_clock::now();
+    for (size_t I = 0; I < Iterations; I++) {
+      launch(Count);
+    }
+    const double Elapsed = bench::seconds_since(Start);
+    std::printf("%10zu %14.3f %14.1f\n", Count, Elapsed * 1e3 / Iterations,
+                Count * Iterations / Elapsed);
+  }
+
+  for (size_t K = 0; K < MaxKernels; K++) {
+    BENCH_CHECK(urKernelRelease(Kernels[K]));
+    BENCH_CHECK(urUSMFree(Env.context, Buffers[K]));
+  }
+  BENCH_CHECK(urQueueRelease(Queue));
+  BENCH_CHECK(urProgramRelease(Program));
+  return 0;
+}
@@ -0,0 +1,143 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef UR_NATIVE_CPU_BENCHMARK_HELPERS_HPP
+#define UR_NATIVE_CPU_BENCHMARK_HELPERS_HPP 1
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <ur_api.h>
+
+#include "nativecpu_state.hpp"
+
+namespace bench {
+
+#define BENCH_CHECK(Call)                                                      \
+  do {                                                                         \
+    ur_result_t Result = (Call);                                               \
+    if (Result != UR_RESULT_SUCCESS) {                                         \
+      std::fprintf(stderr, "%s:%d: %s failed with %d\n", __FILE__, __LINE__,  \
+                   #Call, static_cast<int>(Result));                           \
+      std::exit(1);                                                            \
+    }                                                                          \
+  } while (0)
+
+// Loads the native_cpu adapter through the loader and creates a context on
+// its device.
+struct environment {
+  std::vector<ur_adapter_handle_t> adapters;
+  ur_platform_handle_t platform = nullptr;
+  ur_device_handle_t device = nullptr;
+  ur_context_handle_t context = nullptr;
+
+  environment() {
+    BENCH_CHECK(urLoaderInit(0, nullptr));
+    uint32_t AdapterCount = 0;
+    BENCH_CHECK(urAdapterGet(0, nullptr, &AdapterCount));
+    adapters.resize(AdapterCount);
+    BENCH_CHECK(urAdapterGet(AdapterCount, adapters.data(), nullptr));
+
+    uint32_t PlatformCount = 0;
+    BENCH_CHECK(urPlatformGet(adapters.data(), AdapterCount, 0, nullptr,
+                              &PlatformCount));
+    std::vector<ur_platform_handle_t> Platforms(PlatformCount);
+    BENCH_CHECK(urPlatformGet(adapters.data(), AdapterCount, PlatformCount,
+                              Platforms.data(), nullptr));
+    for (auto Platform : Platforms) {
+      ur_platform_backend_t Backend;
+      BENCH_CHECK(urPlatformGetInfo(Platform, UR_PLATFORM_INFO_BACKEND,
+                                    sizeof(Backend), &Backend, nullptr));
+      if (Backend == UR_PLATFORM_BACKEND_NATIVE_CPU) {
+        platform = Platform;
+        break;
+      }
+    }
+    if (!platform) {
+      std::fprintf(stderr, "No native_cpu platform found, try setting "
+                           "UR_ADAPTERS_FORCE_LOAD\n");
+      std::exit(1);
+    }
+
+    BENCH_CHECK(urDeviceGet(platform, UR_DEVICE_TYPE_ALL, 1, &device, nullptr));
+    BENCH_CHECK(urContextCreate(1, &device, nullptr, &context));
+  }
+
+  ~environment() {
+    urContextRelease(context);
+    for (auto Adapter : adapters) {
+      urAdapterRelease(Adapter);
+    }
+    urLoaderTearDown();
+  }
+};
+
+// Returns the value following Name on the command line, or Default.
+inline size_t get_arg(int argc, char **argv, const char *Name,
+                      size_t Default) {
+  for (int I = 1; I + 1 < argc; I++) {
+    if (std::strcmp(argv[I], Name) == 0) {
+      return std::strtoull(argv[I + 1], nullptr, 0);
+    }
+  }
+  return Default;
+}
+
+// The benchmarks' kernels are entries of an in-process kernel table rather
+// than a compiled SYCL program, so the adapter calls them once per work-item.
+
+inline void empty(void *const *, native_cpu::state *) {}
+
+// Takes a float pointer Data and uint64_t values Block and Passes, and makes
+// Passes passes over the Block floats of Data owned by each work-group. Only
+// the first work-item of each work-group does any work, so that the cost of a
+// launch doesn't depend on whether the adapter calls the kernel once per
+// work-item or once per work-group.
+inline void scale(void *const *Args, native_cpu::state *State) {
+  if (State->MLocal_id[0] != 0) {
+    return;
+  }
+  float *Data = static_cast<float *>(Args[0]);
+  const uint64_t Block = *static_cast<const uint64_t *>(Args[1]);
+  const uint64_t Passes = *static_cast<const uint64_t *>(Args[2]);
+  float *First = Data + State->MWorkGroup_id[0] * Block;
+  for (uint64_t Pass = 0; Pass < Passes; Pass++) {
+    for (uint64_t I = 0; I < Block; I++) {
+      First[I] = First[I] * 0.999f + 1.0f;
+    }
+  }
+}
+
+inline const nativecpu_entry KernelTable[] = {
+    {"empty", reinterpret_cast<const unsigned char *>(&empty)},
+    {"scale", reinterpret_cast<const unsigned char *>(&scale)},
+    {nullptr, nullptr}};
+
+// Creates and builds a program holding the kernels above.
+inline ur_program_handle_t create_program(environment &Env) {
+  const uint8_t *Binary = reinterpret_cast<const uint8_t *>(KernelTable);
+  size_t BinarySize = sizeof(KernelTable);
+  ur_program_handle_t Program = nullptr;
+  BENCH_CHECK(urProgramCreateWithBinary(Env.context, 1, &Env.device,
+                                        &BinarySize, &Binary, nullptr,
+                                        &Program));
+  BENCH_CHECK(urProgramBuild(Env.context, Program, nullptr));
+  return Program;
+}
+
+inline double seconds_since(std::chrono::steady_clock::time_point Start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       Start)
+      .count();
+}
+
+} // namespace bench
+
+#endif // UR_NATIVE_CPU_BENCHMARK_HELPERS_HPP
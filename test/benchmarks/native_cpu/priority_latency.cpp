@@ -0,0 +1,149 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Measures the latency of small kernels launched on a high priority queue
+// while a low priority queue keeps the device saturated with large kernels.
+// Run with --priorities 0 to create both queues without a priority, and with
+// UR_NATIVE_CPU_STARVATION_LIMIT_MS to see how often the low priority work is
+// allowed to make progress.
+//
+// Usage: bench-native-cpu-priority-latency [--samples N] [--backlog N]
+//                                          [--groups N] [--block N]
+//                                          [--passes N] [--priorities 0|1]
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <thread>
+
+#include "helpers.hpp"
+
+namespace {
+
+struct launch {
+  ur_kernel_handle_t Kernel = nullptr;
+  float *Data = nullptr;
+  size_t GlobalSize = 0;
+};
+
+launch makeLaunch(bench::environment &Env, ur_program_handle_t Program,
+                  uint64_t Groups, uint64_t Block, uint64_t Passes,
+                  size_t LocalSize) {
+  launch Launch;
+  BENCH_CHECK(urUSMDeviceAlloc(Env.context, Env.device, nullptr, nullptr,
+                               Groups * Block * sizeof(float),
+                               reinterpret_cast<void **>(&Launch.Data)));
+  std::fill(Launch.Data, Launch.Data + Groups * Block, 1.0f);
+  BENCH_CHECK(urKernelCreate(Program, "scale", &Launch.Kernel));
+  BENCH_CHECK(urKernelSetArgPointer(Launch.Kernel, 0, nullptr, Launch.Data));
+  BENCH_CHECK(
+      urKernelSetArgValue(Launch.Kernel, 1, sizeof(Block), nullptr, &Block));
+  BENCH_CHECK(
+      urKernelSetArgValue(Launch.Kernel, 2, sizeof(Passes), nullptr, &Passes));
+  Launch.GlobalSize = Groups * LocalSize;
+  return Launch;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t Samples = bench::get_arg(argc, argv, "--samples", 1000);
+  const size_t Backlog = bench::get_arg(argc, argv, "--backlog", 4);
+  const uint64_t Groups = bench::get_arg(argc, argv, "--groups", 256);
+  const uint64_t Block = bench::get_arg(argc, argv, "--block", 4096);
+  const uint64_t Passes = bench::get_arg(argc, argv, "--passes", 64);
+  const bool Priorities = bench::get_arg(argc, argv, "--priorities", 1);
+  const size_t LocalSize = 4;
+  const size_t GlobalOffset = 0;
+
+  bench::environment Env;
+
+  ur_program_handle_t Program = bench::create_program(Env);
+
+  ur_queue_flags_t LowFlags = UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE;
+  ur_queue_flags_t HighFlags = 0;
+  if (Priorities) {
+    LowFlags |= UR_QUEUE_FLAG_PRIORITY_LOW;
+    HighFlags |= UR_QUEUE_FLAG_PRIORITY_HIGH;
+  }
+  ur_queue_properties_t LowProperties{UR_STRUCTURE_TYPE_QUEUE_PROPERTIES,
+                                      nullptr, LowFlags};
+  ur_queue_properties_t HighProperties{UR_STRUCTURE_TYPE_QUEUE_PROPERTIES,
+                                       nullptr, HighFlags};
+  ur_queue_handle_t LowQueue = nullptr;
+  ur_queue_handle_t HighQueue = nullptr;
+  BENCH_CHECK(
+      urQueueCreate(Env.context, Env.device, &LowProperties, &LowQueue));
+  BENCH_CHECK(
+      urQueueCreate(Env.context, Env.device, &HighProperties, &HighQueue));
+
+  launch Bulk = makeLaunch(Env, Program, Groups, Block, Passes, LocalSize);
+  launch Small = makeLaunch(Env, Program, 4, Block, 1, LocalSize);
+
+  // Keeps Backlog large kernels in flight until the measurement is over.
+  std::atomic<bool> Done{false};
+  std::atomic<size_t> BulkLaunches{0};
+  std::thread Saturate([&] {
+    std::deque<ur_event_handle_t> InFlight;
+    while (!Done.load(std::memory_order_relaxed)) {
+      ur_event_handle_t Event = nullptr;
+      BENCH_CHECK(urEnqueueKernelLaunch(LowQueue, Bulk.Kernel, 1,
+                                        &GlobalOffset, &Bulk.GlobalSize,
+                                        &LocalSize, 0, nullptr, &Event));
+      InFlight.push_back(Event);
+      if (InFlight.size() >= Backlog) {
+        BENCH_CHECK(urEventWait(1, &InFlight.front()));
+        BENCH_CHECK(urEventRelease(InFlight.front()));
+        InFlight.pop_front();
+        BulkLaunches++;
+      }
+    }
+    for (auto Event : InFlight) {
+      BENCH_CHECK(urEventWait(1, &Event));
+      BENCH_CHECK(urEventRelease(Event));
+      BulkLaunches++;
+    }
+  });
+
+  // Let the low priority work occupy all the workers first.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::vector<double> Latencies(Samples);
+  const auto Start = std::chrono::steady_clock::now();
+  for (size_t I = 0; I < Samples; I++) {
+    const auto LaunchStart = std::chrono::steady_clock::now();
+    BENCH_CHECK(urEnqueueKernelLaunch(HighQueue, Small.Kernel, 1,
+                                      &GlobalOffset, &Small.GlobalSize,
+                                      &LocalSize, 0, nullptr, nullptr));
+    BENCH_CHECK(urQueueFinish(HighQueue));
+    Latencies[I] = bench::seconds_since(LaunchStart);
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+  const double Elapsed = bench::seconds_since(Start);
+  Done = true;
+  Saturate.join();
+
+  std::sort(Latencies.begin(), Latencies.end());
+  auto percentile = [&](double P) {
+    return Latencies[std::min(Samples - 1, static_cast<size_t>(P * Samples))] *
+           1e6;
+  };
+  std::printf("%12s %12s %12s %12s %16s\n", "priorities", "p50 (us)",
+              "p99 (us)", "max (us)", "bulk kernels/s");
+  std::printf("%12s %12.1f %12.1f %12.1f %16.1f\n", Priorities ? "on" : "off",
+              percentile(0.5), percentile(0.99), Latencies.back() * 1e6,
+              BulkLaunches / Elapsed);
+
+  for (launch *Launch : {&Bulk, &Small}) {
+    BENCH_CHECK(urKernelRelease(Launch->Kernel));
+    BENCH_CHECK(urUSMFree(Env.context, Launch->Data));
+  }
+  BENCH_CHECK(urQueueRelease(HighQueue));
+  BENCH_CHECK(urQueueRelease(LowQueue));
+  BENCH_CHECK(urProgramRelease(Program));
+  return 0;
+}
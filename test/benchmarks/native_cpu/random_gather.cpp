@@ -0,0 +1,55 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Measures random gathers from a large shared USM allocation, which are
+// dominated by TLB misses unless the allocation is backed by huge pages. Run
+// with UR_NATIVE_CPU_USM_HUGE_PAGE_THRESHOLD=0 to compare against regular
+// pages, and with UR_LOG_NATIVE_CPU="level:debug;output:stderr" to see the
+// page size backing the allocation.
+//
+// Usage: bench-native-cpu-random-gather [--size-mb N] [--gathers N]
+
+#include <cstdint>
+
+#include "helpers.hpp"
+
+int main(int argc, char **argv) {
+  const size_t SizeMB = bench::get_arg(argc, argv, "--size-mb", 1024);
+  const size_t Gathers = bench::get_arg(argc, argv, "--gathers", 1 << 24);
+  const size_t Elements = (SizeMB << 20) / sizeof(uint64_t);
+
+  bench::environment Env;
+
+  uint64_t *Data = nullptr;
+  BENCH_CHECK(urUSMSharedAlloc(Env.context, Env.device, nullptr, nullptr,
+                               Elements * sizeof(uint64_t),
+                               reinterpret_cast<void **>(&Data)));
+  // Touch everything first so that page faults aren't measured.
+  for (size_t I = 0; I < Elements; I++) {
+    Data[I] = I;
+  }
+
+  // A xorshift generator is cheap enough not to hide the memory latency.
+  uint64_t State = 0x9e3779b97f4a7c15ull;
+  uint64_t Sum = 0;
+  const auto Start = std::chrono::steady_clock::now();
+  for (size_t I = 0; I < Gathers; I++) {
+    State ^= State << 13;
+    State ^= State >> 7;
+    State ^= State << 17;
+    Sum += Data[State % Elements];
+  }
+  const double Elapsed = bench::seconds_since(Start);
+
+  std::printf("%12s %14s %12s\n", "size (MiB)", "gathers", "ns/gather");
+  std::printf("%12zu %14zu %12.2f\n", SizeMB, Gathers,
+              Elapsed * 1e9 / Gathers);
+  // Keep the loop from being optimized away.
+  std::fprintf(stderr, "checksum %llu\n", static_cast<unsigned long long>(Sum));
+
+  BENCH_CHECK(urUSMFree(Env.context, Data));
+  return 0;
+}
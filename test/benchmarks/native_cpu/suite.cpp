@@ -0,0 +1,323 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// The native_cpu benchmark suite: launch latency and throughput, ND-range
+// scaling, copy, fill and rect-copy bandwidth, event and USM allocation
+// costs. Every case is run --repetitions times after a warm-up run, and the
+// median is printed as a CSV row of name, value and unit, which is what the
+// NativeCPU suite of scripts/benchmarks parses. Cases are named
+// group/configuration, --filter only runs those whose name contains the given
+// string and --list prints the names and units of the cases.
+//
+// Usage: bench-native-cpu-suite [--filter STRING] [--list]
+//                               [--repetitions N] [--scale N]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+#include "helpers.hpp"
+
+namespace {
+
+// What the cases share: a queue on the device and an empty kernel.
+struct fixture {
+  bench::environment &Env;
+  ur_program_handle_t Program = nullptr;
+  ur_kernel_handle_t Kernel = nullptr;
+  ur_queue_handle_t Queue = nullptr;
+  // In-order queues wait for kernels as they are launched, throughput is
+  // measured on an out-of-order one.
+  ur_queue_handle_t OutOfOrderQueue = nullptr;
+  // Multiplies the number of iterations of every case.
+  size_t Scale;
+
+  fixture(bench::environment &Env, size_t Scale) : Env(Env), Scale(Scale) {
+    Program = bench::create_program(Env);
+    BENCH_CHECK(urKernelCreate(Program, "empty", &Kernel));
+    BENCH_CHECK(urQueueCreate(Env.context, Env.device, nullptr, &Queue));
+    ur_queue_properties_t Properties{
+        UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+        UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE};
+    BENCH_CHECK(urQueueCreate(Env.context, Env.device, &Properties,
+                              &OutOfOrderQueue));
+  }
+
+  ~fixture() {
+    urQueueRelease(OutOfOrderQueue);
+    urQueueRelease(Queue);
+    urKernelRelease(Kernel);
+    urProgramRelease(Program);
+  }
+
+  void launch(ur_queue_handle_t Target, size_t GlobalSize) {
+    const size_t GlobalOffset = 0;
+    BENCH_CHECK(urEnqueueKernelLaunch(Target, Kernel, 1, &GlobalOffset,
+                                      &GlobalSize, nullptr, 0, nullptr,
+                                      nullptr));
+  }
+
+  void *deviceAlloc(size_t Size) {
+    void *Ptr = nullptr;
+    BENCH_CHECK(urUSMDeviceAlloc(Env.context, Env.device, nullptr, nullptr,
+                                 Size, &Ptr));
+    return Ptr;
+  }
+
+  ur_mem_handle_t buffer(size_t Size) {
+    ur_mem_handle_t Buffer = nullptr;
+    BENCH_CHECK(urMemBufferCreate(Env.context, UR_MEM_FLAG_READ_WRITE, Size,
+                                  nullptr, &Buffer));
+    return Buffer;
+  }
+};
+
+struct bench_case {
+  std::string Name;
+  const char *Unit;
+  // Returns the value of one run of the case.
+  std::function<double(fixture &)> Run;
+};
+
+constexpr size_t KiB = size_t{1} << 10;
+constexpr size_t MiB = size_t{1} << 20;
+
+// Returns the bandwidth in GB/s of moving Bytes Iterations times in Seconds.
+double bandwidth(size_t Bytes, size_t Iterations, double Seconds) {
+  return static_cast<double>(Bytes) * Iterations / Seconds * 1e-9;
+}
+
+std::vector<bench_case> makeCases() {
+  std::vector<bench_case> Cases;
+
+  // Submission to completion of a kernel that does nothing, on an in-order
+  // queue that is waited for after every launch.
+  Cases.push_back({"launch_latency/empty", "us", [](fixture &F) {
+                     const size_t Iterations = 1000 * F.Scale;
+                     const auto Start = std::chrono::steady_clock::now();
+                     for (size_t I = 0; I < Iterations; I++) {
+                       F.launch(F.Queue, 1);
+                       BENCH_CHECK(urQueueFinish(F.Queue));
+                     }
+                     return bench::seconds_since(Start) * 1e6 / Iterations;
+                   }});
+
+  // Independent launches back to back, waited for at the end.
+  Cases.push_back({"launch_throughput/empty", "launches/s", [](fixture &F) {
+                     const size_t Iterations = 10000 * F.Scale;
+                     const auto Start = std::chrono::steady_clock::now();
+                     for (size_t I = 0; I < Iterations; I++) {
+                       F.launch(F.OutOfOrderQueue, 1);
+                     }
+                     BENCH_CHECK(urQueueFinish(F.OutOfOrderQueue));
+                     return Iterations / bench::seconds_since(Start);
+                   }});
+
+  // How the cost of an empty launch grows with the number of work-items, with
+  // the adapter picking the work-group size.
+  for (size_t Log2Size : {0, 10, 14, 18, 22}) {
+    const size_t GlobalSize = size_t{1} << Log2Size;
+    Cases.push_back({"nd_range/" + std::to_string(GlobalSize), "us",
+                     [GlobalSize](fixture &F) {
+                       const size_t Iterations = 100 * F.Scale;
+                       const auto Start = std::chrono::steady_clock::now();
+                       for (size_t I = 0; I < Iterations; I++) {
+                         F.launch(F.Queue, GlobalSize);
+                         BENCH_CHECK(urQueueFinish(F.Queue));
+                       }
+                       return bench::seconds_since(Start) * 1e6 / Iterations;
+                     }});
+  }
+
+  for (size_t Size : {64 * KiB, 64 * MiB}) {
+    const std::string Config =
+        Size >= MiB ? std::to_string(Size / MiB) + "MiB"
+                    : std::to_string(Size / KiB) + "KiB";
+    const size_t Iterations = std::max<size_t>(1, 256 * MiB / Size) * 4;
+
+    Cases.push_back({"memcpy/usm_" + Config, "GB/s", [=](fixture &F) {
+                       void *Src = F.deviceAlloc(Size);
+                       void *Dst = F.deviceAlloc(Size);
+                       const size_t N = Iterations * F.Scale;
+                       const auto Start = std::chrono::steady_clock::now();
+                       for (size_t I = 0; I < N; I++) {
+                         BENCH_CHECK(urEnqueueUSMMemcpy(F.Queue, true, Dst,
+                                                        Src, Size, 0, nullptr,
+                                                        nullptr));
+                       }
+                       const double Seconds = bench::seconds_since(Start);
+                       BENCH_CHECK(urUSMFree(F.Env.context, Src));
+                       BENCH_CHECK(urUSMFree(F.Env.context, Dst));
+                       return bandwidth(Size, N, Seconds);
+                     }});
+
+    Cases.push_back({"memcpy/buffer_" + Config, "GB/s", [=](fixture &F) {
+                       ur_mem_handle_t Src = F.buffer(Size);
+                       ur_mem_handle_t Dst = F.buffer(Size);
+                       const size_t N = Iterations * F.Scale;
+                       const auto Start = std::chrono::steady_clock::now();
+                       for (size_t I = 0; I < N; I++) {
+                         BENCH_CHECK(urEnqueueMemBufferCopy(
+                             F.Queue, Src, Dst, 0, 0, Size, 0, nullptr,
+                             nullptr));
+                       }
+                       BENCH_CHECK(urQueueFinish(F.Queue));
+                       const double Seconds = bench::seconds_since(Start);
+                       BENCH_CHECK(urMemRelease(Src));
+                       BENCH_CHECK(urMemRelease(Dst));
+                       return bandwidth(Size, N, Seconds);
+                     }});
+
+    Cases.push_back({"fill/usm_" + Config, "GB/s", [=](fixture &F) {
+                       void *Dst = F.deviceAlloc(Size);
+                       const uint32_t Pattern = 0x12345678;
+                       const size_t N = Iterations * F.Scale;
+                       const auto Start = std::chrono::steady_clock::now();
+                       for (size_t I = 0; I < N; I++) {
+                         BENCH_CHECK(urEnqueueUSMFill(
+                             F.Queue, Dst, sizeof(Pattern), &Pattern, Size, 0,
+                             nullptr, nullptr));
+                       }
+                       BENCH_CHECK(urQueueFinish(F.Queue));
+                       const double Seconds = bench::seconds_since(Start);
+                       BENCH_CHECK(urUSMFree(F.Env.context, Dst));
+                       return bandwidth(Size, N, Seconds);
+                     }});
+
+    Cases.push_back({"fill/buffer_" + Config, "GB/s", [=](fixture &F) {
+                       ur_mem_handle_t Dst = F.buffer(Size);
+                       const uint32_t Pattern = 0x12345678;
+                       const size_t N = Iterations * F.Scale;
+                       const auto Start = std::chrono::steady_clock::now();
+                       for (size_t I = 0; I < N; I++) {
+                         BENCH_CHECK(urEnqueueMemBufferFill(
+                             F.Queue, Dst, &Pattern, sizeof(Pattern), 0, Size,
+                             0, nullptr, nullptr));
+                       }
+                       BENCH_CHECK(urQueueFinish(F.Queue));
+                       const double Seconds = bench::seconds_since(Start);
+                       BENCH_CHECK(urMemRelease(Dst));
+                       return bandwidth(Size, N, Seconds);
+                     }});
+  }
+
+  // Copies the left half of a 2D region of Rows rows of 2 * RowBytes bytes
+  // into a region of Rows rows of RowBytes bytes.
+  for (size_t RowBytes : {size_t{256}, 4 * KiB}) {
+    const size_t Rows = 16 * MiB / RowBytes;
+    Cases.push_back(
+        {"copy_rect/" + std::to_string(Rows) + "x" + std::to_string(RowBytes),
+         "GB/s", [=](fixture &F) {
+           ur_mem_handle_t Src = F.buffer(2 * RowBytes * Rows);
+           ur_mem_handle_t Dst = F.buffer(RowBytes * Rows);
+           const ur_rect_offset_t Origin{0, 0, 0};
+           const ur_rect_region_t Region{RowBytes, Rows, 1};
+           const size_t N = 16 * F.Scale;
+           const auto Start = std::chrono::steady_clock::now();
+           for (size_t I = 0; I < N; I++) {
+             BENCH_CHECK(urEnqueueMemBufferCopyRect(
+                 F.Queue, Src, Dst, Origin, Origin, Region, 2 * RowBytes,
+                 2 * RowBytes * Rows, RowBytes, RowBytes * Rows, 0, nullptr,
+                 nullptr));
+           }
+           BENCH_CHECK(urQueueFinish(F.Queue));
+           const double Seconds = bench::seconds_since(Start);
+           BENCH_CHECK(urMemRelease(Src));
+           BENCH_CHECK(urMemRelease(Dst));
+           return bandwidth(RowBytes * Rows, N, Seconds);
+         }});
+  }
+
+  // Creating an event with a marker, waiting for it and releasing it.
+  Cases.push_back({"event/create_wait_release", "ns", [](fixture &F) {
+                     const size_t Iterations = 10000 * F.Scale;
+                     const auto Start = std::chrono::steady_clock::now();
+                     for (size_t I = 0; I < Iterations; I++) {
+                       ur_event_handle_t Event = nullptr;
+                       BENCH_CHECK(
+                           urEnqueueEventsWait(F.Queue, 0, nullptr, &Event));
+                       BENCH_CHECK(urEventWait(1, &Event));
+                       BENCH_CHECK(urEventRelease(Event));
+                     }
+                     return bench::seconds_since(Start) * 1e9 / Iterations;
+                   }});
+
+  // Allocating and immediately freeing device USM.
+  for (size_t Size : {size_t{64}, 4 * KiB, MiB}) {
+    Cases.push_back({"usm_alloc_free/" + std::to_string(Size), "ns",
+                     [Size](fixture &F) {
+                       const size_t Iterations = 10000 * F.Scale;
+                       const auto Start = std::chrono::steady_clock::now();
+                       for (size_t I = 0; I < Iterations; I++) {
+                         BENCH_CHECK(urUSMFree(F.Env.context,
+                                               F.deviceAlloc(Size)));
+                       }
+                       return bench::seconds_since(Start) * 1e9 / Iterations;
+                     }});
+  }
+
+  return Cases;
+}
+
+// Returns the string following Name on the command line, or Default.
+const char *getStringArg(int argc, char **argv, const char *Name,
+                         const char *Default) {
+  for (int I = 1; I + 1 < argc; I++) {
+    if (std::strcmp(argv[I], Name) == 0) {
+      return argv[I + 1];
+    }
+  }
+  return Default;
+}
+
+bool hasFlag(int argc, char **argv, const char *Name) {
+  for (int I = 1; I < argc; I++) {
+    if (std::strcmp(argv[I], Name) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::string Filter = getStringArg(argc, argv, "--filter", "");
+  const size_t Repetitions =
+      std::max<size_t>(1, bench::get_arg(argc, argv, "--repetitions", 5));
+  const size_t Scale =
+      std::max<size_t>(1, bench::get_arg(argc, argv, "--scale", 1));
+
+  const std::vector<bench_case> Cases = makeCases();
+  if (hasFlag(argc, argv, "--list")) {
+    for (const auto &Case : Cases) {
+      std::printf("%s,%s\n", Case.Name.c_str(), Case.Unit);
+    }
+    return 0;
+  }
+
+  bench::environment Env;
+  fixture Fixture(Env, Scale);
+
+  std::printf("name,value,unit\n");
+  for (const auto &Case : Cases) {
+    if (Case.Name.find(Filter) == std::string::npos) {
+      continue;
+    }
+    Case.Run(Fixture);
+    std::vector<double> Values(Repetitions);
+    for (auto &Value : Values) {
+      Value = Case.Run(Fixture);
+    }
+    std::sort(Values.begin(), Values.end());
+    std::printf("%s,%.3f,%s\n", Case.Name.c_str(), Values[Repetitions / 2],
+                Case.Unit);
+    std::fflush(stdout);
+  }
+  return 0;
+}
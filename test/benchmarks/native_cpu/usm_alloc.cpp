@@ -0,0 +1,100 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Measures how USM allocation, free and pointer queries scale with the number
+// of host threads using the same context. Each thread keeps a window of live
+// allocations and, per iteration, frees the oldest one, allocates a new one
+// and queries the type of another live one.
+//
+// Usage: bench-native-cpu-usm-alloc [--iterations N] [--max-threads N]
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+
+#include "helpers.hpp"
+
+namespace {
+
+constexpr size_t LiveAllocations = 64;
+constexpr size_t Sizes[] = {16, 64, 256, 1024, 4096};
+
+void worker(bench::environment &Env, size_t Iterations, size_t Seed,
+            std::atomic<bool> &Go) {
+  void *Live[LiveAllocations] = {};
+  while (!Go.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+  for (size_t I = 0; I < Iterations; I++) {
+    const size_t Slot = I % LiveAllocations;
+    if (Live[Slot]) {
+      BENCH_CHECK(urUSMFree(Env.context, Live[Slot]));
+    }
+    const size_t Size = Sizes[(I + Seed) % std::size(Sizes)];
+    if (I % 2) {
+      BENCH_CHECK(urUSMHostAlloc(Env.context, nullptr, nullptr, Size,
+                                 &Live[Slot]));
+    } else {
+      BENCH_CHECK(urUSMSharedAlloc(Env.context, Env.device, nullptr, nullptr,
+                                   Size, &Live[Slot]));
+    }
+    void *Other = Live[(Slot + LiveAllocations / 2) % LiveAllocations];
+    ur_usm_type_t Type;
+    BENCH_CHECK(urUSMGetMemAllocInfo(Env.context, Other ? Other : Live[Slot],
+                                     UR_USM_ALLOC_INFO_TYPE, sizeof(Type),
+                                     &Type, nullptr));
+  }
+  for (void *Ptr : Live) {
+    if (Ptr) {
+      BENCH_CHECK(urUSMFree(Env.context, Ptr));
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t Iterations = bench::get_arg(argc, argv, "--iterations", 200000);
+  const size_t MaxThreads =
+      bench::get_arg(argc, argv, "--max-threads",
+                     std::max(1u, std::thread::hardware_concurrency()));
+
+  bench::environment Env;
+
+  std::vector<size_t> ThreadCounts;
+  for (size_t Threads = 1; Threads < MaxThreads; Threads *= 2) {
+    ThreadCounts.push_back(Threads);
+  }
+  ThreadCounts.push_back(MaxThreads);
+
+  std::printf("%8s %14s %12s %10s\n", "threads", "ops", "Mops/s", "speedup");
+  double BaseRate = 0.0;
+  for (size_t Threads : ThreadCounts) {
+    std::atomic<bool> Go{false};
+    std::vector<std::thread> Workers;
+    for (size_t T = 0; T < Threads; T++) {
+      Workers.emplace_back(worker, std::ref(Env), Iterations, T,
+                           std::ref(Go));
+    }
+    const auto Start = std::chrono::steady_clock::now();
+    Go.store(true, std::memory_order_release);
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+    const double Elapsed = bench::seconds_since(Start);
+
+    // Every iteration is an allocation, a free and a query.
+    const double Ops = 3.0 * Iterations * Threads;
+    const double Rate = Ops / Elapsed / 1e6;
+    if (BaseRate == 0.0) {
+      BaseRate = Rate;
+    }
+    std::printf("%8zu %14.0f %12.2f %9.2fx\n", Threads, Ops, Rate,
+                Rate / BaseRate);
+  }
+  return 0;
+}
@@ -0,0 +1,127 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Measures how long the host takes to notice that a kernel has completed, and
+// how much CPU time it spends waiting for it. Run it with
+// UR_NATIVE_CPU_WAIT_POLICY set to busy, spin (the default) and block, or
+// with --low-power 1 to create the queue with low-power events, which always
+// blocks. Busy polling has the lowest latency but takes a core for the whole
+// wait, blocking frees the core but pays for a wake-up on every wait, and
+// spinning then blocking gets close to busy polling for waits of a few tens
+// of microseconds and to blocking for longer ones. Use --passes to change how
+// long the kernel runs.
+//
+// Usage: bench-native-cpu-wait-latency [--samples N] [--groups N]
+//                                      [--block N] [--passes N]
+//                                      [--low-power 0|1]
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+#include "helpers.hpp"
+
+namespace {
+
+// The CPU time used by the calling thread, in seconds.
+double threadCpuTime() {
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+  FILETIME Creation, Exit, Kernel, User;
+  GetThreadTimes(GetCurrentThread(), &Creation, &Exit, &Kernel, &User);
+  // Both are counts of 100 ns intervals.
+  auto Ticks = [](const FILETIME &Time) {
+    return (uint64_t(Time.dwHighDateTime) << 32) | Time.dwLowDateTime;
+  };
+  return (Ticks(Kernel) + Ticks(User)) * 1e-7;
+#else
+  timespec Time;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+#endif
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t Samples = bench::get_arg(argc, argv, "--samples", 2000);
+  const uint64_t Groups = bench::get_arg(argc, argv, "--groups", 4);
+  const uint64_t Block = bench::get_arg(argc, argv, "--block", 1024);
+  const uint64_t Passes = bench::get_arg(argc, argv, "--passes", 4);
+  const bool LowPower = bench::get_arg(argc, argv, "--low-power", 0);
+  const size_t LocalSize = 4;
+  const size_t GlobalOffset = 0;
+  const size_t GlobalSize = Groups * LocalSize;
+
+  bench::environment Env;
+
+  ur_program_handle_t Program = bench::create_program(Env);
+
+  // In-order queues wait for kernels in the launch itself, so use an
+  // out-of-order queue to time the wait on its own.
+  ur_queue_flags_t Flags = UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE;
+  if (LowPower) {
+    Flags |= UR_QUEUE_FLAG_LOW_POWER_EVENTS_EXP;
+  }
+  ur_queue_properties_t Properties{UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+                                   Flags};
+  ur_queue_handle_t Queue = nullptr;
+  BENCH_CHECK(urQueueCreate(Env.context, Env.device, &Properties, &Queue));
+
+  float *Data = nullptr;
+  BENCH_CHECK(urUSMDeviceAlloc(Env.context, Env.device, nullptr, nullptr,
+                               Groups * Block * sizeof(float),
+                               reinterpret_cast<void **>(&Data)));
+  std::fill(Data, Data + Groups * Block, 1.0f);
+  ur_kernel_handle_t Kernel = nullptr;
+  BENCH_CHECK(urKernelCreate(Program, "scale", &Kernel));
+  BENCH_CHECK(urKernelSetArgPointer(Kernel, 0, nullptr, Data));
+  BENCH_CHECK(urKernelSetArgValue(Kernel, 1, sizeof(Block), nullptr, &Block));
+  BENCH_CHECK(
+      urKernelSetArgValue(Kernel, 2, sizeof(Passes), nullptr, &Passes));
+
+  std::vector<double> Latencies(Samples);
+  double WaitTime = 0.0;
+  double WaitCpuTime = 0.0;
+  for (size_t I = 0; I < Samples; I++) {
+    const auto LaunchStart = std::chrono::steady_clock::now();
+    ur_event_handle_t Event = nullptr;
+    BENCH_CHECK(urEnqueueKernelLaunch(Queue, Kernel, 1, &GlobalOffset,
+                                      &GlobalSize, &LocalSize, 0, nullptr,
+                                      &Event));
+    const auto WaitStart = std::chrono::steady_clock::now();
+    const double WaitCpuStart = threadCpuTime();
+    BENCH_CHECK(urEventWait(1, &Event));
+    WaitCpuTime += threadCpuTime() - WaitCpuStart;
+    WaitTime += bench::seconds_since(WaitStart);
+    Latencies[I] = bench::seconds_since(LaunchStart);
+    BENCH_CHECK(urEventRelease(Event));
+  }
+
+  std::sort(Latencies.begin(), Latencies.end());
+  auto percentile = [&](double P) {
+    return Latencies[std::min(Samples - 1, static_cast<size_t>(P * Samples))] *
+           1e6;
+  };
+  std::printf("%12s %12s %12s %16s\n", "p50 (us)", "p99 (us)", "max (us)",
+              "waiting CPU (%)");
+  std::printf("%12.1f %12.1f %12.1f %16.1f\n", percentile(0.5),
+              percentile(0.99), Latencies.back() * 1e6,
+              WaitTime > 0.0 ? 100.0 * WaitCpuTime / WaitTime : 0.0);
+
+  BENCH_CHECK(urKernelRelease(Kernel));
+  BENCH_CHECK(urUSMFree(Env.context, Data));
+  BENCH_CHECK(urQueueRelease(Queue));
+  BENCH_CHECK(urProgramRelease(Program));
+  return 0;
+}
@@ -274,7 +274,6 @@ const std::set<ur_device_info_t> nativeCPUFails = {
     UR_DEVICE_INFO_DEVICE_ID,
     UR_DEVICE_INFO_MEMORY_CLOCK_RATE,
     UR_DEVICE_INFO_MAX_READ_WRITE_IMAGE_ARGS,
-    UR_DEVICE_INFO_GLOBAL_MEM_FREE,
     UR_DEVICE_INFO_QUEUE_ON_DEVICE_PROPERTIES,
     UR_DEVICE_INFO_QUEUE_ON_HOST_PROPERTIES,
     UR_DEVICE_INFO_IL_VERSION,
@@ -301,10 +300,6 @@ const std::set<ur_device_info_t> nativeCPUFails = {
 TEST_P(urDeviceGetInfoTest, Success) {
   ur_device_info_t info_type = getParam();
 
-  if (info_type == UR_DEVICE_INFO_GLOBAL_MEM_FREE) {
-    UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-  }
-
   if (info_type == UR_DEVICE_INFO_MAX_READ_WRITE_IMAGE_ARGS) {
     UUR_KNOWN_FAILURE_ON(uur::CUDA{});
   }
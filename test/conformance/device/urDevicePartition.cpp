@@ -205,6 +205,173 @@ TEST_P(urDevicePartitionTest, SuccessSubSet) {
   }
 }
 
+// Checks that each sub-device has the given number of compute units, device
+// as its parent and the given partition type.
+void checkSubDevices(ur_device_handle_t device,
+                     const std::vector<ur_device_handle_t> &sub_devices,
+                     const std::vector<uint32_t> &compute_units,
+                     const std::vector<ur_device_partition_property_t> &types) {
+  ASSERT_EQ(sub_devices.size(), compute_units.size());
+  for (size_t i = 0; i < sub_devices.size(); i++) {
+    uint32_t n_compute_units = 0;
+    ASSERT_NO_FATAL_FAILURE(
+        getNumberComputeUnits(sub_devices[i], n_compute_units));
+    EXPECT_EQ(n_compute_units, compute_units[i]) << i;
+
+    ur_device_handle_t parent = nullptr;
+    ASSERT_SUCCESS(uur::GetDeviceParentDevice(sub_devices[i], parent));
+    EXPECT_EQ(parent, device) << i;
+
+    std::vector<ur_device_partition_property_t> type;
+    ASSERT_SUCCESS(uur::GetDevicePartitionType(sub_devices[i], type));
+    ASSERT_EQ(type.size(), 1);
+    EXPECT_EQ(type[0].type, types[i].type) << i;
+    switch (type[0].type) {
+    case UR_DEVICE_PARTITION_EQUALLY:
+      EXPECT_EQ(type[0].value.equally, types[i].value.equally) << i;
+      break;
+    case UR_DEVICE_PARTITION_BY_COUNTS:
+      EXPECT_EQ(type[0].value.count, types[i].value.count) << i;
+      break;
+    case UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN:
+      EXPECT_EQ(type[0].value.affinity_domain,
+                types[i].value.affinity_domain)
+          << i;
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+std::vector<ur_device_handle_t>
+partition(ur_device_handle_t device,
+          const std::vector<ur_device_partition_property_t> &property_list) {
+  ur_device_partition_properties_t properties{
+      UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr,
+      property_list.data(), property_list.size()};
+  uint32_t n_devices = 0;
+  EXPECT_SUCCESS(
+      urDevicePartition(device, &properties, 0, nullptr, &n_devices));
+  std::vector<ur_device_handle_t> sub_devices(n_devices);
+  EXPECT_SUCCESS(urDevicePartition(device, &properties, n_devices,
+                                   sub_devices.data(), nullptr));
+  return sub_devices;
+}
+
+void releaseSubDevices(const std::vector<ur_device_handle_t> &sub_devices) {
+  for (auto sub_device : sub_devices) {
+    EXPECT_SUCCESS(urDeviceRelease(sub_device));
+  }
+}
+
+TEST_P(urDevicePartitionTest, PartitionEquallyUpToMaxSubDevices) {
+  if (!uur::hasDevicePartitionSupport(device, UR_DEVICE_PARTITION_EQUALLY)) {
+    GTEST_SKIP() << "Device: \'" << device
+                 << "\' does not support partitioning equally.";
+  }
+
+  uint32_t max_sub_devices = 0;
+  ASSERT_SUCCESS(
+      uur::GetDevicePartitionMaxSubDevices(device, max_sub_devices));
+  ASSERT_NE(max_sub_devices, 0);
+
+  // One compute unit each gives the most sub-devices there can be.
+  const auto one = uur::makePartitionEquallyDesc(1);
+  auto sub_devices = partition(device, {one});
+  ASSERT_NO_FATAL_FAILURE(checkSubDevices(
+      device, sub_devices, std::vector<uint32_t>(max_sub_devices, 1),
+      std::vector<ur_device_partition_property_t>(max_sub_devices, one)));
+  releaseSubDevices(sub_devices);
+
+  const auto all = uur::makePartitionEquallyDesc(max_sub_devices);
+  sub_devices = partition(device, {all});
+  ASSERT_NO_FATAL_FAILURE(
+      checkSubDevices(device, sub_devices, {max_sub_devices}, {all}));
+  releaseSubDevices(sub_devices);
+
+  const auto too_many = uur::makePartitionEquallyDesc(max_sub_devices + 1);
+  ur_device_partition_properties_t properties{
+      UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr, &too_many, 1};
+  uint32_t n_devices = 0;
+  ASSERT_EQ_RESULT(
+      UR_RESULT_ERROR_DEVICE_PARTITION_FAILED,
+      urDevicePartition(device, &properties, 0, nullptr, &n_devices));
+}
+
+TEST_P(urDevicePartitionTest, PartitionByCountsUpToMaxSubDevices) {
+  if (!uur::hasDevicePartitionSupport(device, UR_DEVICE_PARTITION_BY_COUNTS)) {
+    GTEST_SKIP() << "Device: \'" << device
+                 << "\' does not support partitioning by counts.";
+  }
+
+  uint32_t max_sub_devices = 0;
+  ASSERT_SUCCESS(
+      uur::GetDevicePartitionMaxSubDevices(device, max_sub_devices));
+  if (max_sub_devices < 2) {
+    GTEST_SKIP() << "Device: \'" << device
+                 << "\' can't be partitioned into several sub-devices.";
+  }
+
+  const std::vector<ur_device_partition_property_t> counts{
+      uur::makePartitionByCountsDesc(1),
+      uur::makePartitionByCountsDesc(max_sub_devices - 1)};
+  auto sub_devices = partition(device, counts);
+  ASSERT_NO_FATAL_FAILURE(checkSubDevices(device, sub_devices,
+                                          {1, max_sub_devices - 1}, counts));
+  releaseSubDevices(sub_devices);
+
+  const std::vector<ur_device_partition_property_t> too_many{
+      uur::makePartitionByCountsDesc(max_sub_devices),
+      uur::makePartitionByCountsDesc(1)};
+  ur_device_partition_properties_t properties{
+      UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr, too_many.data(),
+      too_many.size()};
+  uint32_t n_devices = 0;
+  ASSERT_EQ_RESULT(
+      UR_RESULT_ERROR_INVALID_DEVICE_PARTITION_COUNT,
+      urDevicePartition(device, &properties, 0, nullptr, &n_devices));
+}
+
+TEST_P(urDevicePartitionTest, PartitionByNumaCoversDevice) {
+  if (!uur::hasDevicePartitionSupport(device,
+                                      UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN)) {
+    GTEST_SKIP() << "Device \'" << device
+                 << "\' does not support partitioning by affinity domain.";
+  }
+  ur_device_affinity_domain_flags_t supported_flags{0};
+  ASSERT_SUCCESS(
+      uur::GetDevicePartitionAffinityDomainFlags(device, supported_flags));
+  if (!(supported_flags & UR_DEVICE_AFFINITY_DOMAIN_FLAG_NUMA)) {
+    GTEST_SKIP() << "Device \'" << device
+                 << "\' does not support partitioning by NUMA node.";
+  }
+
+  uint32_t max_sub_devices = 0;
+  ASSERT_SUCCESS(
+      uur::GetDevicePartitionMaxSubDevices(device, max_sub_devices));
+
+  // Each NUMA node gets a sub-device, which together have all the compute
+  // units the device can be partitioned into.
+  const auto numa =
+      uur::makePartitionByAffinityDomain(UR_DEVICE_AFFINITY_DOMAIN_FLAG_NUMA);
+  auto sub_devices = partition(device, {numa});
+  ASSERT_FALSE(sub_devices.empty());
+  std::vector<uint32_t> compute_units;
+  uint32_t sum = 0;
+  for (auto sub_device : sub_devices) {
+    uint32_t n_compute_units = 0;
+    ASSERT_NO_FATAL_FAILURE(getNumberComputeUnits(sub_device, n_compute_units));
+    compute_units.push_back(n_compute_units);
+    sum += n_compute_units;
+  }
+  ASSERT_NO_FATAL_FAILURE(checkSubDevices(
+      device, sub_devices, compute_units,
+      std::vector<ur_device_partition_property_t>(sub_devices.size(), numa)));
+  EXPECT_EQ(sum, max_sub_devices);
+  releaseSubDevices(sub_devices);
+}
+
 using urDevicePartitionAffinityDomainTest =
     uur::urDeviceTestWithParam<ur_device_affinity_domain_flags_t>;
 
@@ -0,0 +1,285 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <uur/fixtures.h>
+#include <vector>
+
+#include "nativecpu_state.hpp"
+
+// Commands of queues created with UR_QUEUE_FLAG_SUBMISSION_BATCHED are
+// recorded until the queue is flushed, when kernel launches without
+// dependencies are scheduled together and contiguous copies are coalesced.
+// Kernels are supplied as a table of entry points built in the process, as in
+// urEnqueueHostPipeNativeCpu.cpp.
+namespace {
+// Stores the value of argument 2 at index argument 1 of the array in
+// argument 0.
+void store(void *const *args, native_cpu::state *) {
+  auto *Array = static_cast<uint32_t *>(args[0]);
+  Array[*static_cast<const uint32_t *>(args[1])] =
+      *static_cast<const uint32_t *>(args[2]);
+}
+
+// Stores one more than the element at index argument 1 at index argument 2
+// of the array in argument 0.
+void increment(void *const *args, native_cpu::state *) {
+  auto *Array = static_cast<uint32_t *>(args[0]);
+  Array[*static_cast<const uint32_t *>(args[2])] =
+      Array[*static_cast<const uint32_t *>(args[1])] + 1;
+}
+
+std::atomic<bool> Release{false};
+
+// Holds up whatever depends on it until Release is set.
+void wait_for_release(void *const *, native_cpu::state *) {
+  while (!Release.load()) {
+    std::this_thread::yield();
+  }
+}
+
+nativecpu_entry Entries[] = {
+    {"store", reinterpret_cast<const unsigned char *>(&store)},
+    {"increment", reinterpret_cast<const unsigned char *>(&increment)},
+    {"wait_for_release",
+     reinterpret_cast<const unsigned char *>(&wait_for_release)},
+    {nullptr, nullptr}};
+
+ur_event_status_t getStatus(ur_event_handle_t event) {
+  ur_event_status_t status = UR_EVENT_STATUS_ERROR;
+  urEventGetInfo(event, UR_EVENT_INFO_COMMAND_EXECUTION_STATUS,
+                 sizeof(status), &status, nullptr);
+  return status;
+}
+} // namespace
+
+struct urNativeCpuBatchedQueueTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::SetUp());
+
+    ur_platform_backend_t backend;
+    ASSERT_SUCCESS(urPlatformGetInfo(platform, UR_PLATFORM_INFO_BACKEND,
+                                     sizeof(backend), &backend, nullptr));
+    if (backend != UR_PLATFORM_BACKEND_NATIVE_CPU) {
+      GTEST_SKIP() << "The binary format is specific to native_cpu.";
+    }
+
+    const auto *binary = reinterpret_cast<const uint8_t *>(Entries);
+    size_t binary_size = sizeof(Entries);
+    ASSERT_SUCCESS(urProgramCreateWithBinary(context, 1, &device, &binary_size,
+                                             &binary, nullptr, &program));
+    ASSERT_SUCCESS(urProgramBuild(context, program, nullptr));
+
+    ur_queue_properties_t batched_properties = {
+        UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+        UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE |
+            UR_QUEUE_FLAG_SUBMISSION_BATCHED};
+    ASSERT_SUCCESS(
+        urQueueCreate(context, device, &batched_properties, &batched_queue));
+
+    ASSERT_SUCCESS(urUSMHostAlloc(context, nullptr, nullptr,
+                                  count * sizeof(uint32_t), &array));
+    std::fill_n(static_cast<uint32_t *>(array), count, 0);
+  }
+
+  void TearDown() override {
+    if (array) {
+      EXPECT_SUCCESS(urUSMFree(context, array));
+    }
+    if (batched_queue) {
+      EXPECT_SUCCESS(urQueueRelease(batched_queue));
+    }
+    if (program) {
+      EXPECT_SUCCESS(urProgramRelease(program));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::TearDown());
+  }
+
+  void setArgs(ur_kernel_handle_t kernel, uint32_t arg1, uint32_t arg2) {
+    ASSERT_SUCCESS(urKernelSetArgPointer(kernel, 0, nullptr, array));
+    ASSERT_SUCCESS(
+        urKernelSetArgValue(kernel, 1, sizeof(arg1), nullptr, &arg1));
+    ASSERT_SUCCESS(
+        urKernelSetArgValue(kernel, 2, sizeof(arg2), nullptr, &arg2));
+  }
+
+  ur_result_t launch(ur_queue_handle_t queue, ur_kernel_handle_t kernel,
+                     uint32_t num_events, const ur_event_handle_t *events,
+                     ur_event_handle_t *event) {
+    const size_t offset = 0;
+    const size_t size = 1;
+    return urEnqueueKernelLaunch(queue, kernel, 1, &offset, &size, &size,
+                                 num_events, events, event);
+  }
+
+  uint32_t at(size_t index) const {
+    return static_cast<const uint32_t *>(array)[index];
+  }
+
+  static constexpr size_t count = 16;
+  ur_program_handle_t program = nullptr;
+  ur_queue_handle_t batched_queue = nullptr;
+  void *array = nullptr;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuBatchedQueueTest);
+
+TEST_P(urNativeCpuBatchedQueueTest, LaunchesWaitForFlush) {
+  ur_kernel_handle_t kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "store", &kernel));
+  ASSERT_NO_FATAL_FAILURE(setArgs(kernel, 0, 42));
+  ur_event_handle_t event = nullptr;
+  ASSERT_SUCCESS(launch(batched_queue, kernel, 0, nullptr, &event));
+
+  EXPECT_EQ(getStatus(event), UR_EVENT_STATUS_QUEUED);
+  EXPECT_EQ(at(0), 0u);
+
+  ASSERT_SUCCESS(urQueueFlush(batched_queue));
+  EXPECT_NE(getStatus(event), UR_EVENT_STATUS_QUEUED);
+  ASSERT_SUCCESS(urEventWait(1, &event));
+  EXPECT_EQ(at(0), 42u);
+
+  EXPECT_SUCCESS(urEventRelease(event));
+  EXPECT_SUCCESS(urKernelRelease(kernel));
+}
+
+TEST_P(urNativeCpuBatchedQueueTest, MergedLaunchesKeepDependencies) {
+  ur_kernel_handle_t store_kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "store", &store_kernel));
+  ur_kernel_handle_t increment_kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "increment", &increment_kernel));
+
+  // Independent launches, which are scheduled together, each followed by one
+  // that depends on it and starts a new group.
+  constexpr uint32_t pairs = count / 2;
+  std::vector<ur_event_handle_t> events(pairs);
+  for (uint32_t i = 0; i < pairs; i++) {
+    ASSERT_NO_FATAL_FAILURE(setArgs(store_kernel, i, i * 10));
+    ASSERT_SUCCESS(
+        launch(batched_queue, store_kernel, 0, nullptr, &events[i]));
+  }
+  for (uint32_t i = 0; i < pairs; i++) {
+    ASSERT_NO_FATAL_FAILURE(setArgs(increment_kernel, i, pairs + i));
+    ASSERT_SUCCESS(
+        launch(batched_queue, increment_kernel, 1, &events[i], nullptr));
+  }
+  ASSERT_SUCCESS(urQueueFinish(batched_queue));
+
+  for (uint32_t i = 0; i < pairs; i++) {
+    EXPECT_EQ(at(i), i * 10) << i;
+    EXPECT_EQ(at(pairs + i), i * 10 + 1) << i;
+    EXPECT_SUCCESS(urEventRelease(events[i]));
+  }
+  EXPECT_SUCCESS(urKernelRelease(increment_kernel));
+  EXPECT_SUCCESS(urKernelRelease(store_kernel));
+}
+
+TEST_P(urNativeCpuBatchedQueueTest, ContiguousCopiesAreCoalesced) {
+  std::vector<uint32_t> input(count);
+  std::iota(input.begin(), input.end(), 1);
+  ur_mem_handle_t buffer = nullptr;
+  ASSERT_SUCCESS(urMemBufferCreate(context, UR_MEM_FLAG_READ_WRITE,
+                                   count * sizeof(uint32_t), nullptr,
+                                   &buffer));
+
+  // Write the buffer in chunks, which are copied as one once flushed.
+  constexpr size_t chunks = 4;
+  constexpr size_t chunk_size = count / chunks * sizeof(uint32_t);
+  std::vector<ur_event_handle_t> events(chunks);
+  for (size_t i = 0; i < chunks; i++) {
+    ASSERT_SUCCESS(urEnqueueMemBufferWrite(
+        batched_queue, buffer, false, i * chunk_size, chunk_size,
+        reinterpret_cast<const char *>(input.data()) + i * chunk_size, 0,
+        nullptr, &events[i]));
+  }
+  for (auto event : events) {
+    EXPECT_EQ(getStatus(event), UR_EVENT_STATUS_QUEUED);
+  }
+
+  std::vector<uint32_t> output(count);
+  ASSERT_SUCCESS(urEnqueueMemBufferRead(batched_queue, buffer, true, 0,
+                                        count * sizeof(uint32_t),
+                                        output.data(), 0, nullptr, nullptr));
+  EXPECT_EQ(output, input);
+  for (auto event : events) {
+    EXPECT_EQ(getStatus(event), UR_EVENT_STATUS_COMPLETE);
+    EXPECT_SUCCESS(urEventRelease(event));
+  }
+  EXPECT_SUCCESS(urMemRelease(buffer));
+}
+
+TEST_P(urNativeCpuBatchedQueueTest, OverlappingCopiesAreNotCoalesced) {
+  std::vector<uint32_t> input(count);
+  std::iota(input.begin(), input.end(), 1);
+  ur_mem_handle_t buffer = nullptr;
+  ASSERT_SUCCESS(urMemBufferCreate(context, UR_MEM_FLAG_READ_WRITE,
+                                   count * sizeof(uint32_t), nullptr,
+                                   &buffer));
+  ASSERT_SUCCESS(urEnqueueMemBufferWrite(batched_queue, buffer, true, 0,
+                                         count * sizeof(uint32_t),
+                                         input.data(), 0, nullptr, nullptr));
+
+  // Each copy continues the previous one but reads what it wrote, so the
+  // first quarter of the buffer must end up in the last three.
+  constexpr size_t quarter = count / 4 * sizeof(uint32_t);
+  for (size_t i = 0; i < 3; i++) {
+    ASSERT_SUCCESS(urEnqueueMemBufferCopy(batched_queue, buffer, buffer,
+                                          i * quarter, (i + 1) * quarter,
+                                          quarter, 0, nullptr, nullptr));
+  }
+
+  std::vector<uint32_t> output(count);
+  ASSERT_SUCCESS(urEnqueueMemBufferRead(batched_queue, buffer, true, 0,
+                                        count * sizeof(uint32_t),
+                                        output.data(), 0, nullptr, nullptr));
+  for (size_t i = 0; i < count; i++) {
+    EXPECT_EQ(output[i], input[i % (count / 4)]) << i;
+  }
+  EXPECT_SUCCESS(urMemRelease(buffer));
+}
+
+TEST_P(urNativeCpuBatchedQueueTest, LaunchWaitsOnPendingTimestamp) {
+  ur_queue_properties_t ooo_properties = {
+      UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+      UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE};
+  ur_queue_handle_t ooo_queue = nullptr;
+  ASSERT_SUCCESS(urQueueCreate(context, device, &ooo_properties, &ooo_queue));
+  ur_kernel_handle_t wait_kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "wait_for_release", &wait_kernel));
+  ur_kernel_handle_t store_kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "store", &store_kernel));
+  ASSERT_NO_FATAL_FAILURE(setArgs(store_kernel, 0, 42));
+
+  // The timestamp is never recorded as a command of the batched queue, and
+  // stays queued until the kernel it depends on lets it complete.
+  Release = false;
+  ur_event_handle_t wait_event = nullptr;
+  ASSERT_SUCCESS(launch(ooo_queue, wait_kernel, 0, nullptr, &wait_event));
+  ur_event_handle_t timestamp = nullptr;
+  ASSERT_SUCCESS(urEnqueueTimestampRecordingExp(batched_queue, false, 1,
+                                                &wait_event, &timestamp));
+  ASSERT_SUCCESS(launch(batched_queue, store_kernel, 1, &timestamp, nullptr));
+
+  // Flushing the launch waits for the timestamp, which must not flush the
+  // batched queue again.
+  std::thread releaser([]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    Release = true;
+  });
+  const auto result = urQueueFinish(batched_queue);
+  releaser.join();
+  ASSERT_SUCCESS(result);
+  EXPECT_EQ(at(0), 42u);
+
+  EXPECT_SUCCESS(urEventRelease(timestamp));
+  EXPECT_SUCCESS(urEventRelease(wait_event));
+  EXPECT_SUCCESS(urKernelRelease(store_kernel));
+  EXPECT_SUCCESS(urKernelRelease(wait_kernel));
+  EXPECT_SUCCESS(urQueueRelease(ooo_queue));
+}
@@ -0,0 +1,143 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <uur/fixtures.h>
+#include <vector>
+
+#include "nativecpu_state.hpp"
+
+// Large buffers are copied or first touched by the idle workers of the
+// device, and by the host for the others, so creating one must neither wait
+// for kernels occupying the workers nor lose any of the data. Kernels are
+// supplied as a table of entry points built in the process, as in
+// urEnqueueHostPipeNativeCpu.cpp.
+namespace {
+std::atomic<bool> Release{false};
+
+// Occupies a worker until Release is set.
+void wait_for_release(void *const *, native_cpu::state *) {
+  while (!Release.load()) {
+    std::this_thread::yield();
+  }
+}
+
+nativecpu_entry Entries[] = {
+    {"wait_for_release",
+     reinterpret_cast<const unsigned char *>(&wait_for_release)},
+    {nullptr, nullptr}};
+} // namespace
+
+struct urNativeCpuBufferInitTest : uur::urContextTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urContextTest::SetUp());
+
+    ur_platform_backend_t backend;
+    ASSERT_SUCCESS(urPlatformGetInfo(platform, UR_PLATFORM_INFO_BACKEND,
+                                     sizeof(backend), &backend, nullptr));
+    if (backend != UR_PLATFORM_BACKEND_NATIVE_CPU) {
+      GTEST_SKIP() << "The binary format is specific to native_cpu.";
+    }
+    Release = false;
+  }
+
+  void TearDown() override {
+    Release = true;
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urContextTest::TearDown());
+  }
+
+  // Creates buffers of at least the default threshold of 1 MiB in a context
+  // of dev while every worker of dev runs a kernel that only returns once
+  // they have been created.
+  void createWhileBusy(ur_device_handle_t dev) {
+    ur_context_handle_t ctx = nullptr;
+    ASSERT_SUCCESS(urContextCreate(1, &dev, nullptr, &ctx));
+    const auto *binary = reinterpret_cast<const uint8_t *>(Entries);
+    size_t binary_size = sizeof(Entries);
+    ur_program_handle_t program = nullptr;
+    ASSERT_SUCCESS(urProgramCreateWithBinary(ctx, 1, &dev, &binary_size,
+                                             &binary, nullptr, &program));
+    ASSERT_SUCCESS(urProgramBuild(ctx, program, nullptr));
+    ur_kernel_handle_t kernel = nullptr;
+    ASSERT_SUCCESS(urKernelCreate(program, "wait_for_release", &kernel));
+    // Launches on in-order queues wait for the kernel.
+    ur_queue_properties_t ooo_properties = {
+        UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+        UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE};
+    ur_queue_handle_t queue = nullptr;
+    ASSERT_SUCCESS(urQueueCreate(ctx, dev, &ooo_properties, &queue));
+
+    // More work-groups than workers, each of which holds its worker.
+    uint32_t compute_units = 0;
+    ASSERT_SUCCESS(urDeviceGetInfo(dev, UR_DEVICE_INFO_MAX_COMPUTE_UNITS,
+                                   sizeof(compute_units), &compute_units,
+                                   nullptr));
+    const size_t offset = 0;
+    const size_t global_size = 2 * compute_units;
+    const size_t local_size = 1;
+    ur_event_handle_t kernel_event = nullptr;
+    ASSERT_SUCCESS(urEnqueueKernelLaunch(queue, kernel, 1, &offset,
+                                         &global_size, &local_size, 0,
+                                         nullptr, &kernel_event));
+
+    std::vector<uint32_t> input((3 << 20) / sizeof(uint32_t) + 5);
+    std::iota(input.begin(), input.end(), 1);
+    const size_t size = input.size() * sizeof(uint32_t);
+    ur_buffer_properties_t properties = {UR_STRUCTURE_TYPE_BUFFER_PROPERTIES,
+                                         nullptr, input.data()};
+    ur_mem_handle_t copied = nullptr;
+    ASSERT_SUCCESS(urMemBufferCreate(ctx,
+                                     UR_MEM_FLAG_READ_WRITE |
+                                         UR_MEM_FLAG_ALLOC_COPY_HOST_POINTER,
+                                     size, &properties, &copied));
+    ur_mem_handle_t touched = nullptr;
+    ASSERT_SUCCESS(urMemBufferCreate(ctx, UR_MEM_FLAG_READ_WRITE, size,
+                                     nullptr, &touched));
+
+    ur_event_status_t status = UR_EVENT_STATUS_ERROR;
+    ASSERT_SUCCESS(urEventGetInfo(kernel_event,
+                                  UR_EVENT_INFO_COMMAND_EXECUTION_STATUS,
+                                  sizeof(status), &status, nullptr));
+    EXPECT_NE(status, UR_EVENT_STATUS_COMPLETE);
+    Release = true;
+    ASSERT_SUCCESS(urEventWait(1, &kernel_event));
+
+    std::vector<uint32_t> output(input.size());
+    ASSERT_SUCCESS(urEnqueueMemBufferRead(queue, copied, true, 0, size,
+                                          output.data(), 0, nullptr, nullptr));
+    EXPECT_EQ(input, output);
+
+    EXPECT_SUCCESS(urMemRelease(touched));
+    EXPECT_SUCCESS(urMemRelease(copied));
+    EXPECT_SUCCESS(urEventRelease(kernel_event));
+    EXPECT_SUCCESS(urQueueRelease(queue));
+    EXPECT_SUCCESS(urKernelRelease(kernel));
+    EXPECT_SUCCESS(urProgramRelease(program));
+    EXPECT_SUCCESS(urContextRelease(ctx));
+  }
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuBufferInitTest);
+
+TEST_P(urNativeCpuBufferInitTest, RootDeviceWorkersBusy) {
+  createWhileBusy(device);
+}
+
+TEST_P(urNativeCpuBufferInitTest, SubDeviceWorkersBusy) {
+  // The workers of sub-devices are pinned, so their buffers are first
+  // touched.
+  ur_device_partition_property_t property = {UR_DEVICE_PARTITION_EQUALLY,
+                                             {1}};
+  ur_device_partition_properties_t properties = {
+      UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr, &property, 1};
+  ur_device_handle_t sub_device = nullptr;
+  ASSERT_SUCCESS(
+      urDevicePartition(device, &properties, 1, &sub_device, nullptr));
+  createWhileBusy(sub_device);
+  EXPECT_SUCCESS(urDeviceRelease(sub_device));
+}
@@ -0,0 +1,212 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <array>
+#include <uur/fixtures.h>
+
+#include "nativecpu_state.hpp"
+#include "pipe.hpp"
+
+// The native_cpu adapter accepts a table of entry points built in the process
+// as a program binary, which lets these tests supply a kernel and the host
+// pipe symbol table without device code. The layout of the host pipe table is
+// that of nativecpu_host_pipe_entry in the adapter's program.hpp.
+namespace {
+struct host_pipe_entry_t {
+  const char *name;
+  void *addr;
+  uint64_t size;
+};
+
+native_cpu::host_pipe_t *InPipe = nullptr;
+native_cpu::host_pipe_t *OutPipe = nullptr;
+
+// Copies the given number of ints from the in pipe to the out pipe, adding
+// one to each.
+void echo(void *const *args, native_cpu::state *) {
+  const int Count = *static_cast<const int *>(args[0]);
+  for (int I = 0; I < Count; I++) {
+    int Value;
+    InPipe->read(&Value, sizeof(Value));
+    Value++;
+    OutPipe->write(&Value, sizeof(Value));
+  }
+}
+
+host_pipe_entry_t HostPipes[] = {{"in", &InPipe, 0},
+                                 {"out", &OutPipe, 0},
+                                 {nullptr, nullptr, 0}};
+
+nativecpu_entry Entries[] = {
+    {"echo", reinterpret_cast<const unsigned char *>(&echo)},
+    {"__nativecpu_host_pipes",
+     reinterpret_cast<const unsigned char *>(HostPipes)},
+    {nullptr, nullptr}};
+} // namespace
+
+struct urNativeCpuHostPipeTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::SetUp());
+
+    ur_platform_backend_t backend;
+    ASSERT_SUCCESS(urPlatformGetInfo(platform, UR_PLATFORM_INFO_BACKEND,
+                                     sizeof(backend), &backend, nullptr));
+    if (backend != UR_PLATFORM_BACKEND_NATIVE_CPU) {
+      GTEST_SKIP() << "The binary format is specific to native_cpu.";
+    }
+
+    const auto *binary = reinterpret_cast<const uint8_t *>(Entries);
+    size_t binary_size = sizeof(Entries);
+    ASSERT_SUCCESS(urProgramCreateWithBinary(context, 1, &device, &binary_size,
+                                             &binary, nullptr, &program));
+    ASSERT_SUCCESS(urProgramBuild(context, program, nullptr));
+
+    ur_queue_properties_t ooo_properties = {
+        UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+        UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE};
+    ASSERT_SUCCESS(urQueueCreate(context, device, &ooo_properties, &ooo_queue));
+  }
+
+  void TearDown() override {
+    if (ooo_queue) {
+      EXPECT_SUCCESS(urQueueRelease(ooo_queue));
+    }
+    if (program) {
+      EXPECT_SUCCESS(urProgramRelease(program));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::TearDown());
+  }
+
+  ur_program_handle_t program = nullptr;
+  ur_queue_handle_t ooo_queue = nullptr;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuHostPipeTest);
+
+TEST_P(urNativeCpuHostPipeTest, WriteThenRead) {
+  std::array<int, 4> input = {1, 2, 3, 4};
+  ASSERT_SUCCESS(urEnqueueWriteHostPipe(queue, program, "in", true,
+                                        input.data(), sizeof(input), 0,
+                                        nullptr, nullptr));
+
+  std::array<int, 4> output = {};
+  ASSERT_SUCCESS(urEnqueueReadHostPipe(queue, program, "in", true,
+                                       output.data(), sizeof(output), 0,
+                                       nullptr, nullptr));
+  ASSERT_EQ(input, output);
+}
+
+TEST_P(urNativeCpuHostPipeTest, ReadBeforeWrite) {
+  // The read can't be made until the write that follows it has been, so
+  // neither can be blocking.
+  int output = 0;
+  ur_event_handle_t read_event = nullptr;
+  ASSERT_SUCCESS(urEnqueueReadHostPipe(ooo_queue, program, "in", false,
+                                       &output, sizeof(output), 0, nullptr,
+                                       &read_event));
+
+  int input = 42;
+  ur_event_handle_t write_event = nullptr;
+  ASSERT_SUCCESS(urEnqueueWriteHostPipe(ooo_queue, program, "in", false,
+                                        &input, sizeof(input), 0, nullptr,
+                                        &write_event));
+
+  ASSERT_SUCCESS(urEventWait(1, &read_event));
+  ASSERT_EQ(output, input);
+  ASSERT_SUCCESS(urEventWait(1, &write_event));
+  EXPECT_SUCCESS(urEventRelease(read_event));
+  EXPECT_SUCCESS(urEventRelease(write_event));
+}
+
+TEST_P(urNativeCpuHostPipeTest, ThroughKernel) {
+  constexpr int count = 1000;
+  ur_kernel_handle_t kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "echo", &kernel));
+  ASSERT_SUCCESS(urKernelSetArgValue(kernel, 0, sizeof(count), nullptr,
+                                     &count));
+
+  const size_t offset = 0;
+  const size_t size = 1;
+  ur_event_handle_t kernel_event = nullptr;
+  ASSERT_SUCCESS(urEnqueueKernelLaunch(ooo_queue, kernel, 1, &offset, &size,
+                                       &size, 0, nullptr, &kernel_event));
+
+  // The kernel runs alongside the host, which feeds it one value at a time.
+  for (int i = 0; i < count; i++) {
+    ASSERT_SUCCESS(urEnqueueWriteHostPipe(queue, program, "in", true, &i,
+                                          sizeof(i), 0, nullptr, nullptr));
+    int output = 0;
+    ASSERT_SUCCESS(urEnqueueReadHostPipe(queue, program, "out", true, &output,
+                                         sizeof(output), 0, nullptr,
+                                         nullptr));
+    ASSERT_EQ(output, i + 1);
+  }
+
+  ASSERT_SUCCESS(urEventWait(1, &kernel_event));
+  EXPECT_SUCCESS(urEventRelease(kernel_event));
+  EXPECT_SUCCESS(urKernelRelease(kernel));
+}
+
+TEST_P(urNativeCpuHostPipeTest, ProgramsFromSameBinary) {
+  // Kernels reach the pipes through globals of the binary, so both programs
+  // must use the same pipes, which outlive either of them.
+  const auto *binary = reinterpret_cast<const uint8_t *>(Entries);
+  size_t binary_size = sizeof(Entries);
+  ur_program_handle_t other_program = nullptr;
+  ASSERT_SUCCESS(urProgramCreateWithBinary(context, 1, &device, &binary_size,
+                                           &binary, nullptr, &other_program));
+  ASSERT_SUCCESS(urProgramBuild(context, other_program, nullptr));
+
+  int input = 42;
+  ASSERT_SUCCESS(urEnqueueWriteHostPipe(queue, other_program, "in", true,
+                                        &input, sizeof(input), 0, nullptr,
+                                        nullptr));
+  int output = 0;
+  ASSERT_SUCCESS(urEnqueueReadHostPipe(queue, program, "in", true, &output,
+                                       sizeof(output), 0, nullptr, nullptr));
+  ASSERT_EQ(output, input);
+  ASSERT_SUCCESS(urProgramRelease(other_program));
+
+  constexpr int count = 4;
+  ur_kernel_handle_t kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "echo", &kernel));
+  ASSERT_SUCCESS(urKernelSetArgValue(kernel, 0, sizeof(count), nullptr,
+                                     &count));
+  for (int i = 0; i < count; i++) {
+    ASSERT_SUCCESS(urEnqueueWriteHostPipe(queue, program, "in", true, &i,
+                                          sizeof(i), 0, nullptr, nullptr));
+  }
+  const size_t offset = 0;
+  const size_t size = 1;
+  ASSERT_SUCCESS(urEnqueueKernelLaunch(queue, kernel, 1, &offset, &size, &size,
+                                       0, nullptr, nullptr));
+  for (int i = 0; i < count; i++) {
+    ASSERT_SUCCESS(urEnqueueReadHostPipe(queue, program, "out", true, &output,
+                                         sizeof(output), 0, nullptr,
+                                         nullptr));
+    ASSERT_EQ(output, i + 1);
+  }
+  EXPECT_SUCCESS(urKernelRelease(kernel));
+
+  // The globals are cleared with the last program using the pipes.
+  ASSERT_SUCCESS(urQueueFinish(queue));
+  ASSERT_SUCCESS(urProgramRelease(program));
+  program = nullptr;
+  EXPECT_EQ(InPipe, nullptr);
+  EXPECT_EQ(OutPipe, nullptr);
+}
+
+TEST_P(urNativeCpuHostPipeTest, InvalidPipeSymbol) {
+  int value = 0;
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_VALUE,
+                   urEnqueueReadHostPipe(queue, program, "not_a_pipe", true,
+                                         &value, sizeof(value), 0, nullptr,
+                                         nullptr));
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_VALUE,
+                   urEnqueueWriteHostPipe(queue, program, "not_a_pipe", true,
+                                          &value, sizeof(value), 0, nullptr,
+                                          nullptr));
+}
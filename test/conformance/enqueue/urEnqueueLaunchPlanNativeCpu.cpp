@@ -0,0 +1,114 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <algorithm>
+#include <array>
+#include <uur/fixtures.h>
+
+#include "nativecpu_state.hpp"
+
+// The native_cpu adapter reuses how it split a launch for later launches of
+// the same kernel over the same ND-range, so a launch differing only in its
+// offset or local size must not be run with the split of an earlier one.
+// Kernels are supplied as a table of entry points built in the process, as in
+// urEnqueueHostPipeNativeCpu.cpp.
+namespace {
+// Stores one more than the global id of the first work-item of each
+// work-group at the index of the work-group in the array in argument 0.
+void record_groups(void *const *args, native_cpu::state *state) {
+  auto *Groups = static_cast<uint32_t *>(args[0]);
+  Groups[state->MWorkGroup_id[0]] = static_cast<uint32_t>(
+      state->MGlobalOffset[0] +
+      state->MWorkGroup_id[0] * state->MWorkGroup_size[0] + 1);
+}
+
+nativecpu_entry Entries[] = {
+    {"record_groups", reinterpret_cast<const unsigned char *>(&record_groups)},
+    {nullptr, nullptr}};
+} // namespace
+
+struct urNativeCpuLaunchPlanTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::SetUp());
+
+    ur_platform_backend_t backend;
+    ASSERT_SUCCESS(urPlatformGetInfo(platform, UR_PLATFORM_INFO_BACKEND,
+                                     sizeof(backend), &backend, nullptr));
+    if (backend != UR_PLATFORM_BACKEND_NATIVE_CPU) {
+      GTEST_SKIP() << "The binary format is specific to native_cpu.";
+    }
+
+    const auto *binary = reinterpret_cast<const uint8_t *>(Entries);
+    size_t binary_size = sizeof(Entries);
+    ASSERT_SUCCESS(urProgramCreateWithBinary(context, 1, &device, &binary_size,
+                                             &binary, nullptr, &program));
+    ASSERT_SUCCESS(urProgramBuild(context, program, nullptr));
+    ASSERT_SUCCESS(urKernelCreate(program, "record_groups", &kernel));
+
+    ASSERT_SUCCESS(urUSMHostAlloc(context, nullptr, nullptr,
+                                  max_groups * sizeof(uint32_t), &groups));
+    ASSERT_SUCCESS(urKernelSetArgPointer(kernel, 0, nullptr, groups));
+  }
+
+  void TearDown() override {
+    if (groups) {
+      EXPECT_SUCCESS(urUSMFree(context, groups));
+    }
+    if (kernel) {
+      EXPECT_SUCCESS(urKernelRelease(kernel));
+    }
+    if (program) {
+      EXPECT_SUCCESS(urProgramRelease(program));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::TearDown());
+  }
+
+  static constexpr size_t max_groups = 4;
+  using groups_t = std::array<uint32_t, max_groups>;
+
+  // Launches the kernel over 8 work-items and returns what it recorded.
+  groups_t launch(size_t offset, size_t local_size) {
+    groups_t recorded = {};
+    std::fill_n(static_cast<uint32_t *>(groups), max_groups, 0);
+    const size_t global_size = 8;
+    EXPECT_SUCCESS(urEnqueueKernelLaunch(queue, kernel, 1, &offset,
+                                         &global_size, &local_size, 0, nullptr,
+                                         nullptr));
+    EXPECT_SUCCESS(urQueueFinish(queue));
+    std::copy_n(static_cast<uint32_t *>(groups), max_groups, recorded.begin());
+    return recorded;
+  }
+
+  ur_program_handle_t program = nullptr;
+  ur_kernel_handle_t kernel = nullptr;
+  void *groups = nullptr;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuLaunchPlanTest);
+
+TEST_P(urNativeCpuLaunchPlanTest, ChangedOffset) {
+  EXPECT_EQ(launch(0, 2), (groups_t{1, 3, 5, 7}));
+  EXPECT_EQ(launch(4, 2), (groups_t{5, 7, 9, 11}));
+  EXPECT_EQ(launch(0, 2), (groups_t{1, 3, 5, 7}));
+  EXPECT_EQ(launch(4, 2), (groups_t{5, 7, 9, 11}));
+}
+
+TEST_P(urNativeCpuLaunchPlanTest, ChangedLocalSize) {
+  EXPECT_EQ(launch(0, 2), (groups_t{1, 3, 5, 7}));
+  EXPECT_EQ(launch(0, 4), (groups_t{1, 5, 0, 0}));
+  EXPECT_EQ(launch(0, 2), (groups_t{1, 3, 5, 7}));
+  EXPECT_EQ(launch(4, 4), (groups_t{5, 9, 0, 0}));
+}
+
+TEST_P(urNativeCpuLaunchPlanTest, MoreRangesThanCached) {
+  // Only the plans of the latest few ranges are kept, so the second round
+  // replaces those of the first.
+  for (int round = 0; round < 2; round++) {
+    for (uint32_t offset = 0; offset < 20; offset++) {
+      ASSERT_EQ(launch(offset, 4), (groups_t{offset + 1, offset + 5, 0, 0}));
+    }
+  }
+}
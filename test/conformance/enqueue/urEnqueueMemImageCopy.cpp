@@ -13,8 +13,6 @@ struct urEnqueueMemImageCopyTest
     uint32_t data[4];
   };
   void SetUp() override {
-    UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
     UUR_RETURN_ON_FATAL_FAILURE(urQueueTestWithParam::SetUp());
 
     ur_bool_t imageSupported;
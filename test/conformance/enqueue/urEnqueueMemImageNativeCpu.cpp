@@ -0,0 +1,316 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <uur/fixtures.h>
+#include <vector>
+
+#include "nativecpu_state.hpp"
+
+// Kernels are supplied as a table of entry points built in the process, as in
+// urEnqueueHostPipeNativeCpu.cpp, so that they can use the image and sampler
+// descriptors the adapter passes for image and sampler arguments.
+namespace {
+using texel_t = std::array<float, 4>;
+
+// Reads each texel of a 2D image both directly and through the sampler, which
+// uses unnormalized coordinates and nearest filtering, storing the results
+// side by side.
+void read_and_sample(void *const *args, native_cpu::state *) {
+  const auto *Image = static_cast<const native_cpu::image_t *>(args[0]);
+  const auto *Sampler = static_cast<const native_cpu::sampler_t *>(args[1]);
+  auto *Out = static_cast<texel_t *>(args[2]);
+  for (size_t Y = 0; Y < Image->Extent[1]; Y++) {
+    for (size_t X = 0; X < Image->Extent[0]; X++) {
+      const float Coords[2] = {X + 0.5f, Y + 0.5f};
+      Image->Read(Image, X, Y, 0, Out->data());
+      Out++;
+      Sampler->Sample(Sampler, Image, Coords, Out->data());
+      Out++;
+    }
+  }
+}
+
+// Samples a 2D image halfway between each texel and the ones after it, so
+// that linear filtering blends four texels, or two or one at the far edges.
+void sample_between(void *const *args, native_cpu::state *) {
+  const auto *Image = static_cast<const native_cpu::image_t *>(args[0]);
+  const auto *Sampler = static_cast<const native_cpu::sampler_t *>(args[1]);
+  auto *Out = static_cast<texel_t *>(args[2]);
+  for (size_t Y = 0; Y < Image->Extent[1]; Y++) {
+    for (size_t X = 0; X < Image->Extent[0]; X++) {
+      const float Coords[2] = {X + 1.0f, Y + 1.0f};
+      Sampler->Sample(Sampler, Image, Coords, Out->data());
+      Out++;
+    }
+  }
+}
+
+std::atomic<bool> Release{false};
+
+// Holds up whatever depends on it until Release is set.
+void wait_for_release(void *const *, native_cpu::state *) {
+  while (!Release.load()) {
+    std::this_thread::yield();
+  }
+}
+
+nativecpu_entry Entries[] = {
+    {"read_and_sample",
+     reinterpret_cast<const unsigned char *>(&read_and_sample)},
+    {"sample_between",
+     reinterpret_cast<const unsigned char *>(&sample_between)},
+    {"wait_for_release",
+     reinterpret_cast<const unsigned char *>(&wait_for_release)},
+    {nullptr, nullptr}};
+
+texel_t expectedTexel(size_t x, size_t y) {
+  return {float(x), float(y), float(x + y), 1.0f};
+}
+} // namespace
+
+struct urNativeCpuMemImageTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::SetUp());
+
+    ur_platform_backend_t backend;
+    ASSERT_SUCCESS(urPlatformGetInfo(platform, UR_PLATFORM_INFO_BACKEND,
+                                     sizeof(backend), &backend, nullptr));
+    if (backend != UR_PLATFORM_BACKEND_NATIVE_CPU) {
+      GTEST_SKIP() << "The binary format is specific to native_cpu.";
+    }
+
+    const auto *binary = reinterpret_cast<const uint8_t *>(Entries);
+    size_t binary_size = sizeof(Entries);
+    ASSERT_SUCCESS(urProgramCreateWithBinary(context, 1, &device, &binary_size,
+                                             &binary, nullptr, &program));
+    ASSERT_SUCCESS(urProgramBuild(context, program, nullptr));
+
+    ur_queue_properties_t ooo_properties = {
+        UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+        UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE};
+    ASSERT_SUCCESS(urQueueCreate(context, device, &ooo_properties, &ooo_queue));
+
+    ASSERT_SUCCESS(urMemImageCreate(context, UR_MEM_FLAG_READ_WRITE, &format,
+                                    &desc, nullptr, &image));
+    for (size_t y = 0; y < height; y++) {
+      for (size_t x = 0; x < width; x++) {
+        input.push_back(expectedTexel(x, y));
+      }
+    }
+    ASSERT_SUCCESS(urEnqueueMemImageWrite(queue, image, true, origin, region,
+                                          0, 0, input.data(), 0, nullptr,
+                                          nullptr));
+  }
+
+  void TearDown() override {
+    if (image) {
+      EXPECT_SUCCESS(urMemRelease(image));
+    }
+    if (ooo_queue) {
+      EXPECT_SUCCESS(urQueueRelease(ooo_queue));
+    }
+    if (program) {
+      EXPECT_SUCCESS(urProgramRelease(program));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::TearDown());
+  }
+
+  // Large enough for copies to be split between the device's threads.
+  static constexpr size_t width = 512;
+  static constexpr size_t height = 256;
+  ur_image_format_t format = {UR_IMAGE_CHANNEL_ORDER_RGBA,
+                              UR_IMAGE_CHANNEL_TYPE_FLOAT};
+  ur_image_desc_t desc = {UR_STRUCTURE_TYPE_IMAGE_DESC, // stype
+                          nullptr,                      // pNext
+                          UR_MEM_TYPE_IMAGE2D,          // mem object type
+                          width,                        // image width
+                          height,                       // image height
+                          1,                            // image depth
+                          1,                            // array size
+                          0,                            // row pitch
+                          0,                            // slice pitch
+                          0,                            // mip levels
+                          0};                           // num samples
+  ur_rect_offset_t origin{0, 0, 0};
+  ur_rect_region_t region{width, height, 1};
+
+  ur_program_handle_t program = nullptr;
+  ur_queue_handle_t ooo_queue = nullptr;
+  ur_mem_handle_t image = nullptr;
+  std::vector<texel_t> input;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuMemImageTest);
+
+TEST_P(urNativeCpuMemImageTest, KernelReadsAndSamples) {
+  ur_sampler_desc_t sampler_desc{UR_STRUCTURE_TYPE_SAMPLER_DESC, nullptr,
+                                 false,
+                                 UR_SAMPLER_ADDRESSING_MODE_CLAMP_TO_EDGE,
+                                 UR_SAMPLER_FILTER_MODE_NEAREST};
+  ur_sampler_handle_t sampler = nullptr;
+  ASSERT_SUCCESS(urSamplerCreate(context, &sampler_desc, &sampler));
+
+  ur_mem_handle_t output = nullptr;
+  std::vector<texel_t> results(width * height * 2);
+  ASSERT_SUCCESS(urMemBufferCreate(context, UR_MEM_FLAG_WRITE_ONLY,
+                                   results.size() * sizeof(texel_t), nullptr,
+                                   &output));
+
+  ur_kernel_handle_t kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "read_and_sample", &kernel));
+  ASSERT_SUCCESS(urKernelSetArgMemObj(kernel, 0, nullptr, image));
+  ASSERT_SUCCESS(urKernelSetArgSampler(kernel, 1, nullptr, sampler));
+  ASSERT_SUCCESS(urKernelSetArgMemObj(kernel, 2, nullptr, output));
+
+  const size_t offset = 0;
+  const size_t size = 1;
+  ASSERT_SUCCESS(urEnqueueKernelLaunch(queue, kernel, 1, &offset, &size, &size,
+                                       0, nullptr, nullptr));
+  ASSERT_SUCCESS(urEnqueueMemBufferRead(queue, output, true, 0,
+                                        results.size() * sizeof(texel_t),
+                                        results.data(), 0, nullptr, nullptr));
+
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      const size_t index = (y * width + x) * 2;
+      ASSERT_EQ(results[index], expectedTexel(x, y)) << x << ", " << y;
+      ASSERT_EQ(results[index + 1], expectedTexel(x, y)) << x << ", " << y;
+    }
+  }
+
+  EXPECT_SUCCESS(urKernelRelease(kernel));
+  EXPECT_SUCCESS(urMemRelease(output));
+  EXPECT_SUCCESS(urSamplerRelease(sampler));
+}
+
+TEST_P(urNativeCpuMemImageTest, KernelSamplesLinear) {
+  ur_sampler_desc_t sampler_desc{UR_STRUCTURE_TYPE_SAMPLER_DESC, nullptr,
+                                 false,
+                                 UR_SAMPLER_ADDRESSING_MODE_CLAMP_TO_EDGE,
+                                 UR_SAMPLER_FILTER_MODE_LINEAR};
+  ur_sampler_handle_t sampler = nullptr;
+  ASSERT_SUCCESS(urSamplerCreate(context, &sampler_desc, &sampler));
+
+  ur_mem_handle_t output = nullptr;
+  std::vector<texel_t> results(width * height);
+  ASSERT_SUCCESS(urMemBufferCreate(context, UR_MEM_FLAG_WRITE_ONLY,
+                                   results.size() * sizeof(texel_t), nullptr,
+                                   &output));
+
+  ur_kernel_handle_t kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "sample_between", &kernel));
+  ASSERT_SUCCESS(urKernelSetArgMemObj(kernel, 0, nullptr, image));
+  ASSERT_SUCCESS(urKernelSetArgSampler(kernel, 1, nullptr, sampler));
+  ASSERT_SUCCESS(urKernelSetArgMemObj(kernel, 2, nullptr, output));
+
+  const size_t offset = 0;
+  const size_t size = 1;
+  ASSERT_SUCCESS(urEnqueueKernelLaunch(queue, kernel, 1, &offset, &size, &size,
+                                       0, nullptr, nullptr));
+  ASSERT_SUCCESS(urEnqueueMemBufferRead(queue, output, true, 0,
+                                        results.size() * sizeof(texel_t),
+                                        results.data(), 0, nullptr, nullptr));
+
+  // Past the last row or column the edge texels are repeated.
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      const float fx = x + 1 < width ? x + 0.5f : x;
+      const float fy = y + 1 < height ? y + 0.5f : y;
+      const texel_t expected = {fx, fy, fx + fy, 1.0f};
+      ASSERT_EQ(results[y * width + x], expected) << x << ", " << y;
+    }
+  }
+
+  EXPECT_SUCCESS(urKernelRelease(kernel));
+  EXPECT_SUCCESS(urMemRelease(output));
+  EXPECT_SUCCESS(urSamplerRelease(sampler));
+}
+
+TEST_P(urNativeCpuMemImageTest, NonBlockingReadWaitsForDependencies) {
+  ur_kernel_handle_t kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "wait_for_release", &kernel));
+
+  Release = false;
+  const size_t offset = 0;
+  const size_t size = 1;
+  ur_event_handle_t kernel_event = nullptr;
+  ASSERT_SUCCESS(urEnqueueKernelLaunch(ooo_queue, kernel, 1, &offset, &size,
+                                       &size, 0, nullptr, &kernel_event));
+
+  // The read can't start before the kernel has finished, which it won't do
+  // until this thread lets it, so the read must return without waiting.
+  std::vector<texel_t> output(width * height);
+  ur_event_handle_t read_event = nullptr;
+  ASSERT_SUCCESS(urEnqueueMemImageRead(ooo_queue, image, false, origin, region,
+                                       0, 0, output.data(), 1, &kernel_event,
+                                       &read_event));
+
+  ur_event_status_t status;
+  ASSERT_SUCCESS(urEventGetInfo(read_event,
+                                UR_EVENT_INFO_COMMAND_EXECUTION_STATUS,
+                                sizeof(status), &status, nullptr));
+  EXPECT_NE(status, UR_EVENT_STATUS_COMPLETE);
+
+  Release = true;
+  ASSERT_SUCCESS(urEventWait(1, &read_event));
+  ASSERT_EQ(output, input);
+
+  EXPECT_SUCCESS(urEventRelease(read_event));
+  EXPECT_SUCCESS(urEventRelease(kernel_event));
+  EXPECT_SUCCESS(urKernelRelease(kernel));
+}
+
+TEST_P(urNativeCpuMemImageTest, CopyOverlappingRegions) {
+  // Shift the image one texel right and down within itself.
+  const ur_rect_offset_t dst_origin{1, 1, 0};
+  const ur_rect_region_t copy_region{width - 1, height - 1, 1};
+  ASSERT_SUCCESS(urEnqueueMemImageCopy(queue, image, image, origin, dst_origin,
+                                       copy_region, 0, nullptr, nullptr));
+
+  std::vector<texel_t> output(width * height);
+  ASSERT_SUCCESS(urEnqueueMemImageRead(queue, image, true, origin, region, 0,
+                                       0, output.data(), 0, nullptr, nullptr));
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      const texel_t expected = x && y ? expectedTexel(x - 1, y - 1)
+                                      : expectedTexel(x, y);
+      ASSERT_EQ(output[y * width + x], expected) << x << ", " << y;
+    }
+  }
+}
+
+TEST_P(urNativeCpuMemImageTest, TooManyImageArgs) {
+  uint32_t max_write_image_args = 0;
+  ASSERT_SUCCESS(urDeviceGetInfo(device, UR_DEVICE_INFO_MAX_WRITE_IMAGE_ARGS,
+                                 sizeof(max_write_image_args),
+                                 &max_write_image_args, nullptr));
+
+  ur_kernel_handle_t kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "read_and_sample", &kernel));
+  ur_kernel_arg_mem_obj_properties_t write_only{
+      UR_STRUCTURE_TYPE_KERNEL_ARG_MEM_OBJ_PROPERTIES, nullptr,
+      UR_MEM_FLAG_WRITE_ONLY};
+  for (uint32_t i = 0; i < max_write_image_args; i++) {
+    ASSERT_SUCCESS(urKernelSetArgMemObj(kernel, i, &write_only, image));
+  }
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_OUT_OF_RESOURCES,
+                   urKernelSetArgMemObj(kernel, max_write_image_args,
+                                        &write_only, image));
+
+  // Replacing an image argument, or making it read-only, frees its slot.
+  ASSERT_SUCCESS(urKernelSetArgMemObj(kernel, 0, &write_only, image));
+  ur_kernel_arg_mem_obj_properties_t read_only{
+      UR_STRUCTURE_TYPE_KERNEL_ARG_MEM_OBJ_PROPERTIES, nullptr,
+      UR_MEM_FLAG_READ_ONLY};
+  ASSERT_SUCCESS(urKernelSetArgMemObj(kernel, 0, &read_only, image));
+  ASSERT_SUCCESS(urKernelSetArgMemObj(kernel, max_write_image_args,
+                                      &write_only, image));
+
+  EXPECT_SUCCESS(urKernelRelease(kernel));
+}
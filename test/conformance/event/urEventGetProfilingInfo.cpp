@@ -129,8 +129,6 @@ TEST_P(urEventGetProfilingInfoTest, Success) {
 }
 
 TEST_P(urEventGetProfilingInfoTest, InvalidNullHandle) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   const ur_profiling_info_t property_name = UR_PROFILING_INFO_COMMAND_QUEUED;
   size_t property_size;
   ASSERT_SUCCESS(urEventGetProfilingInfo(event, property_name, 0, nullptr,
@@ -238,8 +236,6 @@ struct urEventGetProfilingInfoInvalidQueue : uur::urQueueTest {
 UUR_INSTANTIATE_DEVICE_TEST_SUITE(urEventGetProfilingInfoInvalidQueue);
 
 TEST_P(urEventGetProfilingInfoInvalidQueue, ProfilingInfoNotAvailable) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   const ur_profiling_info_t property_name = UR_PROFILING_INFO_COMMAND_QUEUED;
   size_t property_size;
   ASSERT_EQ_RESULT(
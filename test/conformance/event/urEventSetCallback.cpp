@@ -15,7 +15,7 @@ using urEventSetCallbackTest = uur::event::urEventReferenceTest;
  */
 TEST_P(urEventSetCallbackTest, Success) {
   UUR_KNOWN_FAILURE_ON(uur::CUDA{}, uur::HIP{}, uur::LevelZero{},
-                       uur::LevelZeroV2{}, uur::NativeCPU{});
+                       uur::LevelZeroV2{});
 
   struct Callback {
     static void callback([[maybe_unused]] ur_event_handle_t hEvent,
@@ -42,7 +42,7 @@ TEST_P(urEventSetCallbackTest, Success) {
  */
 TEST_P(urEventSetCallbackTest, ValidateParameters) {
   UUR_KNOWN_FAILURE_ON(uur::CUDA{}, uur::HIP{}, uur::LevelZero{},
-                       uur::LevelZeroV2{}, uur::NativeCPU{});
+                       uur::LevelZeroV2{});
 
   struct CallbackParameters {
     ur_event_handle_t event;
@@ -77,7 +77,7 @@ TEST_P(urEventSetCallbackTest, ValidateParameters) {
  */
 TEST_P(urEventSetCallbackTest, AllStates) {
   UUR_KNOWN_FAILURE_ON(uur::CUDA{}, uur::HIP{}, uur::LevelZero{},
-                       uur::LevelZeroV2{}, uur::NativeCPU{});
+                       uur::LevelZeroV2{});
 
   struct CallbackStatus {
     bool submitted = false;
@@ -136,7 +136,7 @@ TEST_P(urEventSetCallbackTest, AllStates) {
  */
 TEST_P(urEventSetCallbackTest, EventAlreadyCompleted) {
   UUR_KNOWN_FAILURE_ON(uur::CUDA{}, uur::HIP{}, uur::LevelZero{},
-                       uur::LevelZeroV2{}, uur::NativeCPU{});
+                       uur::LevelZeroV2{});
 
   ASSERT_SUCCESS(urEventWait(1, &event));
 
@@ -0,0 +1,60 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <algorithm>
+#include <uur/fixtures.h>
+#include <uur/known_failure.h>
+
+struct urEnqueueCooperativeKernelLaunchTest : uur::urKernelExecutionTest {
+  void SetUp() override {
+    program_name = "fill";
+    UUR_RETURN_ON_FATAL_FAILURE(urKernelExecutionTest::SetUp());
+
+    size_t returned_size;
+    ASSERT_SUCCESS(urDeviceGetInfo(device, UR_DEVICE_INFO_EXTENSIONS, 0,
+                                   nullptr, &returned_size));
+
+    std::unique_ptr<char[]> returned_extensions(new char[returned_size]);
+
+    ASSERT_SUCCESS(urDeviceGetInfo(device, UR_DEVICE_INFO_EXTENSIONS,
+                                   returned_size, returned_extensions.get(),
+                                   nullptr));
+
+    std::string_view extensions_string(returned_extensions.get());
+    if (extensions_string.find(UR_COOPERATIVE_KERNELS_EXTENSION_STRING_EXP) ==
+        std::string::npos) {
+      GTEST_SKIP() << "EXP cooperative kernels feature is not supported.";
+    }
+  }
+
+  uint32_t val = 42;
+  size_t local_size = 1;
+  size_t global_offset = 0;
+  size_t n_dimensions = 1;
+};
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urEnqueueCooperativeKernelLaunchTest);
+
+TEST_P(urEnqueueCooperativeKernelLaunchTest, SuggestMaxGroupCount) {
+  uint32_t group_count = 0;
+  ASSERT_SUCCESS(urKernelSuggestMaxCooperativeGroupCountExp(
+      kernel, device, n_dimensions, &local_size, 0, &group_count));
+  ASSERT_GT(group_count, 0u);
+}
+
+TEST_P(urEnqueueCooperativeKernelLaunchTest, Success) {
+  uint32_t group_count = 0;
+  ASSERT_SUCCESS(urKernelSuggestMaxCooperativeGroupCountExp(
+      kernel, device, n_dimensions, &local_size, 0, &group_count));
+
+  size_t global_size = std::min<size_t>(group_count, 32) * local_size;
+  ur_mem_handle_t buffer = nullptr;
+  AddBuffer1DArg(sizeof(val) * global_size, &buffer);
+  AddPodArg(val);
+  ASSERT_SUCCESS(urEnqueueCooperativeKernelLaunchExp(
+      queue, kernel, n_dimensions, &global_offset, &global_size, &local_size,
+      0, nullptr, nullptr));
+  ASSERT_SUCCESS(urQueueFinish(queue));
+  ValidateBuffer(buffer, sizeof(val) * global_size, val);
+}
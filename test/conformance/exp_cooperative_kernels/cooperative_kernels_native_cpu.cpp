@@ -0,0 +1,120 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <uur/fixtures.h>
+
+#include "nativecpu_state.hpp"
+
+// Every work-group of a cooperative launch of at most the suggested number of
+// groups runs at the same time, so they can wait on each other. Kernels are
+// supplied as a table of entry points built in the process, as in the
+// native_cpu enqueue tests.
+namespace {
+std::atomic<uint32_t> Arrived[2];
+
+// Waits until Groups work-groups have arrived at Counter, or gives up after a
+// while so that work-groups that don't run together fail the test rather than
+// hang it.
+bool wait_for_groups(std::atomic<uint32_t> &Counter, uint32_t Groups) {
+  Counter.fetch_add(1);
+  const auto Deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (Counter.load() < Groups) {
+    if (std::chrono::steady_clock::now() > Deadline)
+      return false;
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+// Each work-group stores one more than its id in the array in argument 0,
+// and, between two grid barriers, reads what the next work-group stored and
+// then stores that in its place.
+void grid_barrier(void *const *args, native_cpu::state *state) {
+  auto *Array = static_cast<uint32_t *>(args[0]);
+  const uint32_t Groups = *static_cast<const uint32_t *>(args[1]);
+  const auto Group = static_cast<uint32_t>(state->MWorkGroup_id[0]);
+  Array[Group] = Group + 1;
+  if (!wait_for_groups(Arrived[0], Groups))
+    return;
+  const uint32_t Next = Array[(Group + 1) % Groups];
+  if (!wait_for_groups(Arrived[1], Groups))
+    return;
+  Array[Group] = Next;
+}
+
+nativecpu_entry Entries[] = {
+    {"grid_barrier", reinterpret_cast<const unsigned char *>(&grid_barrier)},
+    {nullptr, nullptr}};
+} // namespace
+
+struct urNativeCpuCooperativeKernelLaunchTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::SetUp());
+
+    ur_platform_backend_t backend;
+    ASSERT_SUCCESS(urPlatformGetInfo(platform, UR_PLATFORM_INFO_BACKEND,
+                                     sizeof(backend), &backend, nullptr));
+    if (backend != UR_PLATFORM_BACKEND_NATIVE_CPU) {
+      GTEST_SKIP() << "The binary format is specific to native_cpu.";
+    }
+
+    const auto *binary = reinterpret_cast<const uint8_t *>(Entries);
+    size_t binary_size = sizeof(Entries);
+    ASSERT_SUCCESS(urProgramCreateWithBinary(context, 1, &device, &binary_size,
+                                             &binary, nullptr, &program));
+    ASSERT_SUCCESS(urProgramBuild(context, program, nullptr));
+    ASSERT_SUCCESS(urKernelCreate(program, "grid_barrier", &kernel));
+  }
+
+  void TearDown() override {
+    if (kernel) {
+      EXPECT_SUCCESS(urKernelRelease(kernel));
+    }
+    if (program) {
+      EXPECT_SUCCESS(urProgramRelease(program));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::TearDown());
+  }
+
+  ur_program_handle_t program = nullptr;
+  ur_kernel_handle_t kernel = nullptr;
+};
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuCooperativeKernelLaunchTest);
+
+TEST_P(urNativeCpuCooperativeKernelLaunchTest, GridBarrier) {
+  const size_t local_size = 1;
+  uint32_t group_count = 0;
+  ASSERT_SUCCESS(urKernelSuggestMaxCooperativeGroupCountExp(
+      kernel, device, 1, &local_size, 0, &group_count));
+  ASSERT_GT(group_count, 0u);
+
+  uint32_t *array = nullptr;
+  ASSERT_SUCCESS(urUSMHostAlloc(context, nullptr, nullptr,
+                                group_count * sizeof(uint32_t),
+                                reinterpret_cast<void **>(&array)));
+  ASSERT_SUCCESS(urKernelSetArgPointer(kernel, 0, nullptr, array));
+  ASSERT_SUCCESS(urKernelSetArgValue(kernel, 1, sizeof(group_count), nullptr,
+                                     &group_count));
+
+  // Each launch has to get all the workers again.
+  for (int round = 0; round < 3; round++) {
+    Arrived[0] = 0;
+    Arrived[1] = 0;
+    const size_t offset = 0;
+    const size_t global_size = group_count * local_size;
+    ASSERT_SUCCESS(urEnqueueCooperativeKernelLaunchExp(
+        queue, kernel, 1, &offset, &global_size, &local_size, 0, nullptr,
+        nullptr));
+    ASSERT_SUCCESS(urQueueFinish(queue));
+    for (uint32_t i = 0; i < group_count; i++) {
+      ASSERT_EQ(array[i], (i + 1) % group_count + 1) << round << ", " << i;
+    }
+  }
+  EXPECT_SUCCESS(urUSMFree(context, array));
+}
@@ -0,0 +1,176 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <algorithm>
+#include <uur/fixtures.h>
+#include <vector>
+
+using T = uint32_t;
+
+struct urNativeCpuEnqueueNativeCommandTest : uur::urQueueTest {
+  void SetUp() {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::SetUp());
+
+    ur_bool_t native_enqueue_support = false;
+    ASSERT_SUCCESS(urDeviceGetInfo(
+        device, UR_DEVICE_INFO_ENQUEUE_NATIVE_COMMAND_SUPPORT_EXP,
+        sizeof(native_enqueue_support), &native_enqueue_support, nullptr));
+    if (!native_enqueue_support) {
+      GTEST_SKIP();
+    }
+
+    host_vec = std::vector<T>(global_size, 0);
+    ASSERT_SUCCESS(urMemBufferCreate(context, UR_MEM_FLAG_READ_WRITE,
+                                     allocation_size, nullptr, &buffer));
+  }
+
+  void TearDown() {
+    if (buffer) {
+      EXPECT_SUCCESS(urMemRelease(buffer));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::TearDown());
+  }
+
+  static constexpr T val = 42;
+  static constexpr uint32_t global_size = 1 << 20;
+  static constexpr size_t allocation_size = sizeof(val) * global_size;
+  std::vector<T> host_vec;
+  ur_mem_handle_t buffer = nullptr;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuEnqueueNativeCommandTest);
+
+struct InteropData {
+  ur_mem_handle_t buffer;
+  T *host_ptr;
+};
+
+// Fill the buffer with the pattern val through its native pointer
+void interop_fill(ur_queue_handle_t, void *data) {
+  auto *func_data = reinterpret_cast<InteropData *>(data);
+  T *ptr = nullptr;
+  ASSERT_SUCCESS(urMemGetNativeHandle(func_data->buffer, nullptr,
+                                      (ur_native_handle_t *)&ptr));
+  std::fill_n(ptr, urNativeCpuEnqueueNativeCommandTest::global_size,
+              urNativeCpuEnqueueNativeCommandTest::val);
+}
+
+// Copy the buffer to a host pointer through its native pointer
+void interop_read(ur_queue_handle_t, void *data) {
+  auto *func_data = reinterpret_cast<InteropData *>(data);
+  T *ptr = nullptr;
+  ASSERT_SUCCESS(urMemGetNativeHandle(func_data->buffer, nullptr,
+                                      (ur_native_handle_t *)&ptr));
+  std::copy_n(ptr, urNativeCpuEnqueueNativeCommandTest::global_size,
+              func_data->host_ptr);
+}
+
+TEST_P(urNativeCpuEnqueueNativeCommandTest, Success) {
+  InteropData data{buffer, nullptr};
+  ur_event_handle_t event = nullptr;
+  ASSERT_SUCCESS(urEnqueueNativeCommandExp(
+      queue, &interop_fill, &data, 1, &buffer, nullptr /*pProperties=*/, 0,
+      nullptr /*phEventWaitList=*/, &event));
+  ASSERT_SUCCESS(urEventWait(1, &event));
+  ASSERT_SUCCESS(urEventRelease(event));
+}
+
+TEST_P(urNativeCpuEnqueueNativeCommandTest, Dependencies) {
+  ur_event_handle_t event_1, event_2;
+
+  InteropData data_1{buffer, nullptr};
+  ASSERT_SUCCESS(urEnqueueNativeCommandExp(
+      queue, &interop_fill, &data_1, 1, &buffer, nullptr /*pProperties=*/, 0,
+      nullptr /*phEventWaitList=*/, &event_1));
+
+  InteropData data_2{buffer, host_vec.data()};
+  ASSERT_SUCCESS(urEnqueueNativeCommandExp(
+      queue, &interop_read, &data_2, 1, &buffer, nullptr /*pProperties=*/, 1,
+      &event_1, &event_2));
+  ASSERT_SUCCESS(urQueueFinish(queue));
+  for (auto &i : host_vec) {
+    ASSERT_EQ(i, val);
+  }
+  ASSERT_SUCCESS(urEventRelease(event_1));
+  ASSERT_SUCCESS(urEventRelease(event_2));
+}
+
+TEST_P(urNativeCpuEnqueueNativeCommandTest, DependenciesURBefore) {
+  ur_event_handle_t event_1, event_2;
+
+  ASSERT_SUCCESS(urEnqueueMemBufferFill(queue, buffer, &val, sizeof(val), 0,
+                                        allocation_size, 0,
+                                        nullptr /*phEventWaitList=*/,
+                                        &event_1));
+
+  InteropData data_2{buffer, host_vec.data()};
+  ASSERT_SUCCESS(urEnqueueNativeCommandExp(
+      queue, &interop_read, &data_2, 1, &buffer, nullptr /*pProperties=*/, 1,
+      &event_1, &event_2));
+  ASSERT_SUCCESS(urQueueFinish(queue));
+  for (auto &i : host_vec) {
+    ASSERT_EQ(i, val);
+  }
+  ASSERT_SUCCESS(urEventRelease(event_1));
+  ASSERT_SUCCESS(urEventRelease(event_2));
+}
+
+TEST_P(urNativeCpuEnqueueNativeCommandTest, DependenciesURAfter) {
+  ur_event_handle_t event_1;
+
+  InteropData data_1{buffer, nullptr};
+  ASSERT_SUCCESS(urEnqueueNativeCommandExp(
+      queue, &interop_fill, &data_1, 1, &buffer, nullptr /*pProperties=*/, 0,
+      nullptr /*phEventWaitList=*/, &event_1));
+
+  ASSERT_SUCCESS(urEnqueueMemBufferRead(queue, buffer, /*blocking*/ true, 0,
+                                        allocation_size, host_vec.data(), 1,
+                                        &event_1, nullptr));
+  for (auto &i : host_vec) {
+    ASSERT_EQ(i, val);
+  }
+  ASSERT_SUCCESS(urEventRelease(event_1));
+}
+
+TEST_P(urNativeCpuEnqueueNativeCommandTest, InvalidNullPointerFunction) {
+  ASSERT_EQ_RESULT(urEnqueueNativeCommandExp(queue, nullptr, nullptr, 0,
+                                             nullptr, nullptr, 0, nullptr,
+                                             nullptr),
+                   UR_RESULT_ERROR_INVALID_NULL_POINTER);
+}
+
+TEST_P(urNativeCpuEnqueueNativeCommandTest, SuccessWithoutEvent) {
+  InteropData data_1{buffer, nullptr};
+  ASSERT_SUCCESS(urEnqueueNativeCommandExp(
+      queue, &interop_fill, &data_1, 1, &buffer, nullptr /*pProperties=*/, 0,
+      nullptr /*phEventWaitList=*/, nullptr /*phEvent=*/));
+
+  InteropData data_2{buffer, host_vec.data()};
+  ASSERT_SUCCESS(urEnqueueNativeCommandExp(
+      queue, &interop_read, &data_2, 1, &buffer, nullptr /*pProperties=*/, 0,
+      nullptr /*phEventWaitList=*/, nullptr /*phEvent=*/));
+  ASSERT_SUCCESS(urQueueFinish(queue));
+  for (auto &i : host_vec) {
+    ASSERT_EQ(i, val);
+  }
+}
+
+TEST_P(urNativeCpuEnqueueNativeCommandTest, InvalidNullPointerMemList) {
+  InteropData data{buffer, nullptr};
+  ASSERT_EQ_RESULT(urEnqueueNativeCommandExp(queue, &interop_fill, &data, 1,
+                                             nullptr, nullptr, 0, nullptr,
+                                             nullptr),
+                   UR_RESULT_ERROR_INVALID_NULL_POINTER);
+}
+
+TEST_P(urNativeCpuEnqueueNativeCommandTest, InvalidNullHandleMem) {
+  InteropData data{buffer, nullptr};
+  ur_mem_handle_t mems[] = {buffer, nullptr};
+  ASSERT_EQ_RESULT(urEnqueueNativeCommandExp(queue, &interop_fill, &data, 2,
+                                             mems, nullptr, 0, nullptr,
+                                             nullptr),
+                   UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+}
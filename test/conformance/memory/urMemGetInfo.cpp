@@ -12,8 +12,6 @@ using urMemGetInfoTest = uur::urMemBufferTest;
 UUR_INSTANTIATE_DEVICE_TEST_SUITE(urMemGetInfoTest);
 
 TEST_P(urMemGetInfoTest, SuccessSize) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   const ur_mem_info_t property_name = UR_MEM_INFO_SIZE;
   size_t property_size = 0;
 
@@ -31,8 +29,6 @@ TEST_P(urMemGetInfoTest, SuccessSize) {
 }
 
 TEST_P(urMemGetInfoTest, SuccessContext) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   const ur_mem_info_t property_name = UR_MEM_INFO_CONTEXT;
   size_t property_size = 0;
 
@@ -49,8 +45,6 @@ TEST_P(urMemGetInfoTest, SuccessContext) {
 }
 
 TEST_P(urMemGetInfoTest, SuccessReferenceCount) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   const ur_mem_info_t property_name = UR_MEM_INFO_REFERENCE_COUNT;
   size_t property_size = 0;
 
@@ -91,8 +85,6 @@ TEST_P(urMemGetInfoTest, InvalidSizeZero) {
 }
 
 TEST_P(urMemGetInfoTest, InvalidSizeSmall) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   size_t property_size = 0;
   ASSERT_EQ_RESULT(urMemGetInfo(buffer, UR_MEM_INFO_SIZE,
                                 sizeof(property_size) - 1, &property_size,
@@ -97,7 +97,6 @@ UUR_DEVICE_TEST_SUITE_WITH_PARAM(
     uur::deviceTestWithParamPrinter<ur_image_format_t>);
 
 TEST_P(urMemImageCreateTestWithImageFormatParam, Success) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
   // See https://github.com/oneapi-src/unified-runtime/issues/2638
   UUR_KNOWN_FAILURE_ON(uur::OpenCL{"Intel(R) UHD Graphics 770"});
 
@@ -3,16 +3,12 @@
 // Exceptions. See LICENSE.TXT
 //
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
-#include "uur/known_failure.h"
 #include <uur/fixtures.h>
-#include <uur/known_failure.h>
 
 using urMemReleaseTest = uur::urMemBufferTest;
 UUR_INSTANTIATE_DEVICE_TEST_SUITE(urMemReleaseTest);
 
 TEST_P(urMemReleaseTest, Success) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   ASSERT_SUCCESS(urMemRetain(buffer));
   ASSERT_SUCCESS(urMemRelease(buffer));
 }
@@ -22,8 +18,6 @@ TEST_P(urMemReleaseTest, InvalidNullHandleMem) {
 }
 
 TEST_P(urMemReleaseTest, CheckReferenceCount) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   uint32_t referenceCount = 0;
   ASSERT_SUCCESS(urMemGetInfo(buffer, UR_MEM_INFO_REFERENCE_COUNT,
                               sizeof(referenceCount), &referenceCount,
@@ -0,0 +1,33 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// A shared object of native_cpu kernels, loaded as a program binary by
+// urProgramNativeCpuSharedObject.cpp. Kernels and symbol tables are exported
+// under their own names, as the adapter looks them up.
+
+#include <cstdint>
+
+#include "nativecpu_state.hpp"
+
+namespace {
+struct device_global_entry_t {
+  const char *name;
+  void *addr;
+  uint64_t size;
+};
+
+uint32_t Global[4] = {7, 8, 9, 10};
+} // namespace
+
+extern "C" {
+// Adds one to the element of the array in argument 0 at the global id.
+void increment(void *const *args, native_cpu::state *state) {
+  static_cast<uint32_t *>(args[0])[state->MGlobal_id[0]] += 1;
+}
+
+device_global_entry_t __nativecpu_device_globals[] = {
+    {"Global", Global, sizeof(Global)}, {nullptr, nullptr, 0}};
+}
@@ -0,0 +1,148 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <uur/fixtures.h>
+#include <vector>
+
+// The native_cpu adapter accepts an ELF shared object as a program binary,
+// given either as its image or as its path after a "file://" prefix, and
+// resolves each kernel from it when the kernel is first created. The shared
+// object is built from nativecpu_test_kernels.cpp.
+struct urNativeCpuSharedObjectTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::SetUp());
+
+    ur_platform_backend_t backend;
+    ASSERT_SUCCESS(urPlatformGetInfo(platform, UR_PLATFORM_INFO_BACKEND,
+                                     sizeof(backend), &backend, nullptr));
+    if (backend != UR_PLATFORM_BACKEND_NATIVE_CPU) {
+      GTEST_SKIP() << "Shared object binaries are specific to native_cpu.";
+    }
+  }
+
+  void TearDown() override {
+    if (program) {
+      EXPECT_SUCCESS(urProgramRelease(program));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::TearDown());
+  }
+
+  void createProgram(const std::vector<uint8_t> &binary) {
+    const uint8_t *data = binary.data();
+    size_t size = binary.size();
+    ASSERT_SUCCESS(urProgramCreateWithBinary(context, 1, &device, &size, &data,
+                                             nullptr, &program));
+    ASSERT_SUCCESS(urProgramBuild(context, program, nullptr));
+  }
+
+  // Runs the increment kernel of the program over an array of its indices.
+  void checkIncrement() {
+    ur_kernel_handle_t kernel = nullptr;
+    ASSERT_SUCCESS(urKernelCreate(program, "increment", &kernel));
+    constexpr size_t count = 64;
+    uint32_t *array = nullptr;
+    ASSERT_SUCCESS(urUSMHostAlloc(context, nullptr, nullptr,
+                                  count * sizeof(uint32_t),
+                                  reinterpret_cast<void **>(&array)));
+    for (uint32_t i = 0; i < count; i++) {
+      array[i] = i;
+    }
+    ASSERT_SUCCESS(urKernelSetArgPointer(kernel, 0, nullptr, array));
+    const size_t offset = 0;
+    const size_t local_size = 8;
+    ASSERT_SUCCESS(urEnqueueKernelLaunch(queue, kernel, 1, &offset, &count,
+                                         &local_size, 0, nullptr, nullptr));
+    ASSERT_SUCCESS(urQueueFinish(queue));
+    for (uint32_t i = 0; i < count; i++) {
+      ASSERT_EQ(array[i], i + 1) << i;
+    }
+    EXPECT_SUCCESS(urUSMFree(context, array));
+    EXPECT_SUCCESS(urKernelRelease(kernel));
+  }
+
+  static std::vector<uint8_t> pathBinary(const std::string &path) {
+    const std::string binary = "file://" + path;
+    // Including the terminating null.
+    return std::vector<uint8_t>(binary.c_str(),
+                                binary.c_str() + binary.size() + 1);
+  }
+
+  ur_program_handle_t program = nullptr;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuSharedObjectTest);
+
+TEST_P(urNativeCpuSharedObjectTest, FromPath) {
+  UUR_RETURN_ON_FATAL_FAILURE(
+      createProgram(pathBinary(NATIVECPU_TEST_KERNELS_PATH)));
+  UUR_RETURN_ON_FATAL_FAILURE(checkIncrement());
+
+  // The symbol tables are read when the program is created.
+  uint32_t global[4] = {};
+  ASSERT_SUCCESS(urEnqueueDeviceGlobalVariableRead(
+      queue, program, "Global", true, sizeof(global), 0, global, 0, nullptr,
+      nullptr));
+  EXPECT_EQ(global[0], 7);
+  EXPECT_EQ(global[3], 10);
+}
+
+TEST_P(urNativeCpuSharedObjectTest, FromImage) {
+  std::ifstream file(NATIVECPU_TEST_KERNELS_PATH, std::ios::binary);
+  std::vector<uint8_t> image((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+  ASSERT_FALSE(image.empty());
+  UUR_RETURN_ON_FATAL_FAILURE(createProgram(image));
+  // Kernels are resolved from the loaded copy of the image.
+  std::fill(image.begin(), image.end(), 0);
+  UUR_RETURN_ON_FATAL_FAILURE(checkIncrement());
+}
+
+TEST_P(urNativeCpuSharedObjectTest, LazyResolution) {
+  UUR_RETURN_ON_FATAL_FAILURE(
+      createProgram(pathBinary(NATIVECPU_TEST_KERNELS_PATH)));
+  ur_kernel_handle_t kernel = nullptr;
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_KERNEL,
+                   urKernelCreate(program, "not_a_kernel", &kernel));
+
+  // Threads creating the same kernel for the first time all resolve it.
+  constexpr size_t num_threads = 8;
+  std::vector<ur_kernel_handle_t> kernels(num_threads, nullptr);
+  std::vector<ur_result_t> results(num_threads);
+  std::atomic<bool> start{false};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; i++) {
+    threads.emplace_back([&, i]() {
+      while (!start.load()) {
+        std::this_thread::yield();
+      }
+      results[i] = urKernelCreate(program, "increment", &kernels[i]);
+    });
+  }
+  start = true;
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < num_threads; i++) {
+    ASSERT_SUCCESS(results[i]);
+    EXPECT_SUCCESS(urKernelRelease(kernels[i]));
+  }
+  UUR_RETURN_ON_FATAL_FAILURE(checkIncrement());
+}
+
+TEST_P(urNativeCpuSharedObjectTest, InvalidPath) {
+  const auto binary = pathBinary("/nonexistent/kernels.so");
+  const uint8_t *data = binary.data();
+  size_t size = binary.size();
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_BINARY,
+                   urProgramCreateWithBinary(context, 1, &device, &size, &data,
+                                             nullptr, &program));
+}
@@ -12,8 +12,6 @@ using urQueueFlushTest = uur::urQueueTest;
 UUR_INSTANTIATE_DEVICE_TEST_SUITE(urQueueFlushTest);
 
 TEST_P(urQueueFlushTest, Success) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   constexpr size_t buffer_size = 1024;
   uur::raii::Mem buffer = nullptr;
   ASSERT_SUCCESS(urMemBufferCreate(context, UR_MEM_FLAG_READ_WRITE, buffer_size,
@@ -10,10 +10,6 @@
 struct urUSMGetMemAllocInfoPoolTest
     : uur::urUSMDeviceAllocTestWithParam<ur_usm_alloc_info_t> {
   void SetUp() override {
-    // The setup for the parent fixture does a urQueueFlush, which isn't
-    // supported by native cpu.
-    UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
     use_pool = getParam() == UR_USM_ALLOC_INFO_POOL;
     UUR_RETURN_ON_FATAL_FAILURE(
         uur::urUSMDeviceAllocTestWithParam<ur_usm_alloc_info_t>::SetUp());
@@ -47,8 +43,6 @@ using urUSMGetMemAllocInfoTest = uur::urUSMDeviceAllocTest;
 UUR_INSTANTIATE_DEVICE_TEST_SUITE(urUSMGetMemAllocInfoTest);
 
 TEST_P(urUSMGetMemAllocInfoTest, SuccessType) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   size_t property_size = 0;
   const ur_usm_alloc_info_t property_name = UR_USM_ALLOC_INFO_TYPE;
 
@@ -66,8 +60,6 @@ TEST_P(urUSMGetMemAllocInfoTest, SuccessType) {
 }
 
 TEST_P(urUSMGetMemAllocInfoTest, SuccessBasePtr) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   size_t property_size = 0;
   const ur_usm_alloc_info_t property_name = UR_USM_ALLOC_INFO_BASE_PTR;
 
@@ -84,9 +76,18 @@ TEST_P(urUSMGetMemAllocInfoTest, SuccessBasePtr) {
   ASSERT_EQ(property_value, ptr);
 }
 
-TEST_P(urUSMGetMemAllocInfoTest, SuccessSize) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
+TEST_P(urUSMGetMemAllocInfoTest, SuccessBasePtrInterior) {
+  void *interior = static_cast<char *>(ptr) + allocation_size / 2;
+  void *property_value = nullptr;
+  ASSERT_SUCCESS_OR_OPTIONAL_QUERY(
+      urUSMGetMemAllocInfo(context, interior, UR_USM_ALLOC_INFO_BASE_PTR,
+                           sizeof(property_value), &property_value, nullptr),
+      UR_USM_ALLOC_INFO_BASE_PTR);
+
+  ASSERT_EQ(property_value, ptr);
+}
 
+TEST_P(urUSMGetMemAllocInfoTest, SuccessSize) {
   size_t property_size = 0;
   const ur_usm_alloc_info_t property_name = UR_USM_ALLOC_INFO_SIZE;
 
@@ -106,8 +107,6 @@ TEST_P(urUSMGetMemAllocInfoTest, SuccessSize) {
 }
 
 TEST_P(urUSMGetMemAllocInfoTest, SuccessDevice) {
-  UUR_KNOWN_FAILURE_ON(uur::NativeCPU{});
-
   size_t property_size = 0;
   const ur_usm_alloc_info_t property_name = UR_USM_ALLOC_INFO_DEVICE;
 
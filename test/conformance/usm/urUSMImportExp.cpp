@@ -0,0 +1,144 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <atomic>
+#include <thread>
+#include <uur/fixtures.h>
+#include <vector>
+
+// Imported host memory is tracked like the allocations of the context, which
+// must not overlap. These tests rely on the native_cpu adapter rejecting
+// overlapping imports with UR_RESULT_ERROR_INVALID_VALUE.
+struct urUSMImportExpTest : uur::urContextTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urContextTest::SetUp());
+
+    ur_platform_backend_t backend;
+    ASSERT_SUCCESS(urPlatformGetInfo(platform, UR_PLATFORM_INFO_BACKEND,
+                                     sizeof(backend), &backend, nullptr));
+    if (backend != UR_PLATFORM_BACKEND_NATIVE_CPU) {
+      GTEST_SKIP() << "Overlapping imports are only rejected by native_cpu.";
+    }
+  }
+
+  ur_usm_type_t getType(const void *ptr) {
+    ur_usm_type_t type = UR_USM_TYPE_FORCE_UINT32;
+    EXPECT_SUCCESS(urUSMGetMemAllocInfo(context, ptr, UR_USM_ALLOC_INFO_TYPE,
+                                        sizeof(type), &type, nullptr));
+    return type;
+  }
+
+  static constexpr size_t size = 1 << 16;
+  std::vector<uint8_t> memory = std::vector<uint8_t>(4 * size);
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urUSMImportExpTest);
+
+TEST_P(urUSMImportExpTest, ImportQueryRelease) {
+  uint8_t *ptr = memory.data() + size;
+  ASSERT_SUCCESS(urUSMImportExp(context, ptr, size));
+
+  // Any pointer into the imported range finds it.
+  uint8_t *interior = ptr + size / 2;
+  EXPECT_EQ(getType(interior), UR_USM_TYPE_HOST);
+  void *base = nullptr;
+  ASSERT_SUCCESS(urUSMGetMemAllocInfo(context, interior,
+                                      UR_USM_ALLOC_INFO_BASE_PTR, sizeof(base),
+                                      &base, nullptr));
+  EXPECT_EQ(base, ptr);
+  size_t alloc_size = 0;
+  ASSERT_SUCCESS(urUSMGetMemAllocInfo(context, interior,
+                                      UR_USM_ALLOC_INFO_SIZE,
+                                      sizeof(alloc_size), &alloc_size,
+                                      nullptr));
+  EXPECT_EQ(alloc_size, size);
+  EXPECT_EQ(getType(ptr - 1), UR_USM_TYPE_UNKNOWN);
+  EXPECT_EQ(getType(ptr + size), UR_USM_TYPE_UNKNOWN);
+
+  // Imported memory isn't the adapter's to free, and is released instead.
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_MEM_OBJECT,
+                   urUSMFree(context, ptr));
+  EXPECT_EQ(getType(interior), UR_USM_TYPE_HOST);
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_VALUE,
+                   urUSMReleaseExp(context, interior));
+  ASSERT_SUCCESS(urUSMReleaseExp(context, ptr));
+  EXPECT_EQ(getType(interior), UR_USM_TYPE_UNKNOWN);
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_VALUE,
+                   urUSMReleaseExp(context, ptr));
+}
+
+TEST_P(urUSMImportExpTest, OverlappingImports) {
+  uint8_t *ptr = memory.data() + size;
+  ASSERT_SUCCESS(urUSMImportExp(context, ptr, size));
+
+  // Ranges overlapping the start, the end or all of the import, and ranges
+  // within it.
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_VALUE,
+                   urUSMImportExp(context, ptr - 1, 2));
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_VALUE,
+                   urUSMImportExp(context, ptr + size - 1, 2));
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_VALUE,
+                   urUSMImportExp(context, memory.data(), memory.size()));
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_VALUE,
+                   urUSMImportExp(context, ptr + 1, size - 2));
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_VALUE,
+                   urUSMImportExp(context, ptr, size));
+
+  // Adjacent ranges don't overlap.
+  ASSERT_SUCCESS(urUSMImportExp(context, memory.data(), size));
+  ASSERT_SUCCESS(urUSMImportExp(context, ptr + size, size));
+
+  ASSERT_SUCCESS(urUSMReleaseExp(context, ptr + size));
+  ASSERT_SUCCESS(urUSMReleaseExp(context, memory.data()));
+  ASSERT_SUCCESS(urUSMReleaseExp(context, ptr));
+}
+
+TEST_P(urUSMImportExpTest, RangeContainingAllocation) {
+  void *allocation = nullptr;
+  ASSERT_SUCCESS(urUSMHostAlloc(context, nullptr, nullptr, 64, &allocation));
+
+  // The allocation lies within the range, but neither end of the range is
+  // in the allocation.
+  auto *begin = static_cast<uint8_t *>(allocation) - 64;
+  EXPECT_EQ_RESULT(UR_RESULT_ERROR_INVALID_VALUE,
+                   urUSMImportExp(context, begin, 256));
+
+  ASSERT_SUCCESS(urUSMFree(context, allocation));
+}
+
+TEST_P(urUSMImportExpTest, ConcurrentOverlappingImports) {
+  // Each thread imports a range overlapping those of its neighbours, so no
+  // two neighbours may both succeed.
+  constexpr size_t num_threads = 8;
+  constexpr size_t stride = 4 * size / (num_threads + 1);
+  std::vector<ur_result_t> results(num_threads);
+  std::atomic<bool> start{false};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; i++) {
+    threads.emplace_back([&, i]() {
+      while (!start.load()) {
+        std::this_thread::yield();
+      }
+      results[i] =
+          urUSMImportExp(context, memory.data() + i * stride, 2 * stride);
+    });
+  }
+  start = true;
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < num_threads; i++) {
+    if (results[i] != UR_RESULT_SUCCESS) {
+      EXPECT_EQ(results[i], UR_RESULT_ERROR_INVALID_VALUE);
+      continue;
+    }
+    if (i > 0) {
+      EXPECT_NE(results[i - 1], UR_RESULT_SUCCESS) << i;
+    }
+    ASSERT_SUCCESS(urUSMReleaseExp(context, memory.data() + i * stride));
+  }
+}
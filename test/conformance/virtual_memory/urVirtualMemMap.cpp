@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 #include <uur/fixtures.h>
+#include <vector>
 
 using urVirtualMemMapWithFlagsTest =
     uur::urVirtualMemTestWithParam<ur_virtual_mem_access_flag_t>;
@@ -46,3 +47,99 @@ TEST_P(urVirtualMemMapTest, InvalidEnumerationFlags) {
                                    UR_VIRTUAL_MEM_ACCESS_FLAG_FORCE_UINT32),
                    UR_RESULT_ERROR_INVALID_ENUMERATION);
 }
+
+// Maps physical memory into a reservation twice the size of the fixture's,
+// and reads and writes it through a queue.
+struct urVirtualMemMapRoundTripTest : uur::urPhysicalMemTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urPhysicalMemTest::SetUp());
+    ASSERT_SUCCESS(urQueueCreate(context, device, nullptr, &queue));
+    ASSERT_SUCCESS(
+        urVirtualMemReserve(context, nullptr, 2 * size, &virtual_ptr));
+    second_half = static_cast<uint8_t *>(virtual_ptr) + size;
+  }
+
+  void TearDown() override {
+    if (virtual_ptr) {
+      EXPECT_SUCCESS(urVirtualMemFree(context, virtual_ptr, 2 * size));
+    }
+    if (queue) {
+      EXPECT_SUCCESS(urQueueRelease(queue));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urPhysicalMemTest::TearDown());
+  }
+
+  void fill(void *ptr, size_t fill_size, uint32_t pattern) {
+    ASSERT_SUCCESS(urEnqueueUSMFill(queue, ptr, sizeof(pattern), &pattern,
+                                    fill_size, 0, nullptr, nullptr));
+    ASSERT_SUCCESS(urQueueFinish(queue));
+  }
+
+  std::vector<uint32_t> read(const void *ptr, size_t read_size) {
+    std::vector<uint32_t> data(read_size / sizeof(uint32_t));
+    EXPECT_SUCCESS(urEnqueueUSMMemcpy(queue, true, data.data(), ptr,
+                                      read_size, 0, nullptr, nullptr));
+    return data;
+  }
+
+  ur_queue_handle_t queue = nullptr;
+  void *virtual_ptr = nullptr;
+  void *second_half = nullptr;
+};
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urVirtualMemMapRoundTripTest);
+
+TEST_P(urVirtualMemMapRoundTripTest, GrowInPlace) {
+  ASSERT_SUCCESS(urVirtualMemMap(context, virtual_ptr, size, physical_mem, 0,
+                                 UR_VIRTUAL_MEM_ACCESS_FLAG_READ_WRITE));
+  UUR_RETURN_ON_FATAL_FAILURE(fill(virtual_ptr, size, 1));
+
+  // Mapping more memory right after the first keeps its contents where they
+  // were, and the two read back as one range.
+  ur_physical_mem_handle_t grown_mem = nullptr;
+  ASSERT_SUCCESS(
+      urPhysicalMemCreate(context, device, size, nullptr, &grown_mem));
+  ASSERT_SUCCESS(urVirtualMemMap(context, second_half, size, grown_mem, 0,
+                                 UR_VIRTUAL_MEM_ACCESS_FLAG_READ_WRITE));
+  UUR_RETURN_ON_FATAL_FAILURE(fill(second_half, size, 2));
+  const auto data = read(virtual_ptr, 2 * size);
+  const size_t count = size / sizeof(uint32_t);
+  for (size_t i = 0; i < data.size(); i++) {
+    ASSERT_EQ(data[i], i < count ? 1u : 2u) << i;
+  }
+
+  // The access of both can be set at once.
+  ASSERT_SUCCESS(urVirtualMemSetAccess(context, virtual_ptr, 2 * size,
+                                       UR_VIRTUAL_MEM_ACCESS_FLAG_READ_ONLY));
+  ur_virtual_mem_access_flags_t flags = 0;
+  ASSERT_SUCCESS(urVirtualMemGetInfo(context, second_half, size,
+                                     UR_VIRTUAL_MEM_INFO_ACCESS_MODE,
+                                     sizeof(flags), &flags, nullptr));
+  EXPECT_TRUE(flags & UR_VIRTUAL_MEM_ACCESS_FLAG_READ_ONLY);
+
+  ASSERT_SUCCESS(urVirtualMemUnmap(context, virtual_ptr, 2 * size));
+  ASSERT_SUCCESS(urPhysicalMemRelease(grown_mem));
+}
+
+TEST_P(urVirtualMemMapRoundTripTest, Alias) {
+  ASSERT_SUCCESS(urVirtualMemMap(context, virtual_ptr, size, physical_mem, 0,
+                                 UR_VIRTUAL_MEM_ACCESS_FLAG_READ_WRITE));
+  ASSERT_SUCCESS(urVirtualMemMap(context, second_half, size, physical_mem, 0,
+                                 UR_VIRTUAL_MEM_ACCESS_FLAG_READ_WRITE));
+
+  // Writes through either range are seen through the other.
+  UUR_RETURN_ON_FATAL_FAILURE(fill(virtual_ptr, size, 3));
+  for (uint32_t value : read(second_half, size)) {
+    ASSERT_EQ(value, 3u);
+  }
+  UUR_RETURN_ON_FATAL_FAILURE(fill(second_half, size, 4));
+  for (uint32_t value : read(virtual_ptr, size)) {
+    ASSERT_EQ(value, 4u);
+  }
+
+  // Unmapping one of the ranges leaves the other mapped.
+  ASSERT_SUCCESS(urVirtualMemUnmap(context, second_half, size));
+  for (uint32_t value : read(virtual_ptr, size)) {
+    ASSERT_EQ(value, 4u);
+  }
+  ASSERT_SUCCESS(urVirtualMemUnmap(context, virtual_ptr, size));
+}
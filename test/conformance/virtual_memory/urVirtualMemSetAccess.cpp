@@ -49,3 +49,39 @@ TEST_P(urVirtualMemSetAccessTest, InvalidEnumeration) {
                             UR_VIRTUAL_MEM_ACCESS_FLAG_FORCE_UINT32),
       UR_RESULT_ERROR_INVALID_ENUMERATION);
 }
+
+using urVirtualMemSetAccessUnmappedTest = uur::urVirtualMemTest;
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urVirtualMemSetAccessUnmappedTest);
+
+TEST_P(urVirtualMemSetAccessUnmappedTest, InvalidUnmappedRange) {
+  UUR_KNOWN_FAILURE_ON(uur::LevelZero{}, uur::LevelZeroV2{});
+
+  ASSERT_EQ_RESULT(urVirtualMemSetAccess(context, virtual_ptr, size,
+                                         UR_VIRTUAL_MEM_ACCESS_FLAG_READ_WRITE),
+                   UR_RESULT_ERROR_INVALID_VALUE);
+
+  ur_virtual_mem_access_flags_t flags = 0;
+  ASSERT_SUCCESS(urVirtualMemGetInfo(context, virtual_ptr, size,
+                                     UR_VIRTUAL_MEM_INFO_ACCESS_MODE,
+                                     sizeof(flags), &flags, nullptr));
+  ASSERT_FALSE(flags & UR_VIRTUAL_MEM_ACCESS_FLAG_READ_WRITE);
+}
+
+TEST_P(urVirtualMemSetAccessUnmappedTest, InvalidPartiallyMappedRange) {
+  UUR_KNOWN_FAILURE_ON(uur::LevelZero{}, uur::LevelZeroV2{});
+
+  const size_t mapped_size = size / 2;
+  ASSERT_SUCCESS(urVirtualMemMap(context, virtual_ptr, mapped_size,
+                                 physical_mem, 0,
+                                 UR_VIRTUAL_MEM_ACCESS_FLAG_READ_ONLY));
+  EXPECT_EQ_RESULT(urVirtualMemSetAccess(context, virtual_ptr, size,
+                                         UR_VIRTUAL_MEM_ACCESS_FLAG_READ_WRITE),
+                   UR_RESULT_ERROR_INVALID_VALUE);
+
+  ur_virtual_mem_access_flags_t flags = 0;
+  EXPECT_SUCCESS(urVirtualMemGetInfo(context, virtual_ptr, mapped_size,
+                                     UR_VIRTUAL_MEM_INFO_ACCESS_MODE,
+                                     sizeof(flags), &flags, nullptr));
+  EXPECT_TRUE(flags & UR_VIRTUAL_MEM_ACCESS_FLAG_READ_ONLY);
+  ASSERT_SUCCESS(urVirtualMemUnmap(context, virtual_ptr, mapped_size));
+}